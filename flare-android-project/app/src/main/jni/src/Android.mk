@@ -23,6 +23,7 @@ LOCAL_SRC_FILES := $(SDL_PATH)/src/main/android/SDL_android_main.c \
 	../../../../../../src/Avatar.cpp \
 	../../../../../../src/Camera.cpp \
 	../../../../../../src/CampaignManager.cpp \
+	../../../../../../src/CombatSimulation.cpp \
 	../../../../../../src/CombatText.cpp \
 	../../../../../../src/CursorManager.cpp \
 	../../../../../../src/DeviceList.cpp \
@@ -30,8 +31,11 @@ LOCAL_SRC_FILES := $(SDL_PATH)/src/main/android/SDL_android_main.c \
 	../../../../../../src/EnemyGroupManager.cpp \
 	../../../../../../src/Entity.cpp \
 	../../../../../../src/EntityBehavior.cpp \
+	../../../../../../src/EntityGrid.cpp \
 	../../../../../../src/EntityManager.cpp \
 	../../../../../../src/EngineSettings.cpp \
+	../../../../../../src/EntityPool.cpp \
+	../../../../../../src/EventIndex.cpp \
 	../../../../../../src/EventManager.cpp \
 	../../../../../../src/FileParser.cpp \
 	../../../../../../src/FogOfWar.cpp \
@@ -48,11 +52,13 @@ LOCAL_SRC_FILES := $(SDL_PATH)/src/main/android/SDL_android_main.c \
 	../../../../../../src/GetText.cpp \
 	../../../../../../src/Hazard.cpp \
 	../../../../../../src/HazardManager.cpp \
+	../../../../../../src/HazardPool.cpp \
 	../../../../../../src/IconManager.cpp \
 	../../../../../../src/InputState.cpp \
 	../../../../../../src/ItemManager.cpp \
 	../../../../../../src/ItemStorage.cpp \
 	../../../../../../src/Loot.cpp \
+	../../../../../../src/LootGrid.cpp \
 	../../../../../../src/LootManager.cpp \
 	../../../../../../src/Map.cpp \
 	../../../../../../src/MapParallax.cpp \
@@ -87,9 +93,11 @@ LOCAL_SRC_FILES := $(SDL_PATH)/src/main/android/SDL_android_main.c \
 	../../../../../../src/ModManager.cpp \
 	../../../../../../src/NPC.cpp \
 	../../../../../../src/NPCManager.cpp \
+	../../../../../../src/PathService.cpp \
 	../../../../../../src/PowerManager.cpp \
 	../../../../../../src/QuestLog.cpp \
 	../../../../../../src/RenderDevice.cpp \
+	../../../../../../src/RenderLayerCache.cpp \
 	../../../../../../src/SaveLoad.cpp \
 	../../../../../../src/SDLInputState.cpp \
 	../../../../../../src/SDLHardwareRenderDevice.cpp \
@@ -103,7 +111,10 @@ LOCAL_SRC_FILES := $(SDL_PATH)/src/main/android/SDL_android_main.c \
 	../../../../../../src/StatBlock.cpp \
 	../../../../../../src/Stats.cpp \
 	../../../../../../src/Subtitles.cpp \
+	../../../../../../src/SymbolTable.cpp \
+	../../../../../../src/ThreadPool.cpp \
 	../../../../../../src/TileSet.cpp \
+	../../../../../../src/TimerWheel.cpp \
 	../../../../../../src/TooltipData.cpp \
 	../../../../../../src/TooltipManager.cpp \
 	../../../../../../src/Utils.cpp \
@@ -111,6 +122,7 @@ LOCAL_SRC_FILES := $(SDL_PATH)/src/main/android/SDL_android_main.c \
 	../../../../../../src/UtilsFileSystem.cpp \
 	../../../../../../src/UtilsParsing.cpp \
 	../../../../../../src/Version.cpp \
+	../../../../../../src/WeightedSampler.cpp \
 	../../../../../../src/Widget.cpp \
 	../../../../../../src/WidgetCheckBox.cpp \
 	../../../../../../src/WidgetButton.cpp \
@@ -18,11 +18,18 @@ You should have received a copy of the GNU General Public License along with
 FLARE.  If not, see http://www.gnu.org/licenses/
 */
 
+/**
+ * class AnimationDef
+ *
+ * The frame data of a single animation. It is loaded once by AnimationSet and then
+ * shared (read-only) by every Animation that plays it.
+ */
+
 /**
  * class Animation
  *
  * The Animation class handles the logic of advancing frames based on the animation type
- * and returning a renderable frame.
+ * and returning a renderable frame. It only holds the playback state; the frames are in AnimationDef.
  *
  * The intention with the class is to keep it as flexible as possible so that the animations
  * can be used not only for character animations but any animated in-game objects.
@@ -30,9 +37,11 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 
 #include "Animation.h"
 #include "RenderDevice.h"
+#include "SharedResources.h"
 
-Animation::Animation(const std::string &_name, const std::string &_type, AnimationMedia *_sprite, uint8_t _blend_mode, uint8_t _alpha_mod, Color _color_mod)
+AnimationDef::AnimationDef(const std::string &_name, const std::string &_type, AnimationMedia *_sprite, uint8_t _blend_mode, uint8_t _alpha_mod, Color _color_mod)
 	: name(_name)
+	, id(symbols->intern(_name))
 	, type(	_type == "play_once" ? ANIMTYPE_PLAY_ONCE :
 			_type == "back_forth" ? ANIMTYPE_BACK_FORTH :
 			_type == "looped" ? ANIMTYPE_LOOPED :
@@ -42,26 +51,17 @@ Animation::Animation(const std::string &_name, const std::string &_type, Animati
 	, alpha_mod(_alpha_mod)
 	, color_mod(_color_mod)
 	, number_frames(0)
-	, cur_frame(0)
-	, cur_frame_index(0)
-	, cur_frame_duration(0)
-	, cur_frame_index_f(0)
 	, max_kinds(0)
-	, additional_data(0)
-	, times_played(0)
 	, gfx()
 	, render_offset()
 	, frames()
 	, active_frames()
-	, active_frame_triggered(false)
-	, elapsed_frames(0)
-	, frame_count(0)
-	, speed(1.0f) {
+	, frame_count(0) {
 	if (type == ANIMTYPE_NONE)
 		Utils::logError("Animation: Type %s is unknown", _type.c_str());
 }
 
-void Animation::setupUncompressed(const Point& _render_size, const Point& _render_offset, unsigned short _position, unsigned short _frames, unsigned short _duration, unsigned short _maxkinds) {
+void AnimationDef::setupUncompressed(const Point& _render_size, const Point& _render_offset, unsigned short _position, unsigned short _frames, unsigned short _duration, unsigned short _maxkinds) {
 	setup(_frames, _duration, _maxkinds);
 
 	for (unsigned short i = 0 ; i < _frames; i++) {
@@ -79,7 +79,7 @@ void Animation::setupUncompressed(const Point& _render_size, const Point& _rende
 	}
 }
 
-void Animation::setup(unsigned short _frames, unsigned short _duration, unsigned short _maxkinds) {
+void AnimationDef::setup(unsigned short _frames, unsigned short _duration, unsigned short _maxkinds) {
 	frame_count = _frames;
 
 	frames.clear();
@@ -127,21 +127,10 @@ void Animation::setup(unsigned short _frames, unsigned short _duration, unsigned
 
 	if (!frames.empty()) number_frames = static_cast<unsigned short>(frames.back()+1);
 
-	if (type == ANIMTYPE_PLAY_ONCE) {
-		additional_data = 0;
-	}
-	else if (type == ANIMTYPE_LOOPED) {
-		additional_data = 0;
-	}
-	else if (type == ANIMTYPE_BACK_FORTH) {
+	if (type == ANIMTYPE_BACK_FORTH) {
 		number_frames = static_cast<unsigned short>(2 * number_frames);
-		additional_data = 1;
 	}
-	cur_frame = 0;
-	cur_frame_index = 0;
-	cur_frame_index_f = 0;
 	max_kinds = _maxkinds;
-	times_played = 0;
 
 	active_frames.push_back(static_cast<unsigned short>(number_frames-1)/2);
 
@@ -150,7 +139,7 @@ void Animation::setup(unsigned short _frames, unsigned short _duration, unsigned
 	render_offset.resize(i);
 }
 
-bool Animation::addFrame(unsigned short index, unsigned short kind, const Rect& rect, const Point& _render_offset, const std::string& key) {
+bool AnimationDef::addFrame(unsigned short index, unsigned short kind, const Rect& rect, const Point& _render_offset, const std::string& key) {
 	if (index >= gfx.size()/max_kinds || kind > max_kinds-1) {
 		return false;
 	}
@@ -163,17 +152,49 @@ bool Animation::addFrame(unsigned short index, unsigned short kind, const Rect&
 	return true;
 }
 
+Animation::Animation(const AnimationDef *_def)
+	: def(_def)
+	, cur_frame(0)
+	, cur_frame_index(0)
+	, cur_frame_duration(0)
+	, cur_frame_index_f(0)
+	, additional_data(0)
+	, times_played(0)
+	, active_frame_triggered(false)
+	, elapsed_frames(0)
+	, speed(1.0f) {
+	setDef(_def);
+}
+
+/**
+ * Play a different animation from its start. This only resets the playback state,
+ * so entities can change animations without allocating anything.
+ */
+void Animation::setDef(const AnimationDef *_def) {
+	def = _def;
+
+	cur_frame = 0;
+	cur_frame_index = 0;
+	cur_frame_duration = 0;
+	cur_frame_index_f = 0;
+	additional_data = (def->type == AnimationDef::ANIMTYPE_BACK_FORTH) ? 1 : 0;
+	times_played = 0;
+	active_frame_triggered = false;
+	elapsed_frames = 0;
+	speed = 1.0f;
+}
+
 void Animation::advanceFrame() {
-	if (frames.empty()) {
+	if (def->frames.empty()) {
 		cur_frame_index = 0;
 		cur_frame_index_f = 0;
 		times_played++;
 		return;
 	}
 
-	unsigned short last_base_index = static_cast<unsigned short>(frames.size()-1);
-	switch(type) {
-		case ANIMTYPE_PLAY_ONCE:
+	unsigned short last_base_index = static_cast<unsigned short>(def->frames.size()-1);
+	switch(def->type) {
+		case AnimationDef::ANIMTYPE_PLAY_ONCE:
 
 			if (cur_frame_index < last_base_index) {
 				cur_frame_index_f += speed;
@@ -183,7 +204,7 @@ void Animation::advanceFrame() {
 				times_played = 1;
 			break;
 
-		case ANIMTYPE_LOOPED:
+		case AnimationDef::ANIMTYPE_LOOPED:
 			if (cur_frame_index < last_base_index) {
 				cur_frame_index_f += speed;
 				cur_frame_index = static_cast<unsigned short>(cur_frame_index_f);
@@ -195,7 +216,7 @@ void Animation::advanceFrame() {
 			}
 			break;
 
-		case ANIMTYPE_BACK_FORTH:
+		case AnimationDef::ANIMTYPE_BACK_FORTH:
 
 			if (additional_data == 1) {
 				if (cur_frame_index < last_base_index) {
@@ -217,34 +238,40 @@ void Animation::advanceFrame() {
 			}
 			break;
 
-		case ANIMTYPE_NONE:
+		case AnimationDef::ANIMTYPE_NONE:
 			break;
 	}
 	cur_frame_index = std::max<short>(0, cur_frame_index);
 	cur_frame_index = (cur_frame_index > last_base_index ? last_base_index : cur_frame_index);
 
-	if (cur_frame != frames[cur_frame_index]) elapsed_frames++;
-	cur_frame = frames[cur_frame_index];
+	if (cur_frame != def->frames[cur_frame_index]) elapsed_frames++;
+	cur_frame = def->frames[cur_frame_index];
 }
 
 Renderable Animation::getCurrentFrame(int kind) {
 	Renderable r;
-	if (!frames.empty()) {
-		const int index = (max_kinds*frames[cur_frame_index]) + kind;
-		r.src.x = gfx[index].second.x;
-		r.src.y = gfx[index].second.y;
-		r.src.w = gfx[index].second.w;
-		r.src.h = gfx[index].second.h;
-		r.offset.x = render_offset[index].x;
-		r.offset.y = render_offset[index].y;
-		r.image = gfx[index].first;
-		r.blend_mode = blend_mode;
-		r.color_mod = color_mod;
-		r.alpha_mod = alpha_mod;
+	if (!def->frames.empty()) {
+		const int index = (def->max_kinds*def->frames[cur_frame_index]) + kind;
+		r.src.x = def->gfx[index].second.x;
+		r.src.y = def->gfx[index].second.y;
+		r.src.w = def->gfx[index].second.w;
+		r.src.h = def->gfx[index].second.h;
+		r.offset.x = def->render_offset[index].x;
+		r.offset.y = def->render_offset[index].y;
+		r.image = def->gfx[index].first;
+		r.blend_mode = def->blend_mode;
+		r.color_mod = def->color_mod;
+		r.alpha_mod = def->alpha_mod;
 	}
 	return r;
 }
 
+unsigned short Animation::getCurrentFrameIndex() {
+	if (def->frames.empty())
+		return 0;
+	return def->frames[cur_frame_index];
+}
+
 void Animation::reset() {
 	cur_frame = 0;
 	cur_frame_index = 0;
@@ -263,16 +290,16 @@ bool Animation::syncTo(const Animation *other) {
 	additional_data = other->additional_data;
 	elapsed_frames = other->elapsed_frames;
 
-	if (cur_frame_index >= frames.size()) {
-		if (frames.empty()) {
-			Utils::logError("Animation: '%s' animation has no frames, but current frame index is greater than 0.", name.c_str());
+	if (cur_frame_index >= def->frames.size()) {
+		if (def->frames.empty()) {
+			Utils::logError("Animation: '%s' animation has no frames, but current frame index is greater than 0.", def->name.c_str());
 			cur_frame_index = 0;
 			cur_frame_index_f = 0;
 			return false;
 		}
 		else {
-			Utils::logError("Animation: Current frame index (%d) was larger than the last frame index (%d) when syncing '%s' animation.", cur_frame_index, frames.size()-1, name.c_str());
-			cur_frame_index = static_cast<unsigned short>(frames.size()-1);
+			Utils::logError("Animation: Current frame index (%d) was larger than the last frame index (%d) when syncing '%s' animation.", cur_frame_index, def->frames.size()-1, def->name.c_str());
+			cur_frame_index = static_cast<unsigned short>(def->frames.size()-1);
 			cur_frame_index_f = cur_frame_index;
 			return false;
 		}
@@ -281,7 +308,7 @@ bool Animation::syncTo(const Animation *other) {
 	return true;
 }
 
-void Animation::setActiveFrames(const std::vector<short> &_active_frames) {
+void AnimationDef::setActiveFrames(const std::vector<short> &_active_frames) {
 	if (_active_frames.size() == 1 && _active_frames[0] == -1) {
 		active_frames.clear();
 		for (unsigned short i = 0; i < number_frames; ++i)
@@ -312,64 +339,64 @@ bool Animation::isFirstFrame() {
 }
 
 bool Animation::isLastFrame() {
-	return cur_frame_index == static_cast<short>(getLastFrameIndex(static_cast<short>(number_frames-1)));
+	return cur_frame_index == static_cast<short>(getLastFrameIndex(static_cast<short>(def->number_frames-1)));
 }
 
 bool Animation::isSecondLastFrame() {
-	return cur_frame_index == static_cast<short>(getLastFrameIndex(static_cast<short>(number_frames-2)));
+	return cur_frame_index == static_cast<short>(getLastFrameIndex(static_cast<short>(def->number_frames-2)));
 }
 
 bool Animation::isActiveFrame() {
-	if (type == ANIMTYPE_BACK_FORTH) {
-		if (std::find(active_frames.begin(), active_frames.end(), elapsed_frames) != active_frames.end())
+	if (def->type == AnimationDef::ANIMTYPE_BACK_FORTH) {
+		if (std::find(def->active_frames.begin(), def->active_frames.end(), elapsed_frames) != def->active_frames.end())
 			return cur_frame_index == getLastFrameIndex(cur_frame) && static_cast<float>(cur_frame_index) == cur_frame_index_f;
 	}
 	else {
-		if (std::find(active_frames.begin(), active_frames.end(), cur_frame) != active_frames.end()) {
+		if (std::find(def->active_frames.begin(), def->active_frames.end(), cur_frame) != def->active_frames.end()) {
 			if (cur_frame_index == getLastFrameIndex(cur_frame) && static_cast<float>(cur_frame_index) == cur_frame_index_f) {
-				if (type == ANIMTYPE_PLAY_ONCE)
+				if (def->type == AnimationDef::ANIMTYPE_PLAY_ONCE)
 					active_frame_triggered = true;
 
 				return true;
 			}
 		}
 	}
-	return (isLastFrame() && type == ANIMTYPE_PLAY_ONCE && !active_frame_triggered && !active_frames.empty());
+	return (isLastFrame() && def->type == AnimationDef::ANIMTYPE_PLAY_ONCE && !active_frame_triggered && !def->active_frames.empty());
 }
 
 int Animation::getTimesPlayed() {
 	return times_played;
 }
 
-std::string Animation::getName() {
-	return name;
+const std::string& Animation::getName() const {
+	return def->name;
 }
 
 int Animation::getDuration() {
-	return static_cast<int>(static_cast<float>(frames.size()) / speed);
+	return static_cast<int>(static_cast<float>(def->frames.size()) / speed);
 }
 
 bool Animation::isCompleted() {
-	return (type == ANIMTYPE_PLAY_ONCE && times_played > 0);
+	return (def->type == AnimationDef::ANIMTYPE_PLAY_ONCE && times_played > 0);
 }
 
 unsigned short Animation::getLastFrameIndex(const short &frame) {
-	if (frames.empty() || frame < 0) return 0;
+	if (def->frames.empty() || frame < 0) return 0;
 
-	if (type == ANIMTYPE_BACK_FORTH && additional_data == -1) {
+	if (def->type == AnimationDef::ANIMTYPE_BACK_FORTH && additional_data == -1) {
 		// since the animation is advancing backwards here, the first frame index is actually the last
-		for (unsigned short i=0; i<frames.size(); i++) {
-			if (frames[i] == frame) return i;
+		for (unsigned short i=0; i<def->frames.size(); i++) {
+			if (def->frames[i] == frame) return i;
 		}
 		return 0;
 	}
 	else {
 		// normal animation
-		for (size_t i=frames.size(); i>0; i--) {
-			if (frames[i-1] == frame)
+		for (size_t i=def->frames.size(); i>0; i--) {
+			if (def->frames[i-1] == frame)
 				return static_cast<unsigned short>(i-1);
 		}
-		return static_cast<unsigned short>(frames.size()-1);
+		return static_cast<unsigned short>(def->frames.size()-1);
 	}
 }
 
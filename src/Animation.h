@@ -18,11 +18,18 @@ You should have received a copy of the GNU General Public License along with
 FLARE.  If not, see http://www.gnu.org/licenses/
 */
 
+/**
+ * class AnimationDef
+ *
+ * The frame data of a single animation. It is loaded once by AnimationSet and then
+ * shared (read-only) by every Animation that plays it.
+ */
+
 /**
  * class Animation
  *
  * The Animation class handles the logic of advancing frames based on the animation type
- * and returning a renderable frame.
+ * and returning a renderable frame. It only holds the playback state; the frames are in AnimationDef.
  *
  * The intention with the class is to keep it as flexible as possible so that the animations
  * can be used not only for character animations but any animated in-game objects.
@@ -34,12 +41,14 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "CommonIncludes.h"
 #include "Utils.h"
 #include "AnimationMedia.h"
+#include "SymbolTable.h"
 
-class Animation {
-protected:
-	unsigned short getLastFrameIndex(const short &frame); // given a frame, gets the last index of frames that matches
+class AnimationDef {
+private:
+	friend class Animation;
 
 	const std::string name;
+	const SymbolID id; // the interned name
 	const int type;
 	AnimationMedia *sprite;
 	uint8_t blend_mode;
@@ -47,21 +56,9 @@ protected:
 	Color color_mod;
 
 	unsigned short number_frames; // how many ticks this animation lasts.
-	unsigned short cur_frame;     // counts up until reaching number_frames.
-
-	unsigned short cur_frame_index; // which frame in this animation is currently being displayed? range: 0..gfx.size()-1
-	unsigned short cur_frame_duration;  // how many ticks is the current image being displayed yet? range: 0..duration[cur_frame]-1
-	float cur_frame_index_f; // more granular control over cur_frame_index
 
 	unsigned short max_kinds;
 
-	short additional_data;  // additional state depending on type:
-	// if type == BACK_FORTH then it is 1 for advancing, and -1 for going back, 0 at the end
-	// if type == LOOPED, then it is the number of loops to be played.
-	// if type == PLAY_ONCE or NONE, this has no meaning.
-
-	short times_played; // how often this animation was played (loop counter for type LOOPED)
-
 	// Frame data, all vectors must have the same length:
 	// These are indexed as 8*cur_frame_index + direction.
 	std::vector<std::pair<Image*, Rect> > gfx; // position on the spritesheet to be used.
@@ -71,14 +68,10 @@ protected:
 	std::vector<short> active_frames;	// which of the visible diffferent frames are active?
 	// This should contain indexes of the gfx vector.
 	// Assume it is sorted, one index occurs at max once.
-	bool active_frame_triggered;
-
-	unsigned short elapsed_frames; // counts the total number of frames for back-forth animations
 
 	unsigned frame_count; // the frame count as it appears in the data files (i.e. not converted to engine frames)
 
-	float speed; // how fast the animation plays
-
+public:
 	enum {
 		ANIMTYPE_NONE       = 0,
 		ANIMTYPE_PLAY_ONCE  = 1, // just iterates over the images one time. it holds the final image when finished.
@@ -86,8 +79,7 @@ protected:
 		ANIMTYPE_BACK_FORTH = 3  // iterate from index=0 to maxframe and back again. keeps holding the first image afterwards.
 	};
 
-public:
-	Animation(const std::string &_name, const std::string &_type, AnimationMedia *_sprite, uint8_t _blend_mode, uint8_t _alpha_mod, Color _color_mod);
+	AnimationDef(const std::string &_name, const std::string &_type, AnimationMedia *_sprite, uint8_t _blend_mode, uint8_t _alpha_mod, Color _color_mod);
 
 	// Traditional way to create an animation.
 	// The frames are stored in a grid like fashion, so the individual frame
@@ -104,6 +96,46 @@ public:
 	// kind can be used for direction(enemies, hero) or randomness(powers)
 	bool addFrame(unsigned short index, unsigned short kind, const Rect& rect, const Point& _render_offset, const std::string &key);
 
+	// a vector of indexes of gfx passed into.
+	// if { -1 } is passed, all frames are set to active.
+	void setActiveFrames(const std::vector<short> &_active_frames);
+
+	const std::string& getName() const { return name; }
+	SymbolID getID() const { return id; }
+	unsigned getFrameCount() const { return frame_count; }
+};
+
+class Animation {
+protected:
+	unsigned short getLastFrameIndex(const short &frame); // given a frame, gets the last index of frames that matches
+
+	const AnimationDef *def;
+
+	unsigned short cur_frame;     // counts up until reaching number_frames.
+
+	unsigned short cur_frame_index; // which frame in this animation is currently being displayed? range: 0..gfx.size()-1
+	unsigned short cur_frame_duration;  // how many ticks is the current image being displayed yet? range: 0..duration[cur_frame]-1
+	float cur_frame_index_f; // more granular control over cur_frame_index
+
+	short additional_data;  // additional state depending on type:
+	// if type == BACK_FORTH then it is 1 for advancing, and -1 for going back, 0 at the end
+	// if type == LOOPED, then it is the number of loops to be played.
+	// if type == PLAY_ONCE or NONE, this has no meaning.
+
+	short times_played; // how often this animation was played (loop counter for type LOOPED)
+
+	bool active_frame_triggered;
+
+	unsigned short elapsed_frames; // counts the total number of frames for back-forth animations
+
+	float speed; // how fast the animation plays
+
+public:
+	explicit Animation(const AnimationDef *_def);
+
+	// switch to playing a different animation from the start
+	void setDef(const AnimationDef *_def);
+
 	// advance the animation one frame
 	void advanceFrame();
 
@@ -115,6 +147,9 @@ public:
 	// return the Renderable of the current frame
 	Renderable getCurrentFrame(int direction);
 
+	// the index of the image that getCurrentFrame() uses
+	unsigned short getCurrentFrameIndex();
+
 	bool isFirstFrame();
 	bool isLastFrame();
 	bool isSecondLastFrame();
@@ -128,16 +163,13 @@ public:
 	// resets to beginning of the animation
 	void reset();
 
-	std::string getName();
+	const std::string& getName() const;
+	SymbolID getID() const { return def->id; }
 	int getDuration();
 
-	// a vector of indexes of gfx passed into.
-	// if { -1 } is passed, all frames are set to active.
-	void setActiveFrames(const std::vector<short> &_active_frames);
-
 	bool isCompleted();
 
-	unsigned getFrameCount() { return frame_count; }
+	unsigned getFrameCount() { return def->frame_count; }
 
 	void setSpeed(float val);
 };
@@ -25,14 +25,26 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 
 #include <cassert>
 
+/**
+ * Interns the filename and makes sure the per-file arrays can be indexed with it
+ */
+SymbolID AnimationManager::getFilenameID(const std::string &name) {
+	SymbolID id = symbols->intern(name);
+	if (id >= sets.size()) {
+		sets.resize(id+1, NULL);
+		counts.resize(id+1, 0);
+		registered.resize(id+1, false);
+	}
+	return id;
+}
+
 AnimationSet *AnimationManager::getAnimationSet(const std::string& filename) {
-	std::vector<std::string>::iterator found = find(names.begin(), names.end(), filename);
-	if (found != names.end()) {
-		size_t index = static_cast<size_t>(distance(names.begin(), found));
-		if (sets[index] == 0) {
-			sets[index] = new AnimationSet(filename);
+	SymbolID id = getFilenameID(filename);
+	if (registered[id]) {
+		if (sets[id] == 0) {
+			sets[id] = new AnimationSet(filename);
 		}
-		return sets[index];
+		return sets[id];
 	}
 	else {
 		Utils::logError("AnimationManager::getAnimationSet(): %s not found", filename.c_str());
@@ -50,35 +62,37 @@ AnimationManager::~AnimationManager() {
 	cleanUp();
 // NDEBUG is used by posix to disable assertions, so use the same MACRO.
 #ifndef NDEBUG
-	if (!names.empty()) {
-		Utils::logError("AnimationManager: Still holding these animations:");
-		for (size_t i = 0; i < names.size(); i++) {
-			Utils::logError("%s %d", names[i].c_str(), counts[i]);
+	bool still_holding = false;
+	for (size_t i = 0; i < registered.size(); i++) {
+		if (!registered[i])
+			continue;
+
+		if (!still_holding) {
+			Utils::logError("AnimationManager: Still holding these animations:");
+			still_holding = true;
 		}
+		Utils::logError("%s %d", symbols->getString(static_cast<SymbolID>(i)).c_str(), counts[i]);
 	}
-	assert(names.size() == 0);
+	assert(!still_holding);
 #endif
 }
 
 void AnimationManager::increaseCount(const std::string &name) {
-	std::vector<std::string>::iterator found = find(names.begin(), names.end(), name);
-	if (found != names.end()) {
-		size_t index = static_cast<size_t>(distance(names.begin(), found));
-		counts[index]++;
+	SymbolID id = getFilenameID(name);
+	if (registered[id]) {
+		counts[id]++;
 	}
 	else {
-		sets.push_back(0);
-		names.push_back(name);
-		counts.push_back(1);
+		sets[id] = 0;
+		counts[id] = 1;
+		registered[id] = true;
 	}
 }
 
 void AnimationManager::decreaseCount(const std::string &name) {
-
-	std::vector<std::string>::iterator found = find(names.begin(), names.end(), name);
-	if (found != names.end()) {
-		size_t index = static_cast<size_t>(distance(names.begin(), found));
-		counts[index]--;
+	SymbolID id = symbols->find(name);
+	if (id < registered.size() && registered[id]) {
+		counts[id]--;
 	}
 	else {
 		Utils::logError("AnimationManager::decreaseCount(): %s not found", name.c_str());
@@ -88,14 +102,12 @@ void AnimationManager::decreaseCount(const std::string &name) {
 }
 
 void AnimationManager::cleanUp() {
-	int i = static_cast<int>(sets.size()) - 1;
-	while (i >= 0) {
-		if (counts[i] <= 0) {
+	for (size_t i = 0; i < sets.size(); ++i) {
+		if (registered[i] && counts[i] <= 0) {
 			delete sets[i];
-			counts.erase(counts.begin()+i);
-			sets.erase(sets.begin()+i);
-			names.erase(names.begin()+i);
+			sets[i] = 0;
+			counts[i] = 0;
+			registered[i] = false;
 		}
-		--i;
 	}
 }
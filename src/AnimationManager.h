@@ -20,14 +20,18 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #define ANIMATION_MANAGER_H
 
 #include "CommonIncludes.h"
+#include "SymbolTable.h"
 
 class AnimationSet;
 
 class AnimationManager {
 private:
+	// indexed by the SymbolID of the filename
 	std::vector<AnimationSet*> sets;
-	std::vector<std::string> names;
 	std::vector<int> counts;
+	std::vector<bool> registered;
+
+	SymbolID getFilenameID(const std::string &name);
 
 public:
 	AnimationManager();
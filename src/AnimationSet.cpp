@@ -31,25 +31,35 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include <cassert>
 
 Animation *AnimationSet::getAnimation(const std::string &_name) {
+	return new Animation(getAnimationDef(_name));
+}
+
+Animation *AnimationSet::getAnimation(SymbolID id) {
+	return new Animation(getAnimationDef(id));
+}
+
+const AnimationDef *AnimationSet::getAnimationDef(const std::string &_name) {
+	return getAnimationDef(symbols->find(_name));
+}
+
+const AnimationDef *AnimationSet::getAnimationDef(SymbolID id) {
 	if (!loaded)
 		load();
 
-	if (!_name.empty()) {
-		for (size_t i = 0; i < animations.size(); i++) {
-			if (animations[i]->getName() == _name)
-				return new Animation(*animations[i]);
-		}
-	}
+	if (id != SymbolTable::NONE && id < lookup.size() && lookup[id])
+		return lookup[id];
 
-	return new Animation(*defaultAnimation);
+	return defaultAnimation;
 }
 
 unsigned AnimationSet::getAnimationFrames(const std::string &_name) {
 	if (!loaded)
 		load();
-	for (size_t i = 0; i < animations.size(); i++)
-		if (animations[i]->getName() == _name)
-			return animations[i]->getFrameCount();
+
+	SymbolID id = symbols->find(_name);
+	if (id != SymbolTable::NONE && id < lookup.size() && lookup[id])
+		return lookup[id]->getFrameCount();
+
 	return 0;
 }
 
@@ -57,10 +67,12 @@ AnimationSet::AnimationSet(const std::string &animationname)
 	: name(animationname)
 	, loaded(false)
 	, parent(NULL)
+	, lookup()
 	, animations() {
 	sprite = new AnimationMedia();
-	defaultAnimation = new Animation("default", "play_once", sprite, Renderable::BLEND_NORMAL, 255, Color(255,255,255));
-	defaultAnimation->setupUncompressed(Point(), Point(), 0, 1, 0);
+	blankAnimation = new AnimationDef("default", "play_once", sprite, Renderable::BLEND_NORMAL, 255, Color(255,255,255));
+	blankAnimation->setupUncompressed(Point(), Point(), 0, 1, 0);
+	defaultAnimation = blankAnimation;
 }
 
 void AnimationSet::load() {
@@ -85,7 +97,7 @@ void AnimationSet::load() {
 	std::string starting_animation = "";
 	bool first_section=true;
 	bool compressed_loading=false; // is reset every section to false, set by frame keyword
-	Animation *newanim = NULL;
+	AnimationDef *newanim = NULL;
 	std::vector<short> active_frames;
 
 	unsigned short parent_anim_frames = 0;
@@ -95,7 +107,7 @@ void AnimationSet::load() {
 		// create the animation if finished parsing a section
 		if (parser.new_section) {
 			if (!first_section && !compressed_loading) {
-				Animation *a = new Animation(_name, type, sprite, blend_mode, alpha_mod, color_mod);
+				AnimationDef *a = new AnimationDef(_name, type, sprite, blend_mode, alpha_mod, color_mod);
 				a->setupUncompressed(render_size, render_offset, position, frames, duration);
 				if (!active_frames.empty())
 					a->setActiveFrames(active_frames);
@@ -189,7 +201,7 @@ void AnimationSet::load() {
 			else if (parser.key == "frame") {
 				// @ATTR animation.frame|int, int, int, int, int, int, int, int, string: Index, Direction, X, Y, Width, Height, X offset, Y offset, Image ID|A single frame of a compressed animation. The image ID may be omitted, in which case the first available image will be used.
 				if (compressed_loading == false) { // first frame statement in section
-					newanim = new Animation(_name, type, sprite, blend_mode, alpha_mod, color_mod);
+					newanim = new AnimationDef(_name, type, sprite, blend_mode, alpha_mod, color_mod);
 					newanim->setup(frames, duration);
 					if (!active_frames.empty())
 						newanim->setActiveFrames(active_frames);
@@ -228,7 +240,7 @@ void AnimationSet::load() {
 
 	if (!compressed_loading) {
 		// add final animation
-		Animation *a = new Animation(_name, type, sprite, blend_mode, alpha_mod, color_mod);
+		AnimationDef *a = new AnimationDef(_name, type, sprite, blend_mode, alpha_mod, color_mod);
 		a->setupUncompressed(render_size, render_offset, position, frames, duration);
 		if (!active_frames.empty())
 			a->setActiveFrames(active_frames);
@@ -236,10 +248,17 @@ void AnimationSet::load() {
 		animations.push_back(a);
 	}
 
+	// if there are multiple animations with the same name, the first one is used
+	for (size_t i = 0; i < animations.size(); i++) {
+		SymbolID id = animations[i]->getID();
+		if (id >= lookup.size())
+			lookup.resize(id+1, NULL);
+		if (!lookup[id])
+			lookup[id] = animations[i];
+	}
+
 	if (starting_animation != "") {
-		Animation *a = getAnimation(starting_animation);
-		delete defaultAnimation;
-		defaultAnimation = a;
+		defaultAnimation = getAnimationDef(starting_animation);
 	}
 }
 
@@ -247,7 +266,7 @@ AnimationSet::~AnimationSet() {
 	if (sprite) sprite->unref();
 	for (unsigned i = 0; i < animations.size(); ++i)
 		delete animations[i];
-	delete defaultAnimation;
+	delete blankAnimation;
 	delete sprite;
 }
 
@@ -22,8 +22,10 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 
 #include "CommonIncludes.h"
 #include "AnimationMedia.h"
+#include "SymbolTable.h"
 
 class Animation;
+class AnimationDef;
 
 /**
  * The animation set contains all animations of one entity, hence it
@@ -35,16 +37,19 @@ class AnimationSet {
 private:
 	const std::string name; //i.e. animations/goblin_runner.txt, matches the animations filename.
 	std::string imagefile;
-	Animation *defaultAnimation; // has always a non-null animation, in case of successfull load it contains the first animation in the animation file.
+	AnimationDef *blankAnimation; // used as the default animation when nothing could be loaded
+	const AnimationDef *defaultAnimation; // has always a non-null animation, in case of successfull load it contains the first animation in the animation file.
 	bool loaded;
 	AnimationSet *parent;
 
+	std::vector<const AnimationDef*> lookup; // indexed by the SymbolID of the animation name
+
 	void load();
 	unsigned getAnimationFrames(const std::string &_name);
 
 public:
 
-	std::vector<Animation*> animations;
+	std::vector<AnimationDef*> animations;
 
 	AnimationMedia *sprite;
 
@@ -59,6 +64,14 @@ public:
 	 */
 	Animation *getAnimation(const std::string &name);
 
+	/**
+	 * Returns the shared definition of the animation specified by \a name,
+	 * or the default animation if it is not found. Owned by the animation set.
+	 */
+	const AnimationDef *getAnimationDef(const std::string &name);
+	const AnimationDef *getAnimationDef(SymbolID id);
+	Animation *getAnimation(SymbolID id);
+
 	const std::string &getName() {
 		return name;
 	}
@@ -63,6 +63,7 @@ Avatar::Avatar()
 	, attack_cursor(false)
 	, mm_key(settings->mouse_move_swap ? Input::MAIN2 : Input::MAIN1)
 	, mm_is_distant(false)
+	, attack_anim_id(SymbolTable::NONE)
 	, hero_stats(NULL)
 	, charmed_stats(NULL)
 	, act_target()
@@ -86,7 +87,7 @@ Avatar::Avatar()
 	// TODO
 	// set cooldown_hit to duration of hit animation if undefined
 	if (!stats.cooldown_hit_enabled) {
-		Animation *hit_anim = animationSet->getAnimation("hit");
+		Animation *hit_anim = animationSet->getAnimation(SymbolTable::ANIM_HIT);
 		if (hit_anim) {
 			stats.cooldown_hit.setDuration(hit_anim->getDuration());
 			delete hit_anim;
@@ -119,7 +120,7 @@ Avatar::Avatar()
 		infile.close();
 	}
 
-	loadStepFX(stats.sfx_step);
+	loadStepFX(stats.getTemplate().sfx_step);
 }
 
 void Avatar::init() {
@@ -166,14 +167,17 @@ void Avatar::init() {
 
 	// Find untransform power index to use for manual untransfrom ability
 	untransform_power = 0;
-	std::map<PowerID, Power>::iterator power_it;
-	for (power_it = powers->powers.begin(); power_it != powers->powers.end(); ++power_it) {
-		if (untransform_power == 0 && power_it->second.required_items.empty() && power_it->second.spawn_type == "untransform") {
-			untransform_power = power_it->first;
+	for (PowerID id = 0; id < powers->powers.getIDLimit(); ++id) {
+		if (!powers->powers.contains(id))
+			continue;
+
+		const Power& power = powers->powers[id];
+		if (untransform_power == 0 && power.required_items.empty() && power.spawn_type == "untransform") {
+			untransform_power = id;
 		}
 
-		power_cooldown_timers[power_it->first] = Timer();
-		power_cast_timers[power_it->first] = Timer();
+		power_cooldown_timers[id] = Timer();
+		power_cast_timers[id] = Timer();
 	}
 
 	stats.animations = "animations/hero.txt";
@@ -190,7 +194,7 @@ void Avatar::handleNewMap() {
  * Load avatar sprite layer definitions into vector.
  */
 void Avatar::loadLayerDefinitions() {
-	if (!stats.layer_reference_order.empty())
+	if (!stats.getTemplate().layer_reference_order.empty())
 		return;
 
 	Utils::logError("Avatar: Loading render layers from engine/hero_layers.txt is deprecated! Render layers should be loaded in the 'render_layers' section of engine/stats.txt.");
@@ -214,7 +218,7 @@ void Avatar::loadLayerDefinitions() {
  * Walking/running steps sound depends on worn armor
  */
 void Avatar::loadStepFX(const std::string& stepname) {
-	std::string filename = stats.sfx_step;
+	std::string filename = stats.getTemplate().sfx_step;
 	if (stepname != "") {
 		filename = stepname;
 	}
@@ -482,7 +486,7 @@ void Avatar::logic() {
 		switch(stats.cur_state) {
 			case StatBlock::ENTITY_STANCE:
 
-				setAnimation("stance");
+				setAnimation(SymbolTable::ANIM_STANCE);
 
 				// allowed to move or use powers?
 				if (settings->mouse_move) {
@@ -529,7 +533,7 @@ void Avatar::logic() {
 
 			case StatBlock::ENTITY_MOVE:
 
-				setAnimation("run");
+				setAnimation(SymbolTable::ANIM_RUN);
 
 				if (!sound_steps.empty()) {
 					int stepfx = rand() % static_cast<int>(sound_steps.size());
@@ -558,7 +562,7 @@ void Avatar::logic() {
 					break;
 				}
 
-				if (activeAnimation->getName() != "run")
+				if (activeAnimation->getID() != SymbolTable::ANIM_RUN)
 					stats.cur_state = StatBlock::ENTITY_STANCE;
 
 				if (settings->mouse_move && settings->mouse_move_attack && cursor_enemy && !cursor_enemy->stats.hero_ally && mm_can_use_power && powers->checkCombatRange(mm_attack_id, &stats, cursor_enemy->stats.pos)) {
@@ -570,7 +574,7 @@ void Avatar::logic() {
 
 			case StatBlock::ENTITY_POWER:
 
-				setAnimation(attack_anim);
+				setAnimation(attack_anim_id);
 
 				if (attack_cursor) {
 					curs->setCursor(CursorManager::CURSOR_ATTACK);
@@ -601,7 +605,7 @@ void Avatar::logic() {
 				}
 
 				// animation is done, switch back to normal stance
-				if ((activeAnimation->isLastFrame() && stats.state_timer.isEnd()) || activeAnimation->getName() != attack_anim) {
+				if ((activeAnimation->isLastFrame() && stats.state_timer.isEnd()) || activeAnimation->getID() != attack_anim_id) {
 					stats.cur_state = StatBlock::ENTITY_STANCE;
 					stats.cooldown.reset(Timer::BEGIN);
 					allowed_to_use_power = false;
@@ -619,7 +623,7 @@ void Avatar::logic() {
 
 			case StatBlock::ENTITY_BLOCK:
 
-				setAnimation("block");
+				setAnimation(SymbolTable::ANIM_BLOCK);
 
 				stats.blocking = false;
 
@@ -627,7 +631,7 @@ void Avatar::logic() {
 
 			case StatBlock::ENTITY_HIT:
 
-				setAnimation("hit");
+				setAnimation(SymbolTable::ANIM_HIT);
 
 				if (activeAnimation->isFirstFrame()) {
 					stats.effects.triggered_hit = true;
@@ -638,7 +642,7 @@ void Avatar::logic() {
 					}
 				}
 
-				if (activeAnimation->getTimesPlayed() >= 1 || activeAnimation->getName() != "hit") {
+				if (activeAnimation->getTimesPlayed() >= 1 || activeAnimation->getID() != SymbolTable::ANIM_HIT) {
 					stats.cur_state = StatBlock::ENTITY_STANCE;
 					if (settings->mouse_move) {
 						drag_walking = true;
@@ -657,7 +661,7 @@ void Avatar::logic() {
 					untransform();
 				}
 
-				setAnimation("die");
+				setAnimation(SymbolTable::ANIM_DIE);
 
 				if (!stats.corpse && activeAnimation->isFirstFrame() && activeAnimation->getTimesPlayed() < 1) {
 					stats.effects.clearEffects();
@@ -694,7 +698,7 @@ void Avatar::logic() {
 						inpt->lock[Input::MAIN1] = true;
 				}
 
-				if (!stats.corpse && (activeAnimation->getTimesPlayed() >= 1 || activeAnimation->getName() != "die")) {
+				if (!stats.corpse && (activeAnimation->getTimesPlayed() >= 1 || activeAnimation->getID() != SymbolTable::ANIM_DIE)) {
 					stats.corpse = true;
 					menu->game_over->visible = true;
 				}
@@ -769,6 +773,7 @@ void Avatar::logic() {
 						current_power = power_id;
 						act_target = target;
 						attack_anim = power.attack_anim;
+						attack_anim_id = power.attack_anim_id;
 					}
 
 					if (power.state_duration > 0)
@@ -893,9 +898,10 @@ void Avatar::transform() {
 	stats.powers_passive = charmed_stats->powers_passive;
 	stats.effects.clearEffects();
 	stats.animations = charmed_stats->animations;
-	stats.layer_reference_order = charmed_stats->layer_reference_order;
-	stats.layer_def = charmed_stats->layer_def;
-	stats.animation_slots = charmed_stats->animation_slots;
+	StatTemplate& stat_template = stats.editTemplate();
+	stat_template.layer_reference_order = charmed_stats->getTemplate().layer_reference_order;
+	stat_template.layer_def = charmed_stats->getTemplate().layer_def;
+	stat_template.animation_slots = charmed_stats->getTemplate().animation_slots;
 
 	anim->decreaseCount(hero_stats->animations);
 	animationSet = NULL;
@@ -954,9 +960,10 @@ void Avatar::untransform() {
 	stats.powers_list = hero_stats->powers_list;
 	stats.powers_passive = hero_stats->powers_passive;
 	stats.animations = hero_stats->animations;
-	stats.layer_reference_order = hero_stats->layer_reference_order;
-	stats.layer_def = hero_stats->layer_def;
-	stats.animation_slots = hero_stats->animation_slots;
+	StatTemplate& stat_template = stats.editTemplate();
+	stat_template.layer_reference_order = hero_stats->getTemplate().layer_reference_order;
+	stat_template.layer_def = hero_stats->getTemplate().layer_def;
+	stat_template.animation_slots = hero_stats->getTemplate().animation_slots;
 
 	anim->decreaseCount(charmed_stats->animations);
 	animationSet = NULL;
@@ -965,14 +972,14 @@ void Avatar::untransform() {
 
 	// This is a bit of a hack.
 	// In order to switch to the stance animation, we can't already be in a stance animation
-	setAnimation("run");
+	setAnimation(SymbolTable::ANIM_RUN);
 
 	for (int i=0; i<Stats::COUNT; ++i) {
 		stats.starting[i] = hero_stats->starting[i];
 	}
 
 	loadSounds();
-	loadStepFX(stats.sfx_step);
+	loadStepFX(stats.getTemplate().sfx_step);
 
 	delete charmed_stats;
 	delete hero_stats;
@@ -29,6 +29,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 
 #include "CommonIncludes.h"
 #include "Entity.h"
+#include "SymbolTable.h"
 #include "Utils.h"
 
 class Entity;
@@ -118,6 +119,7 @@ public:
 	std::queue<std::pair<std::string, int> > log_msg;
 
 	std::string attack_anim;
+	SymbolID attack_anim_id;
 	bool setPowers;
 	bool revertPowers;
 	PowerID untransform_power;
@@ -36,29 +36,39 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "SharedGameResources.h"
 #include "SharedResources.h"
 #include "StatBlock.h"
+#include "SymbolTable.h"
 #include "UtilsMath.h"
 #include "UtilsParsing.h"
 
 CampaignManager::CampaignManager()
 	: bonus_xp(0.0)
-	, random_status(0) {
+	, random_status(0)
+	, version(1)
+	, version_level(0)
+	, version_class(SymbolTable::NONE) {
+	// status 0 is returned for empty status names
+	status_names.push_back("");
+	status.push_back(false);
 }
 
+/**
+ * Statuses are numbered in the order they're registered, so that they can be stored in a bitset
+ */
 StatusID CampaignManager::registerStatus(const std::string& s) {
 	if (s.empty())
 		return 0;
 
-	StatusID new_id = Utils::hashString(s);
-
 	// check if this status was already registered
-	StatusMap::iterator it;
-	it = status.find(new_id);
-	if (it != status.end())
-		return it->first;
+	std::map<std::string, StatusID>::iterator it;
+	it = status_ids.find(s);
+	if (it != status_ids.end())
+		return it->second;
 
 	// register a new status
-	status[new_id].first = false;
-	status[new_id].second = s;
+	StatusID new_id = status_names.size();
+	status_ids[s] = new_id;
+	status_names.push_back(s);
+	status.push_back(false);
 	return new_id;
 }
 
@@ -81,58 +91,87 @@ void CampaignManager::setAll(const std::string& s) {
 std::string CampaignManager::getAll() {
 	std::string output("");
 
-	StatusMap::iterator it;
-	for (it = status.begin(); it != status.end(); ++it) {
-		if (it->second.first)
-			output += it->second.second;
+	for (size_t i = 1; i < status.size(); ++i) {
+		if (!status[i])
+			continue;
 
-		StatusMap::iterator temp = it;
-		++temp;
-		if (temp != status.end() && temp->second.first) {
+		if (!output.empty())
 			output += ',';
-		}
+		output += status_names[i];
 	}
 	return output;
 }
 
 bool CampaignManager::checkStatus(const StatusID s) {
-	StatusMap::iterator it;
-	it = status.find(s);
-	if (it != status.end() && it->second.first)
-		return true;
-
-	return false;
+	return s < status.size() && status[s];
 }
 
 void CampaignManager::setStatus(const StatusID s) {
 	// if it's already set, don't set it again
-	if (checkStatus(s)) return;
+	if (checkStatus(s) || s >= status.size()) return;
 
-	status[s].first = true;
+	status[s] = true;
 	pc->stats.check_title = true;
+	version++;
 }
 
 void CampaignManager::unsetStatus(const StatusID s) {
 	// if it's already unset, don't unset it again
 	if (!checkStatus(s)) return;
 
-	status[s].first = false;
+	status[s] = false;
 	pc->stats.check_title = true;
+	version++;
 }
 
 void CampaignManager::resetAllStatuses() {
-	StatusMap::iterator it;
-	for (it = status.begin(); it != status.end(); ++it) {
-		it->second.first = false;
-	}
+	status.assign(status.size(), false);
+	version++;
 }
 
 void CampaignManager::getSetStatusStrings(std::vector<std::string>& status_strings) {
-	StatusMap::iterator it;
-	for (it = status.begin(); it != status.end(); ++it) {
-		if (it->second.first)
-			status_strings.push_back(it->second.second);
+	for (size_t i = 1; i < status.size(); ++i) {
+		if (status[i])
+			status_strings.push_back(status_names[i]);
+	}
+}
+
+/**
+ * Items and the hero's level can also change outside of CampaignManager (e.g. in the inventory menu),
+ * so they're compared against the values from the last call. Called once per frame.
+ */
+void CampaignManager::updateVersion() {
+	bool changed = false;
+
+	if (pc->stats.level != version_level || pc->stats.character_class_id != version_class) {
+		version_level = pc->stats.level;
+		version_class = pc->stats.character_class_id;
+		changed = true;
+	}
+
+	size_t count = 0;
+	for (int i = MenuInventory::EQUIPMENT; i <= MenuInventory::CARRIED; ++i) {
+		count += static_cast<size_t>(menu->inv->inventory[i].getSlotNumber());
+	}
+	if (version_items.size() != count) {
+		version_items.resize(count);
+		changed = true;
 	}
+
+	size_t index = 0;
+	for (int i = MenuInventory::EQUIPMENT; i <= MenuInventory::CARRIED; ++i) {
+		ItemStorage& storage = menu->inv->inventory[i];
+		for (int j = 0; j < storage.getSlotNumber(); ++j) {
+			ItemStack& last = version_items[index++];
+			if (last.item != storage[j].item || last.quantity != storage[j].quantity) {
+				last = storage[j];
+				changed = true;
+			}
+		}
+	}
+
+	if (changed)
+		version++;
 }
 
 bool CampaignManager::checkCurrency(int quantity) {
@@ -151,6 +190,7 @@ void CampaignManager::removeCurrency(int quantity) {
 
 	if (max_amount > 0) {
 		menu->inv->removeCurrency(max_amount);
+		version++;
 		pc->logMsg(msg->getv("%d %s removed.", max_amount, eset->loot.currency.c_str()), Avatar::MSG_UNIQUE);
 		items->playSound(eset->misc.currency_id);
 	}
@@ -169,6 +209,8 @@ void CampaignManager::removeItem(ItemStack istack) {
 	int max_amount = std::min(item_count, istack.quantity);
 
 	if (menu->inv->remove(istack.item, max_amount)) {
+		version++;
+
 		if (max_amount > 1)
 			pc->logMsg(msg->getv("%s x%d removed.", items->getItemName(istack.item).c_str(), max_amount), Avatar::MSG_UNIQUE);
 		else if (max_amount == 1)
@@ -184,6 +226,7 @@ void CampaignManager::rewardItem(ItemStack istack) {
 		return;
 
 	menu->inv->add(istack, MenuInventory::CARRIED, ItemStorage::NO_SLOT, MenuInventory::ADD_PLAY_SOUND, MenuInventory::ADD_AUTO_EQUIP);
+	version++;
 
 	if (istack.item == eset->misc.currency_id) {
 		pc->logMsg(msg->getv("You receive %d %s.", istack.quantity, eset->loot.currency.c_str()), Avatar::MSG_UNIQUE);
@@ -303,6 +346,45 @@ bool CampaignManager::checkRequirementsInVector(const std::vector<EventComponent
 	return true;
 }
 
+/**
+ * Same as checkAllRequirements(), but for requirements compiled by EventManager::compileRequirements()
+ */
+bool CampaignManager::checkRequirement(const EventRequirement& req) {
+	switch (req.type) {
+		case EventComponent::REQUIRES_STATUS:
+			return checkStatus(static_cast<StatusID>(req.id));
+		case EventComponent::REQUIRES_NOT_STATUS:
+			return !checkStatus(static_cast<StatusID>(req.id));
+		case EventComponent::REQUIRES_CURRENCY:
+			return checkCurrency(req.value);
+		case EventComponent::REQUIRES_NOT_CURRENCY:
+			return !checkCurrency(req.value);
+		case EventComponent::REQUIRES_ITEM:
+			return checkItem(ItemStack(req.id, req.value));
+		case EventComponent::REQUIRES_NOT_ITEM:
+			return !checkItem(ItemStack(req.id, req.value));
+		case EventComponent::REQUIRES_LEVEL:
+			return pc->stats.level >= req.value;
+		case EventComponent::REQUIRES_NOT_LEVEL:
+			return pc->stats.level < req.value;
+		case EventComponent::REQUIRES_CLASS:
+			return pc->stats.character_class_id == static_cast<SymbolID>(req.id);
+		case EventComponent::REQUIRES_NOT_CLASS:
+			return pc->stats.character_class_id != static_cast<SymbolID>(req.id);
+		default:
+			return true;
+	}
+}
+
+bool CampaignManager::checkRequirements(const std::vector<EventRequirement>& reqs) {
+	for (size_t i = 0; i < reqs.size(); ++i) {
+		if (!checkRequirement(reqs[i]))
+			return false;
+	}
+
+	return true;
+}
+
 void CampaignManager::randomStatusAppend(const StatusID s) {
 	if (std::find(random_status_pool.begin(), random_status_pool.end(), s) == random_status_pool.end()) {
 		if (random_status_pool.empty())
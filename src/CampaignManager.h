@@ -28,15 +28,15 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 
 #include "CommonIncludes.h"
 #include "ItemManager.h"
+#include "SymbolTable.h"
 #include "Utils.h"
 
 class EventComponent;
+class EventRequirement;
 class StatBlock;
 
 class CampaignManager {
 public:
-	typedef std::map<StatusID, std::pair<bool, std::string> > StatusMap;
-
 	CampaignManager();
 	~CampaignManager();
 
@@ -48,6 +48,8 @@ public:
 	void unsetStatus(const StatusID s);
 	void resetAllStatuses();
 	void getSetStatusStrings(std::vector<std::string>& status_strings);
+	void updateVersion();
+	unsigned getVersion() { return version; }
 	bool checkCurrency(int quantity);
 	bool checkItem(ItemStack istack);
 	void removeCurrency(int quantity);
@@ -58,6 +60,8 @@ public:
 	void restoreHPMP(const std::string& s);
 	bool checkAllRequirements(const EventComponent& ec);
 	bool checkRequirementsInVector(const std::vector<EventComponent>& ec_vec);
+	bool checkRequirement(const EventRequirement& req);
+	bool checkRequirements(const std::vector<EventRequirement>& reqs);
 
 	void randomStatusAppend(const StatusID s);
 	void randomStatusClear();
@@ -72,10 +76,18 @@ public:
 	static const bool XP_SHOW_MSG = true;
 
 private:
-	StatusMap status;
+	std::map<std::string, StatusID> status_ids;
+	std::vector<std::string> status_names;
+	std::vector<bool> status;
 
 	std::vector<StatusID> random_status_pool;
 	StatusID random_status;
+
+	// bumped whenever a requirement check could return a different result
+	unsigned version;
+	int version_level;
+	SymbolID version_class;
+	std::vector<ItemStack> version_items;
 };
 
 
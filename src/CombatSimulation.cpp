@@ -0,0 +1,309 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class CombatSimulation
+ *
+ * Runs fights between two groups of entities on an empty arena without drawing anything,
+ * then logs who won and how long the combat logic took per frame.
+ * Started with the --simulate-combat command line option.
+ *
+ * Attackers fight as allies of the hero and defenders as enemies. The entity AI is built
+ * around the hero's position, so the hero stands behind the attackers as a spectator.
+ */
+
+#include "Avatar.h"
+#include "CombatSimulation.h"
+#include "CombatText.h"
+#include "Entity.h"
+#include "EntityManager.h"
+#include "FileParser.h"
+#include "GameStatePlay.h"
+#include "HazardManager.h"
+#include "MapCollision.h"
+#include "MapRenderer.h"
+#include "PowerManager.h"
+#include "Settings.h"
+#include "SharedGameResources.h"
+#include "SharedResources.h"
+#include "UtilsParsing.h"
+
+CombatSimulation::CombatSimulation()
+	: play(NULL)
+	, runs(1)
+	, max_ticks(0)
+	, distance(4)
+	, seed(-1)
+	, attacker_groups()
+	, defender_groups()
+	, attackers()
+	, defenders()
+	, tick_time_total(0)
+	, tick_time_max(0)
+	, tick_count(0)
+{
+	max_ticks = settings->max_frames_per_sec * 60;
+}
+
+CombatSimulation::~CombatSimulation() {
+	delete play;
+}
+
+bool CombatSimulation::load(const std::string& filename) {
+	FileParser infile;
+	// @CLASS CombatSimulation|Description of combat simulation files, which are run with --simulate-combat
+	if (!infile.open(filename, FileParser::MOD_FILE, FileParser::ERROR_NORMAL))
+		return false;
+
+	while (infile.next()) {
+		if (infile.section == "simulation") {
+			if (infile.key == "runs") {
+				// @ATTR simulation.runs|int|The number of fights to run.
+				runs = std::max(Parse::toInt(infile.val), 1);
+			}
+			else if (infile.key == "duration") {
+				// @ATTR simulation.duration|duration|A fight that lasts longer than this ends without a winner. Defaults to 60 seconds.
+				max_ticks = std::max(Parse::toDuration(infile.val), 1);
+			}
+			else if (infile.key == "distance") {
+				// @ATTR simulation.distance|int|The starting distance in tiles between the front lines of the two groups. Defaults to 4.
+				distance = std::max(Parse::toInt(infile.val), 1);
+			}
+			else if (infile.key == "seed") {
+				// @ATTR simulation.seed|int|Seeds the random number generator, so that the results can be repeated.
+				seed = std::max(Parse::toInt(infile.val), 0);
+			}
+			else {
+				infile.error("CombatSimulation: '%s' is not a valid key.", infile.key.c_str());
+			}
+		}
+		else if (infile.section == "attackers" || infile.section == "defenders") {
+			if (infile.key == "entity") {
+				// @ATTR attackers.entity|repeatable(filename, int) : Entity file, Count|Adds this many entities of a type to the attacking group. Attackers fight on the hero's side.
+				// @ATTR defenders.entity|repeatable(filename, int) : Entity file, Count|Adds this many entities of a type to the defending group.
+				Group group;
+				group.type = Parse::popFirstString(infile.val);
+				group.count = Parse::popFirstInt(infile.val);
+
+				if (group.type.empty() || group.count <= 0) {
+					infile.error("CombatSimulation: Entity type or count is missing.");
+					continue;
+				}
+
+				if (infile.section == "attackers")
+					attacker_groups.push_back(group);
+				else
+					defender_groups.push_back(group);
+			}
+			else {
+				infile.error("CombatSimulation: '%s' is not a valid key.", infile.key.c_str());
+			}
+		}
+	}
+	infile.close();
+
+	if (attacker_groups.empty() || defender_groups.empty()) {
+		Utils::logError("CombatSimulation: '%s' needs both attackers and defenders.", filename.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Run all fights and log the results
+ */
+void CombatSimulation::run() {
+	if (seed >= 0)
+		srand(static_cast<unsigned>(seed));
+
+	play = new GameStatePlay();
+
+	int wins[3] = {0, 0, 0};
+	unsigned long fight_ticks = 0;
+
+	for (int i = 0; i < runs; ++i) {
+		setupArena();
+		unsigned long start_tick = tick_count;
+		wins[runFight(i)]++;
+		fight_ticks += tick_count - start_tick;
+	}
+
+	float frames_per_sec = static_cast<float>(settings->max_frames_per_sec);
+	float frequency = static_cast<float>(SDL_GetPerformanceFrequency());
+	float avg_ms = tick_count > 0 ? (static_cast<float>(tick_time_total) * 1000.f / frequency) / static_cast<float>(tick_count) : 0;
+	float max_ms = static_cast<float>(tick_time_max) * 1000.f / frequency;
+
+	Utils::logInfo("CombatSimulation: Attackers won %d, defenders won %d, undecided %d.", wins[WINNER_ATTACKERS], wins[WINNER_DEFENDERS], wins[WINNER_NONE]);
+	Utils::logInfo("CombatSimulation: Average fight length: %.2f seconds.", (static_cast<float>(fight_ticks) / static_cast<float>(runs)) / frames_per_sec);
+	Utils::logInfo("CombatSimulation: Time per frame: %.4f ms average, %.4f ms maximum over %lu frames.", avg_ms, max_ms, tick_count);
+}
+
+/**
+ * Clear the previous fight and place both groups facing each other on an empty map
+ */
+void CombatSimulation::setupArena() {
+	int attacker_columns = countColumns(attacker_groups);
+	int defender_columns = countColumns(defender_groups);
+
+	mapr->w = static_cast<unsigned short>(ARENA_MARGIN * 2 + SPECTATOR_DISTANCE + attacker_columns + distance + defender_columns);
+	mapr->h = static_cast<unsigned short>(ARENA_MARGIN * 2 + GROUP_HEIGHT);
+
+	Map_Layer collision_layer(mapr->w, std::vector<unsigned short>(mapr->h, 0));
+	mapr->collider.setMap(collision_layer, mapr->w, mapr->h);
+
+	entitym->grid.clear();
+	for (size_t i = 0; i < entitym->entities.size(); ++i) {
+		entitym->pool.destroy(entitym->entities[i]);
+	}
+	entitym->entities.clear();
+	entitym->grid.init(mapr->w, mapr->h);
+	entitym->path_service.clear();
+	entitym->hero_stealth = 0;
+
+	while (!powers->map_enemies.empty()) {
+		powers->map_enemies.pop();
+	}
+
+	pc->handleNewMap();
+	hazards->handleNewMap();
+	powers->handleNewMap(&mapr->collider);
+
+	float center_y = static_cast<float>(mapr->h / 2) + 0.5f;
+
+	pc->stats.summons.clear();
+	pc->stats.pos = FPoint(static_cast<float>(ARENA_MARGIN) + 0.5f, center_y);
+	mapr->collider.block(pc->stats.pos.x, pc->stats.pos.y, !MapCollision::IS_ALLY);
+
+	int attacker_front = ARENA_MARGIN + SPECTATOR_DISTANCE + attacker_columns - 1;
+	int defender_front = attacker_front + distance;
+
+	spawnTeam(attacker_groups, true, attacker_front, -1, attackers);
+	spawnTeam(defender_groups, false, defender_front, 1, defenders);
+
+	mapr->cam.warpTo(FPoint(static_cast<float>(attacker_front + defender_front) / 2.f, center_y));
+	entitym->grid.sync(entitym->entities);
+}
+
+/**
+ * Place a group in columns of GROUP_HEIGHT, starting at front_x and moving away from the other group
+ */
+void CombatSimulation::spawnTeam(const std::vector<Group>& groups, bool is_attacker, int front_x, int direction_x, std::vector<Entity*>& team) {
+	team.clear();
+
+	int index = 0;
+	for (size_t i = 0; i < groups.size(); ++i) {
+		for (int j = 0; j < groups[i].count; ++j) {
+			Entity* e = entitym->getEntityPrototype(groups[i].type);
+
+			int column = index / GROUP_HEIGHT;
+			int row = index % GROUP_HEIGHT;
+			index++;
+
+			e->stats.pos.x = static_cast<float>(front_x + column * direction_x) + 0.5f;
+			e->stats.pos.y = static_cast<float>(ARENA_MARGIN + row) + 0.5f;
+			e->stats.direction = Utils::calcDirection(e->stats.pos.x, e->stats.pos.y, e->stats.pos.x - static_cast<float>(direction_x), e->stats.pos.y);
+
+			// both groups start the fight right away, instead of waiting for the hero to come near
+			e->stats.hero_ally = is_attacker;
+			e->stats.encountered = true;
+			e->stats.join_combat = true;
+
+			mapr->collider.block(e->stats.pos.x, e->stats.pos.y, is_attacker);
+
+			entitym->entities.push_back(e);
+			team.push_back(e);
+		}
+	}
+}
+
+/**
+ * Run the current fight until one of the groups is defeated or the time runs out
+ */
+int CombatSimulation::runFight(int run_index) {
+	int winner = WINNER_NONE;
+	int ticks = 0;
+
+	while (ticks < max_ticks) {
+		uint64_t start_time = SDL_GetPerformanceCounter();
+
+		entitym->logic();
+		hazards->logic();
+
+		uint64_t elapsed = SDL_GetPerformanceCounter() - start_time;
+		tick_time_total += elapsed;
+		tick_time_max = std::max(tick_time_max, elapsed);
+		tick_count++;
+		ticks++;
+
+		// nothing is displayed, so don't let combat text pile up
+		comb->clear();
+
+		if (countAlive(defenders) == 0) {
+			winner = WINNER_ATTACKERS;
+			break;
+		}
+		else if (countAlive(attackers) == 0) {
+			winner = WINNER_DEFENDERS;
+			break;
+		}
+	}
+
+	const char* result = "Undecided";
+	if (winner == WINNER_ATTACKERS)
+		result = "Attackers won";
+	else if (winner == WINNER_DEFENDERS)
+		result = "Defenders won";
+
+	Utils::logInfo("CombatSimulation: Fight %d: %s after %.2f seconds. Attackers left: %d/%d (%.0f%% HP), defenders left: %d/%d (%.0f%% HP).",
+		run_index + 1, result, static_cast<float>(ticks) / static_cast<float>(settings->max_frames_per_sec),
+		countAlive(attackers), static_cast<int>(attackers.size()), getHPPercent(attackers),
+		countAlive(defenders), static_cast<int>(defenders.size()), getHPPercent(defenders));
+
+	return winner;
+}
+
+int CombatSimulation::countColumns(const std::vector<Group>& groups) {
+	int count = 0;
+	for (size_t i = 0; i < groups.size(); ++i) {
+		count += groups[i].count;
+	}
+	return std::max((count + GROUP_HEIGHT - 1) / GROUP_HEIGHT, 1);
+}
+
+int CombatSimulation::countAlive(const std::vector<Entity*>& team) {
+	int count = 0;
+	for (size_t i = 0; i < team.size(); ++i) {
+		if (team[i]->stats.alive)
+			count++;
+	}
+	return count;
+}
+
+/**
+ * The HP that the whole group has left, as a percentage of its maximum HP
+ */
+float CombatSimulation::getHPPercent(const std::vector<Entity*>& team) {
+	float hp = 0;
+	float hp_max = 0;
+	for (size_t i = 0; i < team.size(); ++i) {
+		if (team[i]->stats.alive)
+			hp += std::max(team[i]->stats.hp, 0.f);
+		hp_max += team[i]->stats.get(Stats::HP_MAX);
+	}
+	return hp_max > 0 ? (hp * 100.f) / hp_max : 0;
+}
@@ -0,0 +1,83 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class CombatSimulation
+ *
+ * Runs fights between two groups of entities on an empty arena without drawing anything,
+ * then logs who won and how long the combat logic took per frame.
+ * Started with the --simulate-combat command line option.
+ */
+
+#ifndef COMBAT_SIMULATION_H
+#define COMBAT_SIMULATION_H
+
+#include "CommonIncludes.h"
+
+class Entity;
+class GameStatePlay;
+
+class CombatSimulation {
+private:
+	class Group {
+	public:
+		std::string type;
+		int count;
+	};
+
+	enum {
+		WINNER_NONE = 0,
+		WINNER_ATTACKERS = 1,
+		WINNER_DEFENDERS = 2
+	};
+
+	static const int GROUP_HEIGHT = 16; // entities per column of a group
+	static const int ARENA_MARGIN = 8;
+	static const int SPECTATOR_DISTANCE = 8; // how far the hero stands behind the attackers
+
+	void setupArena();
+	void spawnTeam(const std::vector<Group>& groups, bool is_attacker, int front_x, int direction_x, std::vector<Entity*>& team);
+	int runFight(int run_index);
+
+	static int countColumns(const std::vector<Group>& groups);
+	static int countAlive(const std::vector<Entity*>& team);
+	static float getHPPercent(const std::vector<Entity*>& team);
+
+	GameStatePlay* play; // owns the shared game resources (powers, hazards, entitym, etc)
+
+	int runs;
+	int max_ticks;
+	int distance;
+	int seed;
+	std::vector<Group> attacker_groups;
+	std::vector<Group> defender_groups;
+
+	std::vector<Entity*> attackers;
+	std::vector<Entity*> defenders;
+
+	uint64_t tick_time_total;
+	uint64_t tick_time_max;
+	unsigned long tick_count;
+
+public:
+	CombatSimulation();
+	~CombatSimulation();
+	bool load(const std::string& filename);
+	void run();
+};
+
+#endif
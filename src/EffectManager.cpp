@@ -37,6 +37,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 
 EffectDef::EffectDef()
 	: id("")
+	, symbol(SymbolTable::NONE)
 	, type(Effect::NONE)
 	, name("")
 	, icon(-1)
@@ -62,6 +63,7 @@ EffectParams::EffectParams()
 
 Effect::Effect()
 	: id("")
+	, symbol(SymbolTable::NONE)
 	, name("")
 	, icon(-1)
 	, timer()
@@ -98,6 +100,7 @@ Effect& Effect::operator=(const Effect& other) {
 		animation->syncTo(other.animation);
 
 	id = other.id;
+	symbol = other.symbol;
 	name = other.name;
 	icon = other.icon;
 	timer = other.timer;
@@ -259,9 +262,12 @@ bool Effect::isImmunityTypeString(const std::string& type_str) {
 }
 
 EffectManager::EffectManager()
-	: bonus(std::vector<float>(Stats::COUNT + eset->damage_types.count + eset->elements.list.size(), 0))
+	: bonus_dirty(false)
+	, bonus(std::vector<float>(Stats::COUNT + eset->damage_types.count + eset->elements.list.size(), 0))
 	, bonus_multiplier(std::vector<float>(bonus.size(), 1))
 	, bonus_primary(std::vector<int>(eset->primary_stats.list.size(), 0))
+	, bonus_changes()
+	, bonus_changed(bonus.size(), false)
 	, triggered_others(false)
 	, triggered_block(false)
 	, triggered_hit(false)
@@ -289,15 +295,66 @@ void EffectManager::clearStatus() {
 	death_sentence = false;
 	fear = false;
 	knockback_speed = 0;
+}
 
-	for (unsigned i=0; i<Stats::COUNT + eset->damage_types.count + eset->elements.list.size(); i++) {
-		bonus[i] = 0;
-		bonus_multiplier[i] = 1;
-	}
+/**
+ * Sum up the stat bonuses of all effects. Stat effects don't change while they are active,
+ * so this only needs to happen when the effect list changes.
+ * Stats with a different total are recorded in bonus_changes.
+ */
+void EffectManager::calcBonuses() {
+	bonus_dirty = false;
+
+	std::vector<float> new_bonus(bonus.size(), 0);
+	std::vector<float> new_bonus_multiplier(bonus.size(), 1);
 
 	for (unsigned i=0; i<bonus_primary.size(); i++) {
 		bonus_primary[i] = 0;
 	}
+
+	for (size_t i=0; i<effect_list.size(); ++i) {
+		const Effect& ei = effect_list[i];
+
+		if (ei.type == Effect::RESIST_ALL) {
+			new_bonus[Stats::RESIST_DAMAGE_OVER_TIME] += ei.magnitude;
+			new_bonus[Stats::RESIST_SLOW] += ei.magnitude;
+			new_bonus[Stats::RESIST_STUN] += ei.magnitude;
+			new_bonus[Stats::RESIST_KNOCKBACK] += ei.magnitude;
+			new_bonus[Stats::RESIST_DAMAGE_REFLECT] += ei.magnitude;
+			new_bonus[Stats::RESIST_STAT_DEBUFF] += ei.magnitude;
+			new_bonus[Stats::RESIST_HP_STEAL] += ei.magnitude;
+			new_bonus[Stats::RESIST_MP_STEAL] += ei.magnitude;
+		}
+		else if (ei.type >= Effect::TYPE_COUNT && ei.type < Effect::TYPE_COUNT + static_cast<int>(bonus.size())) {
+			if (ei.is_multiplier)
+				new_bonus_multiplier[ei.type - Effect::TYPE_COUNT] *= ei.magnitude;
+			else
+				new_bonus[ei.type - Effect::TYPE_COUNT] += ei.magnitude;
+		}
+		else if (ei.type >= Effect::TYPE_COUNT) {
+			bonus_primary[ei.type - Effect::TYPE_COUNT - bonus.size()] += static_cast<int>(ei.magnitude);
+		}
+	}
+
+	for (size_t i=0; i<bonus.size(); ++i) {
+		if (new_bonus[i] == bonus[i] && new_bonus_multiplier[i] == bonus_multiplier[i])
+			continue;
+
+		bonus[i] = new_bonus[i];
+		bonus_multiplier[i] = new_bonus_multiplier[i];
+
+		if (!bonus_changed[i]) {
+			bonus_changed[i] = true;
+			bonus_changes.push_back(i);
+		}
+	}
+}
+
+void EffectManager::clearBonusChanges() {
+	for (size_t i=0; i<bonus_changes.size(); ++i) {
+		bonus_changed[bonus_changes[i]] = false;
+	}
+	bonus_changes.clear();
 }
 
 void EffectManager::logic() {
@@ -339,16 +396,7 @@ void EffectManager::logic() {
 		// attack speed is calculated when getAttackSpeed() is called
 
 		// @TYPE resist_all|Applies a bonus to all of the non-elemental resistance stats.
-		else if (ei.type == Effect::RESIST_ALL) {
-			bonus[Stats::RESIST_DAMAGE_OVER_TIME] += ei.magnitude;
-			bonus[Stats::RESIST_SLOW] += ei.magnitude;
-			bonus[Stats::RESIST_STUN] += ei.magnitude;
-			bonus[Stats::RESIST_KNOCKBACK] += ei.magnitude;
-			bonus[Stats::RESIST_DAMAGE_REFLECT] += ei.magnitude;
-			bonus[Stats::RESIST_STAT_DEBUFF] += ei.magnitude;
-			bonus[Stats::RESIST_HP_STEAL] += ei.magnitude;
-			bonus[Stats::RESIST_MP_STEAL] += ei.magnitude;
-		}
+		// summed up by calcBonuses()
 
 		// @TYPE stun|Can't move or attack. Being attacked breaks stun.
 		else if (ei.type == Effect::STUN) stun = true;
@@ -362,16 +410,8 @@ void EffectManager::logic() {
 		else if (ei.type == Effect::KNOCKBACK) knockback_speed = static_cast<float>(ei.magnitude)/static_cast<float>(settings->max_frames_per_sec);
 
 		// @TYPE ${STAT}|Increases ${STAT}, where ${STAT} is any valid stat_id.
-		else if (ei.type >= Effect::TYPE_COUNT && ei.type < Effect::TYPE_COUNT + Stats::COUNT + static_cast<int>(eset->damage_types.count) + static_cast<int>(eset->elements.list.size())) {
-			if (ei.is_multiplier)
-				bonus_multiplier[ei.type - Effect::TYPE_COUNT] *= ei.magnitude;
-			else
-				bonus[ei.type - Effect::TYPE_COUNT] += ei.magnitude;
-		}
 		// @TYPE ${PRIMARYSTAT}|Increases ${PRIMARYSTAT}, where ${PRIMARYSTAT} is any of the primary stats defined in engine/primary_stats.txt. Example: physical
-		else if (ei.type >= Effect::TYPE_COUNT) {
-			bonus_primary[ei.type - Effect::TYPE_COUNT - Stats::COUNT - eset->damage_types.count - eset->elements.list.size()] += static_cast<int>(ei.magnitude);
-		}
+		// summed up by calcBonuses()
 
 		ei.timer.tick();
 
@@ -400,9 +440,12 @@ void EffectManager::logic() {
 				ei.animation->advanceFrame();
 		}
 	}
+
+	if (bonus_dirty)
+		calcBonuses();
 }
 
-void EffectManager::addEffect(StatBlock* stats, EffectDef &effect, EffectParams &params) {
+void EffectManager::addEffect(StatBlock* stats, const EffectDef &effect, EffectParams &params) {
 	refresh_stats = true;
 
 	// if we're already immune, don't add negative effects
@@ -445,9 +488,7 @@ void EffectManager::addEffect(StatBlock* stats, EffectDef &effect, EffectParams
 	for (size_t i=effect_list.size(); i>0; i--) {
 		Effect& ei = effect_list[i-1];
 
-		// while checking only id would be sufficient, it is a slow string compare
-		// so we check the type first, which is an int compare, before taking the slow path
-		if (ei.type == effect.type && ei.id == effect.id) {
+		if (ei.type == effect.type && ei.symbol == effect.symbol) {
 			if (trigger > -1 && ei.trigger == trigger)
 				return; // trigger effects can only be cast once per trigger
 
@@ -494,6 +535,7 @@ void EffectManager::addEffect(StatBlock* stats, EffectDef &effect, EffectParams
 	Effect e;
 
 	e.id = effect.id;
+	e.symbol = effect.symbol;
 	e.name = effect.name;
 	e.icon = effect.icon;
 	e.type = effect.type;
@@ -529,11 +571,14 @@ void EffectManager::addEffect(StatBlock* stats, EffectDef &effect, EffectParams
 	else {
 		effect_list.push_back(e);
 	}
+
+	bonus_dirty = true;
 }
 
 void EffectManager::removeEffect(size_t id) {
 	effect_list.erase(effect_list.begin()+id);
 	refresh_stats = true;
+	bonus_dirty = true;
 }
 
 void EffectManager::removeEffectType(const int type) {
@@ -548,7 +593,7 @@ void EffectManager::removeEffectPassive(size_t id) {
 	}
 }
 
-void EffectManager::removeEffectID(const std::vector< std::pair<std::string, int> >& remove_effects) {
+void EffectManager::removeEffectID(const std::vector< std::pair<SymbolID, int> >& remove_effects) {
 	for (size_t i = 0; i < remove_effects.size(); i++) {
 		int count = remove_effects[i].second;
 		bool remove_all = (count == 0 ? true : false);
@@ -557,7 +602,7 @@ void EffectManager::removeEffectID(const std::vector< std::pair<std::string, int
 			if (!remove_all && count <= 0)
 				break;
 
-			if (effect_list[j-1].id == remove_effects[i].first) {
+			if (effect_list[j-1].symbol == remove_effects[i].first) {
 				removeEffect(j-1);
 				count--;
 			}
@@ -571,6 +616,7 @@ void EffectManager::clearEffects() {
 	}
 
 	clearStatus();
+	calcBonuses();
 
 	// clear triggers
 	triggered_others = triggered_block = triggered_hit = triggered_halfdeath = triggered_joincombat = triggered_death = false;
@@ -675,14 +721,14 @@ void EffectManager::getCurrentAlpha(uint8_t& alpha_mod) {
 	}
 }
 
-bool EffectManager::hasEffect(const std::string& id, int req_count) {
+bool EffectManager::hasEffect(SymbolID id, int req_count) {
 	if (req_count <= 0)
 		return false;
 
 	int count = 0;
 
 	for (size_t i=effect_list.size(); i > 0; i--) {
-		if (effect_list[i-1].id == id)
+		if (effect_list[i-1].symbol == id)
 			count++;
 	}
 
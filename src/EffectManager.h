@@ -25,6 +25,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #define EFFECT_MANAGER_H
 
 #include "CommonIncludes.h"
+#include "SymbolTable.h"
 #include "Utils.h"
 
 class Animation;
@@ -78,6 +79,7 @@ public:
 	static bool isImmunityTypeString(const std::string& type_str); // handling of deprecated types
 
 	std::string id;
+	SymbolID symbol; // interned id
 	std::string name;
 	int icon;
 	Timer timer;
@@ -103,6 +105,7 @@ public:
 	EffectDef();
 
 	std::string id;
+	SymbolID symbol; // interned id
 	int type;
 	std::string name;
 	int icon;
@@ -134,15 +137,19 @@ class EffectManager {
 private:
 	void removeEffect(size_t id);
 	void clearStatus();
+	void calcBonuses();
+
+	// the effect list changed since the stat bonuses were last summed
+	bool bonus_dirty;
 
 public:
 	EffectManager();
 	~EffectManager();
 	void logic();
-	void addEffect(StatBlock* stats, EffectDef &effect, EffectParams &params);
+	void addEffect(StatBlock* stats, const EffectDef &effect, EffectParams &params);
 	void removeEffectType(const int type);
 	void removeEffectPassive(size_t id);
-	void removeEffectID(const std::vector< std::pair<std::string, int> >& remove_effects);
+	void removeEffectID(const std::vector< std::pair<SymbolID, int> >& remove_effects);
 	void clearEffects();
 	void clearNegativeEffects(int type);
 	void clearItemEffects();
@@ -151,7 +158,7 @@ public:
 	bool isDebuffed();
 	void getCurrentColor(Color& color_mod);
 	void getCurrentAlpha(uint8_t& alpha_mod);
-	bool hasEffect(const std::string& id, int req_count);
+	bool hasEffect(SymbolID id, int req_count);
 	float getAttackSpeed(const std::string& anim_name);
 	int getDamageSourceType(int dmg_mode);
 
@@ -177,6 +184,11 @@ public:
 	std::vector<float> bonus_multiplier;
 	std::vector<int> bonus_primary;
 
+	// indices of bonus/bonus_multiplier that changed since StatBlock last applied them
+	std::vector<size_t> bonus_changes;
+	std::vector<bool> bonus_changed;
+	void clearBonusChanges();
+
 	// TODO convert to array
 	bool triggered_others;
 	bool triggered_block;
@@ -67,57 +67,75 @@ EnemyGroupManager::EnemyGroupManager() {
 			_categories[cat].push_back(new_enemy);
 		}
 	}
+
+	// candidates for other level ranges are created when they are first needed
+	std::map<std::string, std::vector<Enemy_Level> >::const_iterator it;
+	for (it = _categories.begin(); it != _categories.end(); ++it) {
+		getCandidates(it->first, it->second, 0, 0);
+	}
 }
 
 EnemyGroupManager::~EnemyGroupManager() {
 }
 
-Enemy_Level EnemyGroupManager::getRandomEnemy(const std::string& category, int minlevel, int maxlevel) const {
-	std::vector<Enemy_Level> enemyCategory;
-	std::map<std::string, std::vector<Enemy_Level> >::const_iterator it = _categories.find(category);
-	if (it != _categories.end()) {
-		enemyCategory = it->second;
-	}
-	else {
-		Utils::logError("EnemyGroupManager: Could not find enemy category %s, returning empty enemy", category.c_str());
-		return Enemy_Level();
-	}
+/**
+ * Collect the enemies of a category that fit the level range, unless this has already been done
+ */
+const EnemyGroupManager::Candidates& EnemyGroupManager::getCandidates(const std::string& category, const std::vector<Enemy_Level>& enemies, int minlevel, int maxlevel) const {
+	std::map<std::pair<int, int>, Candidates>& ranges = _candidates[category];
+	std::pair<int, int> range(minlevel, maxlevel);
 
-	// load only the data that fit the criteria
-	std::vector<Enemy_Level> enemyCandidates;
-	for (size_t i = 0; i < enemyCategory.size(); ++i) {
-		Enemy_Level new_enemy = enemyCategory[i];
+	std::map<std::pair<int, int>, Candidates>::iterator it = ranges.find(range);
+	if (it != ranges.end())
+		return it->second;
+
+	Candidates& candidates = ranges[range];
+	std::vector<unsigned> weights;
+
+	for (size_t i = 0; i < enemies.size(); ++i) {
+		const Enemy_Level& new_enemy = enemies[i];
 		if ((new_enemy.level >= minlevel && new_enemy.level <= maxlevel) || (minlevel == 0 && maxlevel == 0)) {
-			// add more than one time to increase chance of getting
-			// this enemy as result, "rarity" property
-			int add_times = 0;
+			// weight the chance of getting this enemy as result by its "rarity" property
+			unsigned weight = 0;
 			if (new_enemy.rarity == "common") {
-				add_times = 6;
+				weight = 6;
 			}
 			else if (new_enemy.rarity == "uncommon") {
-				add_times = 3;
+				weight = 3;
 			}
 			else if (new_enemy.rarity == "rare") {
-				add_times = 1;
+				weight = 1;
 			}
 			else {
 				Utils::logError("EnemyGroupManager: 'rarity' property for enemy '%s' not valid (common|uncommon|rare): %s",
 						new_enemy.type.c_str(), new_enemy.rarity.c_str());
 			}
 
-			// do add, the given number of times
-			for (int j = 0; j < add_times; ++j) {
-				enemyCandidates.push_back(new_enemy);
-			}
+			candidates.enemies.push_back(i);
+			weights.push_back(weight);
 		}
 	}
 
-	if (enemyCandidates.empty()) {
+	candidates.sampler.build(weights);
+	return candidates;
+}
+
+Enemy_Level EnemyGroupManager::getRandomEnemy(const std::string& category, int minlevel, int maxlevel) const {
+	std::map<std::string, std::vector<Enemy_Level> >::const_iterator it = _categories.find(category);
+	if (it == _categories.end()) {
+		Utils::logError("EnemyGroupManager: Could not find enemy category %s, returning empty enemy", category.c_str());
+		return Enemy_Level();
+	}
+
+	// load only the data that fit the criteria
+	const Candidates& candidates = getCandidates(category, it->second, minlevel, maxlevel);
+
+	if (candidates.sampler.empty()) {
 		Utils::logError("EnemyGroupManager: Could not find a suitable enemy category for (%s, %d, %d)", category.c_str(), minlevel, maxlevel);
 		return Enemy_Level();
 	}
 	else {
-		return enemyCandidates[rand() % enemyCandidates.size()];
+		return it->second[candidates.enemies[candidates.sampler.pick()]];
 	}
 }
 
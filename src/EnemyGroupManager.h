@@ -20,6 +20,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #define ENEMYGROUPMANAGER_H
 
 #include "CommonIncludes.h"
+#include "WeightedSampler.h"
 
 class Enemy_Level {
 public:
@@ -63,9 +64,20 @@ public:
 	std::vector<Enemy_Level> getEnemiesInCategory(const std::string& category) const;
 
 private:
+	/** Enemies of a category that are in a level range, weighted by rarity */
+	class Candidates {
+	public:
+		std::vector<size_t> enemies; // indices into the category's enemy list
+		WeightedSampler sampler;
+	};
+
+	const Candidates& getCandidates(const std::string& category, const std::vector<Enemy_Level>& enemies, int minlevel, int maxlevel) const;
 
 	/** Container to store enemy data */
 	std::map <std::string, std::vector<Enemy_Level> > _categories;
+
+	/** Candidates for each category and level range that has been requested */
+	mutable std::map<std::string, std::map<std::pair<int, int>, Candidates> > _candidates;
 };
 
 #endif
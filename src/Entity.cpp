@@ -33,6 +33,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "EngineSettings.h"
 #include "Entity.h"
 #include "EntityBehavior.h"
+#include "EntityManager.h"
 #include "Hazard.h"
 #include "MapRenderer.h"
 #include "MessageEngine.h"
@@ -59,6 +60,12 @@ Entity::Entity()
 	, animationSet(NULL)
 	, stats()
 	, type_filename("")
+	, pool_handle()
+	, grid_cell(-1)
+	, grid_order(0)
+	, lod_skipped_frames(0)
+	, layers()
+	, layers_hash(0)
 {
 	// MSVC complains if you use 'this' in the init list
 	behavior = new EntityBehavior(this);
@@ -90,6 +97,13 @@ Entity& Entity::operator=(const Entity& e) {
 
 	type_filename = e.type_filename;
 
+	// copies are not part of the pool or the spatial grid until they are added to them
+	pool_handle = EntityHandle();
+	grid_cell = -1;
+	grid_order = 0;
+
+	lod_skipped_frames = 0;
+
 	behavior = new EntityBehavior(this);
 
 	return *this;
@@ -107,35 +121,36 @@ void Entity::loadSoundsFromStatBlock(StatBlock *src_stats) {
 	unloadSounds();
 
 	if (!src_stats) src_stats = &stats;
+	const StatTemplate& src_template = src_stats->getTemplate();
 
-	for (size_t i = 0; i < src_stats->sfx_attack.size(); ++i) {
-		std::string anim_name = src_stats->sfx_attack[i].first;
+	for (size_t i = 0; i < src_template.sfx_attack.size(); ++i) {
+		std::string anim_name = src_template.sfx_attack[i].first;
 		sound_attack.push_back(std::pair<std::string, std::vector<SoundID> >());
 		sound_attack.back().first = anim_name;
-		for (size_t j = 0; j  < src_stats->sfx_attack[i].second.size(); ++j) {
-			SoundID sid = snd->load(src_stats->sfx_attack[i].second[j], "Entity attack");
+		for (size_t j = 0; j  < src_template.sfx_attack[i].second.size(); ++j) {
+			SoundID sid = snd->load(src_template.sfx_attack[i].second[j], "Entity attack");
 			sound_attack.back().second.push_back(sid);
 		}
 	}
 
-	for (size_t i = 0; i < src_stats->sfx_hit.size(); ++i) {
-		sound_hit.push_back(snd->load(src_stats->sfx_hit[i], "Entity was hit"));
+	for (size_t i = 0; i < src_template.sfx_hit.size(); ++i) {
+		sound_hit.push_back(snd->load(src_template.sfx_hit[i], "Entity was hit"));
 	}
-	for (size_t i = 0; i < src_stats->sfx_die.size(); ++i) {
-		sound_die.push_back(snd->load(src_stats->sfx_die[i], "Entity died"));
+	for (size_t i = 0; i < src_template.sfx_die.size(); ++i) {
+		sound_die.push_back(snd->load(src_template.sfx_die[i], "Entity died"));
 	}
-	for (size_t i = 0; i < src_stats->sfx_critdie.size(); ++i) {
-		sound_critdie.push_back(snd->load(src_stats->sfx_critdie[i], "Entity died from critical hit"));
+	for (size_t i = 0; i < src_template.sfx_critdie.size(); ++i) {
+		sound_critdie.push_back(snd->load(src_template.sfx_critdie[i], "Entity died from critical hit"));
 	}
-	for (size_t i = 0; i < src_stats->sfx_block.size(); ++i) {
-		sound_block.push_back(snd->load(src_stats->sfx_block[i], "Entity blocked"));
+	for (size_t i = 0; i < src_template.sfx_block.size(); ++i) {
+		sound_block.push_back(snd->load(src_template.sfx_block[i], "Entity blocked"));
 	}
 
-	if (src_stats->sfx_levelup != "")
-		sound_levelup = snd->load(src_stats->sfx_levelup, "Entity leveled up");
+	if (src_template.sfx_levelup != "")
+		sound_levelup = snd->load(src_template.sfx_levelup, "Entity leveled up");
 
-	if (src_stats->sfx_lowhp != "")
-		sound_lowhp = snd->load(src_stats->sfx_lowhp, "Entity has low hp");
+	if (src_template.sfx_lowhp != "")
+		sound_lowhp = snd->load(src_template.sfx_lowhp, "Entity has low hp");
 }
 
 void Entity::unloadSounds() {
@@ -316,8 +331,8 @@ bool Entity::takeHit(Hazard &h) {
 	if(!powers->powers[h.power_index].target_categories.empty()) {
 		//the power has a target category requirement, so if it doesnt match, dont continue
 		bool match_found = false;
-		for (unsigned int i=0; i<stats.categories.size(); i++) {
-			if(std::find(powers->powers[h.power_index].target_categories.begin(), powers->powers[h.power_index].target_categories.end(), stats.categories[i]) != powers->powers[h.power_index].target_categories.end()) {
+		for (unsigned int i=0; i<stats.getTemplate().categories.size(); i++) {
+			if(std::find(powers->powers[h.power_index].target_categories.begin(), powers->powers[h.power_index].target_categories.end(), stats.getTemplate().categories[i]) != powers->powers[h.power_index].target_categories.end()) {
 				match_found = true;
 			}
 		}
@@ -326,7 +341,8 @@ bool Entity::takeHit(Hazard &h) {
 	}
 
 	// check if this entity allows attacks from this power id
-	if (!stats.power_filter.empty() && std::find(stats.power_filter.begin(), stats.power_filter.end(), h.power_index) == stats.power_filter.end()) {
+	const std::vector<PowerID>& power_filter = stats.getTemplate().power_filter;
+	if (!power_filter.empty() && std::find(power_filter.begin(), power_filter.end(), h.power_index) == power_filter.end()) {
 		return false;
 	}
 
@@ -377,7 +393,7 @@ bool Entity::takeHit(Hazard &h) {
 		// reset the hazard ticks
 		h.lifespan = h.power->lifespan;
 
-		if (activeAnimation->getName() == "block") {
+		if (activeAnimation->getID() == SymbolTable::ANIM_BLOCK) {
 			playSound(Entity::SOUND_BLOCK);
 		}
 
@@ -469,7 +485,7 @@ bool Entity::takeHit(Hazard &h) {
 				else {
 					if (eset->combat.max_resist < 100) dmg = 1;
 				}
-				if (activeAnimation->getName() == "block") {
+				if (activeAnimation->getID() == SymbolTable::ANIM_BLOCK) {
 					playSound(Entity::SOUND_BLOCK);
 					resetActiveAnimation();
 				}
@@ -684,27 +700,32 @@ void Entity::resetActiveAnimation() {
 /**
  * Set the entity's current animation by name
  */
-void Entity::setAnimation(const std::string& animationName) {
+void Entity::setAnimation(SymbolID animation) {
 
 	// if the animation is already the requested one do nothing
-	if (activeAnimation != NULL && activeAnimation->getName() == animationName)
+	if (activeAnimation != NULL && activeAnimation->getID() == animation)
 		return;
 
 	if (!animationSet)
 		return;
 
-	delete activeAnimation;
-	activeAnimation = animationSet->getAnimation(animationName);
-
-	if (!activeAnimation)
-		Utils::logError("Entity::setAnimation(%s): not found", animationName.c_str());
+	// reuse the existing playheads instead of allocating new ones
+	if (activeAnimation)
+		activeAnimation->setDef(animationSet->getAnimationDef(animation));
+	else
+		activeAnimation = animationSet->getAnimation(animation);
 
 	for (size_t i = 0; i < animsets.size(); ++i) {
-		delete anims[i];
-		if (animsets[i])
-			anims[i] = animsets[i]->getAnimation(animationName);
-		else
+		if (!animsets[i]) {
+			delete anims[i];
 			anims[i] = NULL;
+		}
+		else if (anims[i]) {
+			anims[i]->setDef(animsets[i]->getAnimationDef(animation));
+		}
+		else {
+			anims[i] = animsets[i]->getAnimation(animation);
+		}
 	}
 }
 
@@ -747,11 +768,12 @@ Rect Entity::getRenderBounds(const FPoint& cam) const {
 	Rect r;
 	Point p = Utils::mapToScreen(stats.pos.x, stats.pos.y, cam.x, cam.y);
 
-	if (!stats.layer_reference_order.empty()) {
+	if (!stats.getTemplate().layer_reference_order.empty()) {
+		const std::vector<unsigned>& layer_order = stats.getTemplate().layer_def[stats.direction];
 		Point top_left, bottom_right;
 		bool point_init = false;
-		for (unsigned i = 0; i < stats.layer_def[stats.direction].size(); ++i) {
-			unsigned index = stats.layer_def[stats.direction][i];
+		for (unsigned i = 0; i < layer_order.size(); ++i) {
+			unsigned index = layer_order[i];
 			if (anims[index]) {
 				Renderable ren = anims[index]->getCurrentFrame(stats.direction);
 				if (!point_init) {
@@ -797,29 +819,74 @@ Rect Entity::getRenderBounds(const FPoint& cam) const {
 	return r;
 }
 
-void Entity::addRenders(std::vector<Renderable> &r) {
-	if (!stats.layer_reference_order.empty()) {
-		for (unsigned i = 0; i < stats.layer_def[stats.direction].size(); ++i) {
-			unsigned index = stats.layer_def[stats.direction][i];
-			if (anims[index]) {
-				Renderable ren = anims[index]->getCurrentFrame(stats.direction);
-				ren.map_pos = stats.pos;
-				ren.prio = i+1;
+/**
+ * Apply effect colors, corpse fading and the renderable type to one of this entity's renderables
+ */
+void Entity::setRenderableEffects(Renderable& ren) {
+	stats.effects.getCurrentColor(ren.color_mod);
+	stats.effects.getCurrentAlpha(ren.alpha_mod);
+
+	// fade out corpses
+	if (!stats.hero && stats.corpse) {
+		unsigned fade_time = (eset->misc.corpse_timeout > settings->max_frames_per_sec) ? settings->max_frames_per_sec : eset->misc.corpse_timeout;
+		if (fade_time != 0 && stats.corpse_timer.getCurrent() <= fade_time) {
+			ren.alpha_mod = static_cast<uint8_t>(static_cast<float>(stats.corpse_timer.getCurrent()) * (ren.alpha_mod / static_cast<float>(fade_time)));
+		}
+	}
 
-				stats.effects.getCurrentColor(ren.color_mod);
-				stats.effects.getCurrentAlpha(ren.alpha_mod);
+	ren.type = getRenderableType();
+}
 
-				// fade out corpses
-				if (!stats.hero && stats.corpse) {
-					unsigned fade_time = (eset->misc.corpse_timeout > settings->max_frames_per_sec) ? settings->max_frames_per_sec : eset->misc.corpse_timeout;
-					if (fade_time != 0 && stats.corpse_timer.getCurrent() <= fade_time) {
-						ren.alpha_mod = static_cast<uint8_t>(static_cast<float>(stats.corpse_timer.getCurrent()) * (ren.alpha_mod / static_cast<float>(fade_time)));
-					}
-				}
+/**
+ * Draw all of the animation layers as one image from the layer cache.
+ * Returns false if the layers need to be drawn separately.
+ */
+bool Entity::addCompositeRender(std::vector<Renderable> &r) {
+	if (!settings->composite_layers || !entitym || !activeAnimation)
+		return false;
+
+	RenderLayerCache::Key key;
+	key.layers_hash = layers_hash;
+	key.animation = activeAnimation->getID();
+	key.frame = activeAnimation->getCurrentFrameIndex();
+	key.direction = stats.direction;
+
+	Renderable ren;
+	if (!entitym->layer_cache.get(key, layers, ren)) {
+		const std::vector<unsigned>& layer_order = stats.getTemplate().layer_def[stats.direction];
+		std::vector<Renderable> layer_renders;
+		for (unsigned i = 0; i < layer_order.size(); ++i) {
+			unsigned index = layer_order[i];
+			if (anims[index])
+				layer_renders.push_back(anims[index]->getCurrentFrame(stats.direction));
+		}
+
+		if (!entitym->layer_cache.store(key, layers, layer_renders, ren))
+			return false;
+	}
 
-				ren.type = getRenderableType();
+	ren.map_pos = stats.pos;
+	ren.prio = 1;
+	setRenderableEffects(ren);
 
-				r.push_back(ren);
+	r.push_back(ren);
+	return true;
+}
+
+void Entity::addRenders(std::vector<Renderable> &r) {
+	if (!stats.getTemplate().layer_reference_order.empty()) {
+		if (!addCompositeRender(r)) {
+			const std::vector<unsigned>& layer_order = stats.getTemplate().layer_def[stats.direction];
+			for (unsigned i = 0; i < layer_order.size(); ++i) {
+				unsigned index = layer_order[i];
+				if (anims[index]) {
+					Renderable ren = anims[index]->getCurrentFrame(stats.direction);
+					ren.map_pos = stats.pos;
+					ren.prio = i+1;
+					setRenderableEffects(ren);
+
+					r.push_back(ren);
+				}
 			}
 		}
 	}
@@ -829,19 +896,7 @@ void Entity::addRenders(std::vector<Renderable> &r) {
 			ren = activeAnimation->getCurrentFrame(stats.direction);
 		ren.map_pos = stats.pos;
 		ren.prio = 1;
-
-		stats.effects.getCurrentColor(ren.color_mod);
-		stats.effects.getCurrentAlpha(ren.alpha_mod);
-
-		// fade out corpses
-		if (!stats.hero && stats.corpse) {
-			unsigned fade_time = (eset->misc.corpse_timeout > settings->max_frames_per_sec) ? settings->max_frames_per_sec : eset->misc.corpse_timeout;
-			if (fade_time != 0 && stats.corpse_timer.getCurrent() <= fade_time) {
-				ren.alpha_mod = static_cast<uint8_t>(static_cast<float>(stats.corpse_timer.getCurrent()) * (ren.alpha_mod / static_cast<float>(fade_time)));
-			}
-		}
-
-		ren.type = getRenderableType();
+		setRenderableEffects(ren);
 
 		r.push_back(ren);
 	}
@@ -852,8 +907,8 @@ void Entity::addRenders(std::vector<Renderable> &r) {
 			Renderable ren = stats.effects.effect_list[i].animation->getCurrentFrame(0);
 			ren.map_pos = stats.pos;
 			if (stats.effects.effect_list[i].render_above) {
-				if (!stats.layer_reference_order.empty())
-					ren.prio = stats.layer_def[stats.direction].size()+1;
+				if (!stats.getTemplate().layer_reference_order.empty())
+					ren.prio = stats.getTemplate().layer_def[stats.direction].size()+1;
 				else
 					ren.prio = 2;
 			}
@@ -900,13 +955,13 @@ void Entity::loadAnimations() {
 
 	std::vector<Entity::Layer_gfx> img_gfx;
 
-	for (size_t i = 0; i < stats.layer_reference_order.size(); ++i) {
+	for (size_t i = 0; i < stats.getTemplate().layer_reference_order.size(); ++i) {
 		Entity::Layer_gfx gfx;
-		gfx.type = stats.layer_reference_order[i];
+		gfx.type = stats.getTemplate().layer_reference_order[i];
 		gfx.gfx = getGfxFromType(gfx.type);
 		img_gfx.push_back(gfx);
 	}
-	assert(stats.layer_reference_order.size() == img_gfx.size());
+	assert(stats.getTemplate().layer_reference_order.size() == img_gfx.size());
 
 	for (size_t i = 0; i < img_gfx.size(); ++i) {
 		if (img_gfx[i].gfx != "") {
@@ -919,8 +974,8 @@ void Entity::loadAnimations() {
 			anim->increaseCount(name);
 			animsets.push_back(anim->getAnimationSet(name));
 			animsets.back()->setParent(animationSet);
-			anims.push_back(animsets.back()->getAnimation(activeAnimation->getName()));
-			setAnimation("stance");
+			anims.push_back(animsets.back()->getAnimation(activeAnimation->getID()));
+			setAnimation(SymbolTable::ANIM_STANCE);
 			if(!anims.back()->syncTo(activeAnimation)) {
 				Utils::logError("Entity: Error syncing animation in '%s' to parent animation.", animsets.back()->getName().c_str());
 			}
@@ -932,20 +987,37 @@ void Entity::loadAnimations() {
 	}
 	anim->cleanUp();
 
+	// part of the key for composited layer images in RenderLayerCache
+	// the animation sets are followed by the layer order of each direction, with each order preceded by its size
+	layers.clear();
+	layers.push_back(animationSet ? symbols->find(animationSet->getName()) : static_cast<SymbolID>(SymbolTable::NONE));
+	for (size_t i = 0; i < animsets.size(); ++i) {
+		layers.push_back(animsets[i] ? symbols->find(animsets[i]->getName()) : static_cast<SymbolID>(SymbolTable::NONE));
+	}
+	const std::vector<std::vector<unsigned> >& layer_def = stats.getTemplate().layer_def;
+	for (size_t i = 0; i < layer_def.size(); ++i) {
+		layers.push_back(static_cast<unsigned>(layer_def[i].size()));
+		layers.insert(layers.end(), layer_def[i].begin(), layer_def[i].end());
+	}
+
+	layers_hash = 5381;
+	for (size_t i = 0; i < layers.size(); ++i) {
+		layers_hash = layers_hash * 33 + layers[i];
+	}
+
 	stats.critdie_enabled = false;
 	if (animationSet) {
-		Animation* critdie_anim = animationSet->getAnimation("critdie");
+		const AnimationDef* critdie_anim = animationSet->getAnimationDef(SymbolTable::ANIM_CRITDIE);
 		if (critdie_anim) {
-			stats.critdie_enabled = (critdie_anim->getName() == "critdie");
-			delete critdie_anim;
+			stats.critdie_enabled = (critdie_anim->getID() == SymbolTable::ANIM_CRITDIE);
 		}
 	}
 }
 
 std::string Entity::getGfxFromType(const std::string& gfx_type) {
-	std::map<std::string, std::string>::iterator it;
-	it = stats.animation_slots.find(gfx_type);
-	if (it != stats.animation_slots.end())
+	const std::map<std::string, std::string>& animation_slots = stats.getTemplate().animation_slots;
+	std::map<std::string, std::string>::const_iterator it = animation_slots.find(gfx_type);
+	if (it != animation_slots.end())
 		return it->second;
 
 	return "";
@@ -28,7 +28,9 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #define ENTITY_H
 
 #include "CommonIncludes.h"
+#include "EntityPool.h"
 #include "StatBlock.h"
+#include "SymbolTable.h"
 #include "Utils.h"
 
 class Animation;
@@ -42,6 +44,8 @@ protected:
 	void move_from_offending_tile();
 	void resetActiveAnimation();
 	uint8_t getRenderableType();
+	void setRenderableEffects(Renderable& ren);
+	bool addCompositeRender(std::vector<Renderable> &r);
 
 public:
 	class Layer_gfx {
@@ -80,7 +84,7 @@ public:
 	SoundID sound_levelup;
 	SoundID sound_lowhp;
 
-	void setAnimation(const std::string& animation);
+	void setAnimation(SymbolID animation);
 	Animation *activeAnimation;
 	AnimationSet *animationSet;
 	std::vector<AnimationSet*> animsets; // hold the animations for all equipped items in the right order of drawing.
@@ -95,6 +99,21 @@ public:
 
 	EntityBehavior *behavior;
 
+	// slot in EntityManager's entity pool, managed by EntityPool. Null for entities that aren't pooled, such as NPCs
+	EntityHandle pool_handle;
+
+	// bucket and list index in EntityManager's spatial grid, managed by EntityGrid
+	int grid_cell;
+	size_t grid_order;
+
+	// frames of logic that were skipped by EntityManager's level-of-detail scheduling
+	unsigned lod_skipped_frames;
+
+	// identifies the loaded animation layers for RenderLayerCache, set by loadAnimations()
+	// the hash is checked first, and the full list is compared to confirm a match
+	std::vector<unsigned> layers;
+	unsigned long layers_hash;
+
 	void loadAnimations();
 	virtual std::string getGfxFromType(const std::string& gfx_type);
 	void addRenders(std::vector<Renderable> &r);
@@ -42,13 +42,27 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "StatBlock.h"
 #include "UtilsMath.h"
 
+#include <limits>
+
 const float EntityBehavior::ALLY_FLEE_DISTANCE = 2;
 const float EntityBehavior::ALLY_FOLLOW_DISTANCE_WALK = 5.5;
 const float EntityBehavior::ALLY_FOLLOW_DISTANCE_STOP = 5;
 const float EntityBehavior::ALLY_TELEPORT_DISTANCE = 40;
 
+EntityBehavior::Decision::Decision()
+	: valid(false)
+	, pos()
+	, hero_ally(false)
+	, target_stats(NULL)
+	, target_dist(0)
+	, first_target(false)
+	, los(false)
+{
+}
+
 EntityBehavior::EntityBehavior(Entity *_e)
-	: e(_e)
+	: decision()
+	, e(_e)
 	, path()
 	, prev_target()
 	, collided(false)
@@ -56,6 +70,7 @@ EntityBehavior::EntityBehavior(Entity *_e)
 	, chance_calc_path(0)
 	, path_found_fails(0)
 	, path_found_fail_timer()
+	, path_ticket(PathService::NO_TICKET)
 	, target_dist(0)
 	, hero_dist(0)
 	, pursue_pos(-1, -1)
@@ -124,6 +139,90 @@ void EntityBehavior::doUpkeep() {
 	}
 }
 
+/**
+ * Used when searching for AI targets. data is the entity that is searching.
+ */
+bool EntityBehavior::isTargetable(const Entity* entity, const void* data) {
+	const Entity* e = static_cast<const Entity*>(data);
+
+	if (!entity->stats.alive)
+		return false;
+
+	return (!e->stats.hero_ally && entity->stats.hero_ally) || (e->stats.hero_ally && !entity->stats.hero_ally && entity->stats.in_combat);
+}
+
+/**
+ * Pick a target among other entities, starting from the hero (or no target) in target_stats/dist.
+ * Enemies only switch from the hero to a closer ally; allies go after the nearest enemy that is in combat.
+ * first_target is set if the entity had no target to compare against and should enter combat.
+ * This doesn't change any state, so it is safe to call from decide().
+ */
+void EntityBehavior::selectTarget(StatBlock*& target_stats, float& dist, bool& first_target) const {
+	first_target = false;
+
+	float search_range = (target_stats && !e->stats.hero_ally) ? dist : std::numeric_limits<float>::max();
+	std::vector<Entity*> nearest;
+	entitym->grid.getNearest(e->stats.pos, search_range, 1, isTargetable, e, nearest);
+
+	if (nearest.empty())
+		return;
+
+	float entity_dist = Utils::calcDist(e->stats.pos, nearest[0]->stats.pos);
+	if (!target_stats || (e->stats.hero_ally && target_stats->hero)) {
+		// pick the first available target if none is already selected
+		target_stats = &nearest[0]->stats;
+		dist = entity_dist;
+		first_target = true;
+	}
+	else if (entity_dist < dist) {
+		// pick a new target if it's closer
+		target_stats = &nearest[0]->stats;
+		dist = entity_dist;
+	}
+}
+
+/**
+ * The read-only part of targeting: picking a target and checking line-of-sight to it.
+ * EntityManager runs this for all entities on worker threads before any of them run logic(),
+ * so it must not change anything outside of this->decision.
+ */
+void EntityBehavior::decide() {
+	decision.valid = false;
+
+	// these entities won't get to findTarget()
+	if (e->stats.corpse || (!e->stats.hero_ally && !e->stats.encountered))
+		return;
+	if (e->stats.cur_state == StatBlock::ENTITY_DEAD || e->stats.cur_state == StatBlock::ENTITY_CRITDEAD)
+		return;
+	if ((e->stats.npc && !e->stats.hero_ally) || e->stats.effects.stun)
+		return;
+
+	StatBlock* target_stats = NULL;
+	float dist = 0;
+	if (pc->stats.alive) {
+		dist = Utils::calcDist(e->stats.pos, pc->stats.pos);
+		target_stats = &pc->stats;
+	}
+
+	// findTarget() will move this ally to the hero first
+	if (e->stats.hero_ally && dist > ALLY_TELEPORT_DISTANCE && !e->stats.in_combat)
+		return;
+
+	bool first_target = false;
+	selectTarget(target_stats, dist, first_target);
+
+	decision.los = false;
+	if (target_stats && dist < e->stats.threat_range && pc->stats.alive)
+		decision.los = mapr->collider.uncachedLineOfSight(e->stats.pos.x, e->stats.pos.y, target_stats->pos.x, target_stats->pos.y);
+
+	decision.pos = e->stats.pos;
+	decision.hero_ally = e->stats.hero_ally;
+	decision.target_stats = target_stats;
+	decision.target_dist = dist;
+	decision.first_target = first_target;
+	decision.valid = true;
+}
+
 /**
  * Locate the player and set various targeting info
  */
@@ -161,30 +260,27 @@ void EntityBehavior::findTarget() {
 	}
 
 	// AI can target other AI
-	for (size_t i = 0; i < entitym->entities.size(); ++i) {
-		Entity* entity = entitym->entities[i];
-		if (!entity->stats.alive)
-			continue;
-
-		if ((!e->stats.hero_ally && entity->stats.hero_ally) || (e->stats.hero_ally && !entity->stats.hero_ally && entity->stats.in_combat)) {
-			float entity_dist = Utils::calcDist(e->stats.pos, entity->stats.pos);
-			if (!target_stats || (e->stats.hero_ally && target_stats->hero)) {
-				// pick the first available target if none is already selected
-				target_stats = &entitym->entities[i]->stats;
-				target_dist = entity_dist;
-				e->stats.in_combat = true;
-			}
-			else if (entity_dist < target_dist) {
-				// pick a new target if it's closer
-				target_stats = &entitym->entities[i]->stats;
-				target_dist = entity_dist;
-			}
-		}
+	// the target picked by decide() is used unless something changed since then
+	bool first_target = false;
+	bool use_decision = decision.valid && decision.pos.x == e->stats.pos.x && decision.pos.y == e->stats.pos.y && decision.hero_ally == e->stats.hero_ally && (!decision.target_stats || decision.target_stats->alive);
+	if (use_decision) {
+		target_stats = decision.target_stats;
+		first_target = decision.first_target;
+
+		// the target may have moved during its own logic
+		target_dist = target_stats ? Utils::calcDist(e->stats.pos, target_stats->pos) : decision.target_dist;
 	}
+	else {
+		selectTarget(target_stats, target_dist, first_target);
+	}
+	decision.valid = false;
+
+	if (first_target)
+		e->stats.in_combat = true;
 
 	// check line-of-sight
 	if (target_stats && target_dist < e->stats.threat_range && pc->stats.alive)
-		los = mapr->collider.lineOfSight(e->stats.pos.x, e->stats.pos.y, target_stats->pos.x, target_stats->pos.y);
+		los = use_decision ? decision.los : mapr->collider.lineOfSight(e->stats.pos.x, e->stats.pos.y, target_stats->pos.x, target_stats->pos.y);
 	else
 		los = false;
 
@@ -429,6 +525,23 @@ void EntityBehavior::checkMove() {
 
 	path_found_fail_timer.tick();
 
+	// pick up a path that was requested on a previous frame
+	if (path_ticket != PathService::NO_TICKET && entitym->path_service.getResult(path_ticket, path, path_found)) {
+		path_ticket = PathService::NO_TICKET;
+
+		if (!path_found) {
+			path_found_fails++;
+			if (path_found_fails >= PATH_FOUND_FAIL_THRESHOLD) {
+				// could not find a path after several tries, so wait a little before the next attempt
+				path_found_fail_timer.reset(Timer::BEGIN);
+			}
+		}
+		else {
+			path_found_fails = 0;
+			path_found_fail_timer.reset(Timer::END);
+		}
+	}
+
 	// update direction
 	if (e->stats.facing) {
 		turn_timer.tick();
@@ -477,22 +590,18 @@ void EntityBehavior::checkMove() {
 
 				prev_target = pursue_pos;
 
-				// target first waypoint
+				// request a new path; the old one is followed until the result arrives
 				if (recalculate_path) {
 					chance_calc_path = -100;
-					path.clear();
-					path_found = mapr->collider.computePath(e->stats.pos, pursue_pos, path, e->stats.movement_type, MapCollision::DEFAULT_PATH_LIMIT);
-
-					if (!path_found) {
-						path_found_fails++;
-						if (path_found_fails >= PATH_FOUND_FAIL_THRESHOLD) {
-							// could not find a path after several tries, so wait a little before the next attempt
-							path_found_fail_timer.reset(Timer::BEGIN);
-						}
-					}
-					else {
-						path_found_fails = 0;
-						path_found_fail_timer.reset(Timer::END);
+
+					if (path_ticket == PathService::NO_TICKET) {
+						int priority = PathService::PRIORITY_LOW;
+						if (e->stats.in_combat)
+							priority = PathService::PRIORITY_HIGH;
+						else if (e->stats.hero_ally)
+							priority = PathService::PRIORITY_NORMAL;
+
+						path_ticket = entitym->path_service.request(e->stats.pos, pursue_pos, e->stats.movement_type, priority);
 					}
 				}
 
@@ -506,6 +615,8 @@ void EntityBehavior::checkMove() {
 			}
 			else {
 				path.clear();
+				entitym->path_service.cancel(path_ticket);
+				path_ticket = PathService::NO_TICKET;
 			}
 
 			if (e->stats.charge_speed == 0.0f) {
@@ -674,12 +785,12 @@ void EntityBehavior::updateState() {
 
 		case StatBlock::ENTITY_STANCE:
 
-			e->setAnimation("stance");
+			e->setAnimation(SymbolTable::ANIM_STANCE);
 			break;
 
 		case StatBlock::ENTITY_MOVE:
 
-			e->setAnimation("run");
+			e->setAnimation(SymbolTable::ANIM_RUN);
 			break;
 
 		case StatBlock::ENTITY_POWER:
@@ -697,7 +808,7 @@ void EntityBehavior::updateState() {
 			if (power_state == Power::STATE_INSTANT)
 				instant_power = true;
 			else if (power_state == Power::STATE_ATTACK)
-				e->setAnimation(powers->powers[power_id].attack_anim);
+				e->setAnimation(powers->powers[power_id].attack_anim_id);
 
 			// sound effect based on power type
 			if (e->activeAnimation->isFirstFrame()) {
@@ -738,7 +849,7 @@ void EntityBehavior::updateState() {
 			}
 
 			// animation is finished
-			if ((e->activeAnimation->isLastFrame() && e->stats.state_timer.isEnd()) || (power_state == Power::STATE_ATTACK && e->activeAnimation->getName() != powers->powers[power_id].attack_anim) || instant_power) {
+			if ((e->activeAnimation->isLastFrame() && e->stats.state_timer.isEnd()) || (power_state == Power::STATE_ATTACK && e->activeAnimation->getID() != powers->powers[power_id].attack_anim_id) || instant_power) {
 				if (!instant_power)
 					e->stats.cooldown.reset(Timer::BEGIN);
 				else
@@ -754,32 +865,32 @@ void EntityBehavior::updateState() {
 
 		case StatBlock::ENTITY_SPAWN:
 
-			e->setAnimation("spawn");
+			e->setAnimation(SymbolTable::ANIM_SPAWN);
 			//the second check is needed in case the entity does not have a spawn animation
-			if (e->activeAnimation->isLastFrame() || e->activeAnimation->getName() != "spawn") {
+			if (e->activeAnimation->isLastFrame() || e->activeAnimation->getID() != SymbolTable::ANIM_SPAWN) {
 				e->stats.cur_state = StatBlock::ENTITY_STANCE;
 			}
 			break;
 
 		case StatBlock::ENTITY_BLOCK:
 
-			e->setAnimation("block");
+			e->setAnimation(SymbolTable::ANIM_BLOCK);
 			break;
 
 		case StatBlock::ENTITY_HIT:
 
-			e->setAnimation("hit");
+			e->setAnimation(SymbolTable::ANIM_HIT);
 			if (e->activeAnimation->isFirstFrame()) {
 				e->stats.effects.triggered_hit = true;
 			}
-			if (e->activeAnimation->isLastFrame() || e->activeAnimation->getName() != "hit")
+			if (e->activeAnimation->isLastFrame() || e->activeAnimation->getID() != SymbolTable::ANIM_HIT)
 				e->stats.cur_state = StatBlock::ENTITY_STANCE;
 			break;
 
 		case StatBlock::ENTITY_DEAD:
 			if (e->stats.effects.triggered_death) break;
 
-			e->setAnimation("die");
+			e->setAnimation(SymbolTable::ANIM_DIE);
 			if (e->activeAnimation->isFirstFrame()) {
 				e->playSound(Entity::SOUND_DIE);
 				e->stats.corpse_timer.setDuration(eset->misc.corpse_timeout);
@@ -791,7 +902,7 @@ void EntityBehavior::updateState() {
 
 				e->stats.effects.clearEffects();
 			}
-			if (e->activeAnimation->isLastFrame() || e->activeAnimation->getName() != "die") {
+			if (e->activeAnimation->isLastFrame() || e->activeAnimation->getID() != SymbolTable::ANIM_DIE) {
 				// puts renderable under object layer
 				e->stats.corpse = true;
 
@@ -811,7 +922,7 @@ void EntityBehavior::updateState() {
 
 		case StatBlock::ENTITY_CRITDEAD:
 
-			e->setAnimation("critdie");
+			e->setAnimation(SymbolTable::ANIM_CRITDIE);
 			if (e->activeAnimation->isFirstFrame()) {
 				e->playSound(Entity::SOUND_CRITDIE);
 				e->stats.corpse_timer.setDuration(eset->misc.corpse_timeout);
@@ -823,7 +934,7 @@ void EntityBehavior::updateState() {
 
 				e->stats.effects.clearEffects();
 			}
-			if (e->activeAnimation->isLastFrame() || e->activeAnimation->getName() != "critdie") {
+			if (e->activeAnimation->isLastFrame() || e->activeAnimation->getID() != SymbolTable::ANIM_CRITDIE) {
 				// puts renderable under object layer
 				e->stats.corpse = true;
 
@@ -31,9 +31,24 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #define ENTITY_BEHAVIOR_H
 
 class Entity;
+class StatBlock;
 
 class EntityBehavior {
 private:
+	// targeting result from decide()
+	class Decision {
+	public:
+		bool valid;
+		FPoint pos;
+		bool hero_ally;
+		StatBlock* target_stats;
+		float target_dist;
+		bool first_target;
+		bool los;
+
+		Decision();
+	};
+
 	static const float ALLY_FLEE_DISTANCE;
 	static const float ALLY_FOLLOW_DISTANCE_WALK;
 	static const float ALLY_FOLLOW_DISTANCE_STOP;
@@ -48,6 +63,11 @@ private:
 	void checkMoveStateMove();
 	void updateState();
 	FPoint getWanderPoint();
+	void selectTarget(StatBlock*& target_stats, float& dist, bool& first_target) const;
+
+	static bool isTargetable(const Entity* entity, const void* data);
+
+	Decision decision;
 
 protected:
 	Entity *e;
@@ -63,6 +83,7 @@ protected:
 	int chance_calc_path;
 	int path_found_fails;
 	Timer path_found_fail_timer;
+	unsigned long path_ticket;
 
 	float target_dist;
 	float hero_dist;
@@ -79,6 +100,7 @@ protected:
 public:
 	explicit EntityBehavior(Entity *_e);
 	~EntityBehavior();
+	void decide();
 	void logic();
 };
 
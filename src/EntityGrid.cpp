@@ -0,0 +1,284 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class EntityGrid
+ *
+ * Buckets entities into square cells of map tiles so that proximity queries only
+ * look at nearby entities. An entity is only moved between buckets when its
+ * position crosses into another cell.
+ * Unless noted otherwise, query results are returned in the same order as the
+ * EntityManager's entity list.
+ */
+
+#include "Entity.h"
+#include "EntityGrid.h"
+
+EntityGrid::EntityGrid()
+	: cells()
+	, cols(1)
+	, rows(1)
+{
+	cells.resize(1);
+}
+
+EntityGrid::~EntityGrid() {
+}
+
+/**
+ * Resize the grid to cover a map. The grid should be empty (see clear()) before calling this.
+ */
+void EntityGrid::init(int map_w, int map_h) {
+	cols = std::max((map_w + CELL_SIZE - 1) / CELL_SIZE, 1);
+	rows = std::max((map_h + CELL_SIZE - 1) / CELL_SIZE, 1);
+
+	cells.clear();
+	cells.resize(cols * rows);
+}
+
+/**
+ * Remove all entities from the grid
+ */
+void EntityGrid::clear() {
+	for (size_t i = 0; i < cells.size(); ++i) {
+		for (size_t j = 0; j < cells[i].size(); ++j) {
+			cells[i][j]->grid_cell = -1;
+		}
+		cells[i].clear();
+	}
+}
+
+/**
+ * Add new entities and move any that changed cells. Also records each entity's
+ * list index, which is used to keep query results in list order.
+ * Entities that are removed from the list must be removed from the grid with remove().
+ */
+void EntityGrid::sync(const std::vector<Entity*>& entities) {
+	for (size_t i = 0; i < entities.size(); ++i) {
+		entities[i]->grid_order = i;
+		update(entities[i]);
+	}
+}
+
+void EntityGrid::update(Entity* e) {
+	int cell = getCellY(e->stats.pos.y) * cols + getCellX(e->stats.pos.x);
+	if (cell == e->grid_cell)
+		return;
+
+	remove(e);
+
+	cells[cell].push_back(e);
+	e->grid_cell = cell;
+}
+
+void EntityGrid::remove(Entity* e) {
+	if (e->grid_cell < 0)
+		return;
+
+	std::vector<Entity*>& bucket = cells[e->grid_cell];
+	for (size_t i = 0; i < bucket.size(); ++i) {
+		if (bucket[i] == e) {
+			bucket[i] = bucket.back();
+			bucket.pop_back();
+			break;
+		}
+	}
+
+	e->grid_cell = -1;
+}
+
+/**
+ * Positions outside of the map are placed in the nearest edge cell
+ */
+int EntityGrid::getCellX(float x) {
+	if (x < 0)
+		return 0;
+	return std::min(static_cast<int>(x) / CELL_SIZE, cols - 1);
+}
+
+int EntityGrid::getCellY(float y) {
+	if (y < 0)
+		return 0;
+	return std::min(static_cast<int>(y) / CELL_SIZE, rows - 1);
+}
+
+bool EntityGrid::compareOrder(const Entity* a, const Entity* b) {
+	return a->grid_order < b->grid_order;
+}
+
+bool EntityGrid::compareCandidates(const Candidate& a, const Candidate& b) {
+	if (a.distance != b.distance)
+		return a.distance < b.distance;
+	return a.order < b.order;
+}
+
+/**
+ * Get all entities that are closer than radius to pos
+ */
+void EntityGrid::getInRadius(const FPoint& pos, float radius, std::vector<Entity*>& result) {
+	result.clear();
+
+	int x1 = getCellX(pos.x - radius);
+	int y1 = getCellY(pos.y - radius);
+	int x2 = getCellX(pos.x + radius);
+	int y2 = getCellY(pos.y + radius);
+
+	for (int y = y1; y <= y2; ++y) {
+		for (int x = x1; x <= x2; ++x) {
+			const std::vector<Entity*>& bucket = cells[y * cols + x];
+			for (size_t i = 0; i < bucket.size(); ++i) {
+				if (Utils::isWithinRadius(pos, radius, bucket[i]->stats.pos))
+					result.push_back(bucket[i]);
+			}
+		}
+	}
+
+	std::sort(result.begin(), result.end(), compareOrder);
+}
+
+/**
+ * Get all entities that are closer than radius to the line segment from start to end,
+ * i.e. everything touched by a circle moving from start to end.
+ * Entities are returned in the order that the circle reaches them.
+ */
+void EntityGrid::getInSweptRadius(const FPoint& start, const FPoint& end, float radius, std::vector<Entity*>& result) {
+	result.clear();
+
+	int x1 = getCellX(std::min(start.x, end.x) - radius);
+	int y1 = getCellY(std::min(start.y, end.y) - radius);
+	int x2 = getCellX(std::max(start.x, end.x) + radius);
+	int y2 = getCellY(std::max(start.y, end.y) + radius);
+
+	std::vector<Candidate> candidates;
+
+	for (int y = y1; y <= y2; ++y) {
+		for (int x = x1; x <= x2; ++x) {
+			const std::vector<Entity*>& bucket = cells[y * cols + x];
+			for (size_t i = 0; i < bucket.size(); ++i) {
+				FPoint closest = Utils::calcClosestPointOnSegment(start, end, bucket[i]->stats.pos);
+				if (!Utils::isWithinRadius(closest, radius, bucket[i]->stats.pos))
+					continue;
+
+				Candidate c;
+				c.entity = bucket[i];
+				c.distance = Utils::calcDist(start, closest);
+				c.order = bucket[i]->grid_order;
+				candidates.push_back(c);
+			}
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end(), compareCandidates);
+
+	for (size_t i = 0; i < candidates.size(); ++i) {
+		result.push_back(candidates[i].entity);
+	}
+}
+
+/**
+ * Get all entities inside the rectangle spanned by top_left and bottom_right (inclusive)
+ */
+void EntityGrid::getInArea(const FPoint& top_left, const FPoint& bottom_right, std::vector<Entity*>& result) {
+	result.clear();
+
+	int x1 = getCellX(top_left.x);
+	int y1 = getCellY(top_left.y);
+	int x2 = getCellX(bottom_right.x);
+	int y2 = getCellY(bottom_right.y);
+
+	for (int y = y1; y <= y2; ++y) {
+		for (int x = x1; x <= x2; ++x) {
+			const std::vector<Entity*>& bucket = cells[y * cols + x];
+			for (size_t i = 0; i < bucket.size(); ++i) {
+				const FPoint& p = bucket[i]->stats.pos;
+				if (p.x >= top_left.x && p.x <= bottom_right.x && p.y >= top_left.y && p.y <= bottom_right.y)
+					result.push_back(bucket[i]);
+			}
+		}
+	}
+
+	std::sort(result.begin(), result.end(), compareOrder);
+}
+
+/**
+ * Get up to k entities that pass the filter and are no further than max_range from pos, nearest first.
+ * Entities at the same distance are returned in list order.
+ * Cells are searched in rings around pos until no unsearched cell can hold a closer entity.
+ */
+void EntityGrid::getNearest(const FPoint& pos, float max_range, size_t k, Filter filter, const void* data, std::vector<Entity*>& result) {
+	result.clear();
+	if (k == 0)
+		return;
+
+	std::vector<Candidate> candidates;
+
+	int cx = getCellX(pos.x);
+	int cy = getCellY(pos.y);
+	int max_ring = std::max(std::max(cx, cols - 1 - cx), std::max(cy, rows - 1 - cy));
+
+	for (int ring = 0; ring <= max_ring; ++ring) {
+		// every entity in this ring or beyond is at least this far away
+		float ring_distance = static_cast<float>(std::max(ring - 1, 0) * CELL_SIZE);
+		if (ring_distance > max_range)
+			break;
+
+		if (candidates.size() >= k) {
+			std::sort(candidates.begin(), candidates.end(), compareCandidates);
+			candidates.resize(k);
+			if (candidates.back().distance < ring_distance)
+				break;
+		}
+
+		for (int y = cy - ring; y <= cy + ring; ++y) {
+			if (y < 0 || y >= rows)
+				continue;
+
+			// only the outline of the ring needs to be searched
+			int step = (y == cy - ring || y == cy + ring) ? 1 : std::max(ring * 2, 1);
+
+			for (int x = cx - ring; x <= cx + ring; x += step) {
+				if (x < 0 || x >= cols)
+					continue;
+
+				const std::vector<Entity*>& bucket = cells[y * cols + x];
+				for (size_t i = 0; i < bucket.size(); ++i) {
+					Entity* e = bucket[i];
+					if (filter && !filter(e, data))
+						continue;
+
+					float distance = Utils::calcDist(pos, e->stats.pos);
+					if (distance > max_range)
+						continue;
+
+					Candidate c;
+					c.entity = e;
+					c.distance = distance;
+					c.order = e->grid_order;
+					candidates.push_back(c);
+				}
+			}
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end(), compareCandidates);
+	if (candidates.size() > k)
+		candidates.resize(k);
+
+	for (size_t i = 0; i < candidates.size(); ++i) {
+		result.push_back(candidates[i].entity);
+	}
+}
@@ -0,0 +1,75 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class EntityGrid
+ *
+ * Buckets entities into square cells of map tiles so that proximity queries only
+ * look at nearby entities. An entity is only moved between buckets when its
+ * position crosses into another cell.
+ * Unless noted otherwise, query results are returned in the same order as the
+ * EntityManager's entity list.
+ */
+
+#ifndef ENTITY_GRID_H
+#define ENTITY_GRID_H
+
+#include "CommonIncludes.h"
+#include "Utils.h"
+
+class Entity;
+
+class EntityGrid {
+public:
+	typedef bool (*Filter)(const Entity* entity, const void* data);
+
+	static const int CELL_SIZE = 4;
+
+	EntityGrid();
+	~EntityGrid();
+
+	void init(int map_w, int map_h);
+	void clear();
+	void sync(const std::vector<Entity*>& entities);
+	void update(Entity* e);
+	void remove(Entity* e);
+
+	void getInRadius(const FPoint& pos, float radius, std::vector<Entity*>& result);
+	void getInSweptRadius(const FPoint& start, const FPoint& end, float radius, std::vector<Entity*>& result);
+	void getInArea(const FPoint& top_left, const FPoint& bottom_right, std::vector<Entity*>& result);
+	void getNearest(const FPoint& pos, float max_range, size_t k, Filter filter, const void* data, std::vector<Entity*>& result);
+
+private:
+	class Candidate {
+	public:
+		Entity* entity;
+		float distance;
+		size_t order;
+	};
+
+	static bool compareOrder(const Entity* a, const Entity* b);
+	static bool compareCandidates(const Candidate& a, const Candidate& b);
+
+	int getCellX(float x);
+	int getCellY(float y);
+
+	std::vector< std::vector<Entity*> > cells;
+	int cols;
+	int rows;
+};
+
+#endif
@@ -42,19 +42,34 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 
 #include <limits>
 
+// entities further than this (as a multiple of the encounter distance) from the hero are dormant while idle
+const float EntityManager::LOD_DORMANT_DISTANCE = 3;
+
 EntityManager::EntityManager()
-	: entities()
+	: lod_frame(0)
+	, thread_pool(settings->worker_threads)
+	, pool()
+	, entities()
 	, hero_stealth(0)
 	, player_blocked(false)
-	, player_blocked_timer(settings->max_frames_per_sec / 6) {
+	, player_blocked_timer(settings->max_frames_per_sec / 6)
+	, path_service() {
 	handleNewMap();
 }
 
 Entity *EntityManager::getEntityPrototype(const std::string& type_id) {
-	Entity* e = new Entity(prototypes.at(loadEntityPrototype(type_id)));
+	Entity* e = pool.create(prototypes.at(loadEntityPrototype(type_id)));
 	return e;
 }
 
+/**
+ * Get an entity type's prototype without creating an entity in the pool.
+ * The reference is only valid until another prototype is loaded.
+ */
+const Entity& EntityManager::getPrototype(const std::string& type_id) {
+	return prototypes.at(loadEntityPrototype(type_id));
+}
+
 size_t EntityManager::loadEntityPrototype(const std::string& type_id) {
 	for (size_t i = 0; i < prototypes.size(); i++) {
 		if (prototypes[i].type_filename == type_id) {
@@ -75,7 +90,7 @@ size_t EntityManager::loadEntityPrototype(const std::string& type_id) {
 
 	// set cooldown_hit to duration of hit animation if undefined
 	if (!e.stats.cooldown_hit_enabled && e.animationSet) {
-		Animation *hit_anim = e.animationSet->getAnimation("hit");
+		Animation *hit_anim = e.animationSet->getAnimation(SymbolTable::ANIM_HIT);
 		if (hit_anim) {
 			e.stats.cooldown_hit.setDuration(hit_anim->getDuration());
 			delete hit_anim;
@@ -111,6 +126,14 @@ void EntityManager::handleNewMap () {
 	Map_Enemy me;
 	std::queue<Entity *> allies;
 
+	// pending paths were computed for the previous map
+	path_service.clear();
+
+	grid.clear();
+
+	// free composited layer images that won't be used on the new map
+	layer_cache.clear();
+
 	// delete existing entities
 	for (unsigned int i=0; i < entities.size(); i++) {
 		if (entities[i]->stats.npc)
@@ -120,7 +143,7 @@ void EntityManager::handleNewMap () {
 			allies.push(entities[i]);
 		else {
 			entities[i]->unloadSounds();
-			delete entities[i];
+			pool.destroy(entities[i]);
 		}
 	}
 	entities.clear();
@@ -194,8 +217,7 @@ void EntityManager::handleNewMap () {
 		allies.pop();
 
 		//dont need the result of this. its only called to handle animation and sound
-		Entity* temp = getEntityPrototype(e->type_filename);
-		delete temp;
+		loadEntityPrototype(e->type_filename);
 
 		e->stats.pos = spawn_pos;
 		e->stats.direction = pc->stats.direction;
@@ -205,6 +227,9 @@ void EntityManager::handleNewMap () {
 		mapr->collider.block(e->stats.pos.x, e->stats.pos.y, MapCollision::IS_ALLY);
 	}
 
+	grid.init(mapr->w, mapr->h);
+	grid.sync(entities);
+
 	// load entities that can be spawn by avatar's powers
 	for (size_t i = 0; i < pc->stats.powers_list.size(); i++) {
 		PowerID power_index = pc->stats.powers_list[i];
@@ -260,7 +285,7 @@ void EntityManager::handleSpawn() {
 
 		mapr->collider.unblock(espawn.pos.x, espawn.pos.y);
 
-		Entity *e = new Entity();
+		Entity *e = pool.create();
 
 		e->stats.hero_ally = espawn.hero_ally;
 		e->stats.enemy_ally = espawn.enemy_ally;
@@ -269,7 +294,7 @@ void EntityManager::handleSpawn() {
 
 		if(espawn.summoner != NULL) {
 			e->stats.summoner = espawn.summoner;
-			espawn.summoner->summons.push_back(&(e->stats));
+			espawn.summoner->addSummon(e->pool_handle);
 		}
 
 		e->stats.direction = static_cast<unsigned char>(espawn.direction);
@@ -282,7 +307,7 @@ void EntityManager::handleSpawn() {
 		}
 		else {
 			Utils::logError("EntityManager: Could not spawn creature type '%s'", espawn.type.c_str());
-			delete e;
+			pool.destroy(e);
 			return;
 		}
 
@@ -294,7 +319,7 @@ void EntityManager::handleSpawn() {
 
 		//Set level
 		if (e->stats.summoned_power_index != 0) {
-			SpawnLevel* spawn_level = &(powers->powers[e->stats.summoned_power_index].spawn_level);
+			const SpawnLevel* spawn_level = &(powers->powers[e->stats.summoned_power_index].spawn_level);
 
 			if (spawn_level->mode == SpawnLevel::MODE_FIXED) {
 				e->stats.level = static_cast<int>(spawn_level->count);
@@ -387,58 +412,142 @@ void EntityManager::logic() {
 
 	handleSpawn();
 
-	std::vector<Entity*>::iterator it;
-	for (it = entities.begin(); it != entities.end(); ++it) {
+	// refresh region labels and clear last frame's line-of-sight results
+	mapr->collider.logic();
+
+	// collect finished paths and start resolving new requests
+	path_service.logic(mapr->collider, thread_pool);
+
+	// pick up spawned entities and anything that was moved outside of entity logic
+	grid.sync(entities);
+
+	lod_frame++;
+
+	std::vector<Entity*> active;
+
+	for (size_t i = 0; i < entities.size(); ++i) {
+		Entity* e = entities[i];
+
 		// new actions this round
-		(*it)->stats.hero_stealth = hero_stealth;
-		if (!(*it)->stats.npc) {
-			(*it)->logic();
+		e->stats.hero_stealth = hero_stealth;
+		if (e->stats.npc)
+			continue;
+
+		// spread reduced rate entities over the interval instead of running them all on the same frame
+		int tier = getLODTier(e);
+		if (tier == LOD_DORMANT || (tier == LOD_REDUCED && (lod_frame + i) % LOD_REDUCED_INTERVAL != 0)) {
+			if (e->stats.encountered)
+				e->lod_skipped_frames++;
+			continue;
 		}
+
+		active.push_back(e);
+	}
+
+	// targeting only reads the state of the map and other entities, so it can be done for everyone at once
+	thread_pool.run(decideTask, &active, active.size());
+
+	// everything else changes the world, so it is applied one entity at a time in list order
+	for (size_t i = 0; i < active.size(); ++i) {
+		Entity* e = active[i];
+
+		if (e->lod_skipped_frames > 0) {
+			e->stats.advanceTimers(e->lod_skipped_frames);
+			e->lod_skipped_frames = 0;
+		}
+
+		e->logic();
+		grid.update(e);
 	}
 }
 
+void EntityManager::decideTask(void* data, size_t index) {
+	std::vector<Entity*>* active = static_cast<std::vector<Entity*>*>(data);
+	(*active)[index]->behavior->decide();
+}
+
+/**
+ * Idle entities that are far away from the hero and the camera don't need to run their logic every frame.
+ * Skipped frames are made up for with StatBlock::advanceTimers(), which only handles entities without effects.
+ */
+int EntityManager::getLODTier(const Entity* e) {
+	const StatBlock& stats = e->stats;
+
+	if (stats.hero_ally || stats.corpse || stats.in_combat || stats.join_combat || !stats.effects.effect_list.empty())
+		return LOD_FULL;
+
+	// don't interrupt attacks, hit reactions, death animations, etc
+	if (stats.cur_state != StatBlock::ENTITY_STANCE && stats.cur_state != StatBlock::ENTITY_MOVE)
+		return LOD_FULL;
+
+	float hero_dist = Utils::calcDist(stats.pos, pc->stats.pos);
+	if (hero_dist <= settings->encounter_dist || Utils::calcDist(stats.pos, mapr->cam.pos) <= settings->encounter_dist)
+		return LOD_FULL;
+
+	if (hero_dist <= settings->encounter_dist * LOD_DORMANT_DISTANCE)
+		return LOD_REDUCED;
+
+	return LOD_DORMANT;
+}
+
 Entity* EntityManager::entityFocus(const Point& mouse, const FPoint& cam, bool alive_only) {
-	Point p;
-	Rect r;
-	for(unsigned int i = 0; i < entities.size(); i++) {
-		if(alive_only && (entities[i]->stats.cur_state == StatBlock::ENTITY_DEAD || entities[i]->stats.cur_state == StatBlock::ENTITY_CRITDEAD)) {
+	// only check entities that are positioned close enough for their sprite to be under the mouse
+	// we assume that no sprite is larger than half of the screen
+	const int margin_x = settings->view_w / 2;
+	const int margin_y = settings->view_h / 2;
+
+	FPoint corners[4];
+	corners[0] = Utils::screenToMap(mouse.x - margin_x, mouse.y - margin_y, cam.x, cam.y);
+	corners[1] = Utils::screenToMap(mouse.x + margin_x, mouse.y - margin_y, cam.x, cam.y);
+	corners[2] = Utils::screenToMap(mouse.x - margin_x, mouse.y + margin_y, cam.x, cam.y);
+	corners[3] = Utils::screenToMap(mouse.x + margin_x, mouse.y + margin_y, cam.x, cam.y);
+
+	FPoint top_left = corners[0];
+	FPoint bottom_right = corners[0];
+	for (int i = 1; i < 4; ++i) {
+		top_left.x = std::min(top_left.x, corners[i].x);
+		top_left.y = std::min(top_left.y, corners[i].y);
+		bottom_right.x = std::max(bottom_right.x, corners[i].x);
+		bottom_right.y = std::max(bottom_right.y, corners[i].y);
+	}
+
+	std::vector<Entity*> candidates;
+	grid.getInArea(top_left, bottom_right, candidates);
+
+	for(unsigned int i = 0; i < candidates.size(); i++) {
+		if(alive_only && (candidates[i]->stats.cur_state == StatBlock::ENTITY_DEAD || candidates[i]->stats.cur_state == StatBlock::ENTITY_CRITDEAD)) {
 			continue;
 		}
 
-		if (Utils::isWithinRect(entities[i]->getRenderBounds(cam), mouse)) {
-			Entity *entity = entities[i];
-			return entity;
+		if (Utils::isWithinRect(candidates[i]->getRenderBounds(cam), mouse)) {
+			return candidates[i];
 		}
 	}
 	return NULL;
 }
 
-Entity* EntityManager::getNearestEntity(const FPoint& pos, bool get_corpse, float *saved_distance, float max_range) {
-	Entity* nearest = NULL;
-	float best_distance = std::numeric_limits<float>::max();
+bool EntityManager::isNotDead(const Entity* entity, const void*) {
+	return entity->stats.cur_state != StatBlock::ENTITY_DEAD && entity->stats.cur_state != StatBlock::ENTITY_CRITDEAD;
+}
 
-	for (unsigned i=0; i<entities.size(); i++) {
-		if(!get_corpse && (entities[i]->stats.cur_state == StatBlock::ENTITY_DEAD || entities[i]->stats.cur_state == StatBlock::ENTITY_CRITDEAD)) {
-			continue;
-		}
-		if (get_corpse && !entities[i]->stats.corpse) {
-			continue;
-		}
+bool EntityManager::isCorpse(const Entity* entity, const void*) {
+	return entity->stats.corpse;
+}
 
-		float distance = Utils::calcDist(pos, entities[i]->stats.pos);
-		if (distance < best_distance) {
-			best_distance = distance;
-			nearest = entities[i];
-		}
-	}
+Entity* EntityManager::getNearestEntity(const FPoint& pos, bool get_corpse, float *saved_distance, float max_range) {
+	// when the distance is requested, the nearest entity is returned regardless of range
+	float search_range = saved_distance ? std::numeric_limits<float>::max() : max_range;
+
+	std::vector<Entity*> nearest;
+	grid.getNearest(pos, search_range, 1, (get_corpse ? isCorpse : isNotDead), NULL, nearest);
 
-	if (nearest && saved_distance)
-		*saved_distance = best_distance;
+	if (nearest.empty())
+		return NULL;
 
-	if (!saved_distance && best_distance > max_range)
-		nearest = NULL;
+	if (saved_distance)
+		*saved_distance = Utils::calcDist(pos, nearest[0]->stats.pos);
 
-	return nearest;
+	return nearest[0];
 }
 
 bool EntityManager::isCleared() {
@@ -504,9 +613,13 @@ EntityManager::~EntityManager() {
 			continue;
 
 		entities[i]->unloadSounds();
-		delete entities[i];
+		pool.destroy(entities[i]);
 	}
 	for (unsigned int i=0; i < prototypes.size(); i++) {
 		prototypes[i].unloadSounds();
 	}
+
+	// the hero outlives the pool, so its handles to summons can't be resolved after this
+	if (pc)
+		pc->stats.summons.clear();
 }
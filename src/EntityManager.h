@@ -27,6 +27,11 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #define ENTITY_MANAGER_H
 
 #include "CommonIncludes.h"
+#include "EntityGrid.h"
+#include "EntityPool.h"
+#include "PathService.h"
+#include "RenderLayerCache.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
 class Animation;
@@ -41,11 +46,32 @@ protected:
 
 	std::vector<Entity> prototypes;
 
+	// level-of-detail tiers for entity logic
+	enum {
+		LOD_FULL = 0, // every frame
+		LOD_REDUCED = 1, // every LOD_REDUCED_INTERVAL frames
+		LOD_DORMANT = 2 // not at all
+	};
+
+	static const unsigned LOD_REDUCED_INTERVAL = 4;
+	static const float LOD_DORMANT_DISTANCE;
+
+	int getLODTier(const Entity* e);
+	unsigned lod_frame;
+
+	static void decideTask(void* data, size_t index);
+	// shared by enemy decision making and pathfinding
+	ThreadPool thread_pool;
+
+	static bool isNotDead(const Entity* entity, const void* data);
+	static bool isCorpse(const Entity* entity, const void* data);
+
 public:
 	EntityManager();
 	~EntityManager();
 
 	Entity *getEntityPrototype(const std::string& type_id);
+	const Entity& getPrototype(const std::string& type_id);
 
 	void handleNewMap();
 	void handleSpawn();
@@ -59,12 +85,17 @@ public:
 	Entity* getNearestEntity(const FPoint& pos, bool get_corpse, float *saved_distance, float max_range);
 
 	// vars
+	EntityPool pool; // storage for everything in the entity list except NPCs, which NPCManager owns
 	std::vector<Entity*> entities;
 	float hero_stealth;
 
 	bool player_blocked;
 	Timer player_blocked_timer;
 
+	PathService path_service;
+	EntityGrid grid;
+	RenderLayerCache layer_cache;
+
 	static const bool GET_CORPSE = true;
 	static const bool IS_ALIVE = true;
 };
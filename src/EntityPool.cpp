@@ -0,0 +1,126 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class EntityPool
+ *
+ * Stores entities in fixed size blocks and reuses the slots of destroyed entities.
+ * Each slot has a generation that changes when its entity is destroyed, so an
+ * EntityHandle to a destroyed entity stops resolving instead of dangling.
+ */
+
+#include "Entity.h"
+#include "EntityPool.h"
+#include "Utils.h"
+
+#include <new>
+
+EntityPool::EntityPool()
+	: blocks()
+	, generations()
+	, used()
+	, free_slots()
+	, live_count(0)
+{
+}
+
+EntityPool::~EntityPool() {
+	for (unsigned i = 0; i < used.size(); ++i) {
+		if (used[i])
+			getSlot(i)->~Entity();
+	}
+
+	for (size_t i = 0; i < blocks.size(); ++i) {
+		::operator delete(blocks[i]);
+	}
+}
+
+/**
+ * Get the index of a free slot, adding a new block if all slots are in use
+ */
+unsigned EntityPool::acquireSlot() {
+	if (free_slots.empty()) {
+		blocks.push_back(::operator new(sizeof(Entity) * BLOCK_SIZE));
+
+		unsigned first = static_cast<unsigned>(generations.size());
+		generations.resize(first + BLOCK_SIZE, 1);
+		used.resize(first + BLOCK_SIZE, false);
+
+		// reversed, so that slots are handed out in address order
+		for (unsigned i = BLOCK_SIZE; i > 0; --i) {
+			free_slots.push_back(first + i - 1);
+		}
+	}
+
+	unsigned index = free_slots.back();
+	free_slots.pop_back();
+	return index;
+}
+
+Entity* EntityPool::getSlot(unsigned index) const {
+	return static_cast<Entity*>(blocks[index / BLOCK_SIZE]) + (index % BLOCK_SIZE);
+}
+
+Entity* EntityPool::activate(Entity* e, unsigned index) {
+	used[index] = true;
+	e->pool_handle.index = index;
+	e->pool_handle.generation = generations[index];
+	live_count++;
+	return e;
+}
+
+Entity* EntityPool::create() {
+	unsigned index = acquireSlot();
+	return activate(new (getSlot(index)) Entity(), index);
+}
+
+Entity* EntityPool::create(const Entity& prototype) {
+	unsigned index = acquireSlot();
+	return activate(new (getSlot(index)) Entity(prototype), index);
+}
+
+void EntityPool::destroy(Entity* e) {
+	if (!e)
+		return;
+
+	unsigned index = e->pool_handle.index;
+	if (get(e->pool_handle) != e) {
+		Utils::logError("EntityPool: Tried to destroy an entity that is not in the pool.");
+		return;
+	}
+
+	// handles are invalidated first, so the entity can't be found while it is being destroyed
+	generations[index]++;
+	if (generations[index] == 0)
+		generations[index] = 1;
+	used[index] = false;
+
+	e->~Entity();
+
+	free_slots.push_back(index);
+	live_count--;
+}
+
+/**
+ * Returns NULL if the entity that the handle refers to has been destroyed
+ */
+Entity* EntityPool::get(const EntityHandle& handle) const {
+	if (handle.isNull() || handle.index >= used.size() || !used[handle.index] || generations[handle.index] != handle.generation)
+		return NULL;
+
+	return getSlot(handle.index);
+}
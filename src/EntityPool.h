@@ -0,0 +1,80 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class EntityPool
+ *
+ * Stores entities in fixed size blocks and reuses the slots of destroyed entities.
+ * Each slot has a generation that changes when its entity is destroyed, so an
+ * EntityHandle to a destroyed entity stops resolving instead of dangling.
+ */
+
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include "CommonIncludes.h"
+
+class Entity;
+
+class EntityHandle {
+public:
+	EntityHandle()
+		: index(0)
+		, generation(0)
+	{}
+
+	bool operator==(const EntityHandle& other) const {
+		return index == other.index && generation == other.generation;
+	}
+
+	// generation 0 is never used by a live entity
+	bool isNull() const { return generation == 0; }
+
+	unsigned index;
+	unsigned generation;
+};
+
+class EntityPool {
+public:
+	static const unsigned BLOCK_SIZE = 64;
+
+	EntityPool();
+	~EntityPool();
+
+	Entity* create();
+	Entity* create(const Entity& prototype);
+	void destroy(Entity* e);
+
+	Entity* get(const EntityHandle& handle) const;
+	size_t size() const { return live_count; }
+
+private:
+	EntityPool(const EntityPool&);
+	EntityPool& operator=(const EntityPool&);
+
+	unsigned acquireSlot();
+	Entity* getSlot(unsigned index) const;
+	Entity* activate(Entity* e, unsigned index);
+
+	std::vector<void*> blocks;
+	std::vector<unsigned> generations;
+	std::vector<bool> used;
+	std::vector<unsigned> free_slots;
+	size_t live_count;
+};
+
+#endif
@@ -0,0 +1,222 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class EventIndex
+ *
+ * Buckets the map's events into square cells of map tiles, so that the per-frame event
+ * checks only look at the events near the hero or the mouse cursor.
+ * The index holds positions in the event list, so it must be rebuilt whenever events are
+ * added, removed or moved.
+ * Query results are sorted from the last event in the list to the first, so erasing a
+ * result doesn't move the results that come after it.
+ */
+
+#include "EventIndex.h"
+#include "EventManager.h"
+
+EventIndex::Grid::Grid()
+	: cells()
+	, cols(1)
+	, rows(1)
+{
+	cells.resize(1);
+}
+
+void EventIndex::Grid::init(int map_w, int map_h) {
+	cols = std::max((map_w + CELL_SIZE - 1) / CELL_SIZE, 1);
+	rows = std::max((map_h + CELL_SIZE - 1) / CELL_SIZE, 1);
+
+	cells.clear();
+	cells.resize(cols * rows);
+}
+
+void EventIndex::Grid::clear() {
+	for (size_t i = 0; i < cells.size(); ++i) {
+		cells[i].clear();
+	}
+}
+
+/**
+ * Add an event to every cell that the area (in map units) overlaps
+ */
+void EventIndex::Grid::add(size_t index, float x1, float y1, float x2, float y2) {
+	int cx1 = getCellX(x1);
+	int cy1 = getCellY(y1);
+	int cx2 = getCellX(x2);
+	int cy2 = getCellY(y2);
+
+	for (int y = cy1; y <= cy2; ++y) {
+		for (int x = cx1; x <= cx2; ++x) {
+			cells[y * cols + x].push_back(index);
+		}
+	}
+}
+
+/**
+ * Positions outside of the map are placed in the nearest edge cell
+ */
+int EventIndex::Grid::getCellX(float x) const {
+	if (x < 0)
+		return 0;
+	return std::min(static_cast<int>(x) / CELL_SIZE, cols - 1);
+}
+
+int EventIndex::Grid::getCellY(float y) const {
+	if (y < 0)
+		return 0;
+	return std::min(static_cast<int>(y) / CELL_SIZE, rows - 1);
+}
+
+EventIndex::EventIndex()
+	: triggers()
+	, hotspots()
+	, hotspot_centers()
+	, hover_areas()
+	, unindexed_triggers()
+	, npc_hotspots()
+{
+}
+
+EventIndex::~EventIndex() {
+}
+
+/**
+ * hotspot_margins holds, for each event, how far (in map units) the graphics of its hotspot
+ * reach outside of the hotspot area.
+ */
+void EventIndex::build(const std::vector<Event>& events, int map_w, int map_h, const std::vector<float>& hotspot_margins) {
+	clear();
+
+	triggers.init(map_w, map_h);
+	hotspots.init(map_w, map_h);
+	hotspot_centers.init(map_w, map_h);
+
+	hover_areas.resize(events.size());
+
+	for (size_t i = 0; i < events.size(); ++i) {
+		const Event& ev = events[i];
+
+		if (ev.activate_type == Event::ACTIVATE_ON_TRIGGER) {
+			if (ev.location.w > 0 && ev.location.h > 0) {
+				float x1 = static_cast<float>(ev.location.x);
+				float y1 = static_cast<float>(ev.location.y);
+				triggers.add(i, x1, y1, x1 + static_cast<float>(ev.location.w - 1), y1 + static_cast<float>(ev.location.h - 1));
+			}
+		}
+		else if (ev.activate_type == Event::ACTIVATE_STATIC || ev.activate_type == Event::ACTIVATE_ON_CLEAR || ev.activate_type == Event::ACTIVATE_ON_LEAVE) {
+			unindexed_triggers.push_back(i);
+		}
+
+		if (ev.hotspot.h == 0)
+			continue;
+
+		bool is_npc = false;
+		for (size_t j = 0; j < ev.components.size(); ++j) {
+			if (ev.components[j].type == EventComponent::NPC_HOTSPOT) {
+				is_npc = true;
+				break;
+			}
+		}
+
+		if (is_npc) {
+			npc_hotspots.push_back(i);
+			continue;
+		}
+
+		// one extra tile, since the graphics are positioned from the tile center
+		float margin = (i < hotspot_margins.size() ? hotspot_margins[i] : 0) + 1;
+
+		Area& area = hover_areas[i];
+		area.x1 = static_cast<float>(ev.hotspot.x) - margin;
+		area.y1 = static_cast<float>(ev.hotspot.y) - margin;
+		area.x2 = static_cast<float>(ev.hotspot.x + ev.hotspot.w) + margin;
+		area.y2 = static_cast<float>(ev.hotspot.y + ev.hotspot.h) + margin;
+		hotspots.add(i, area.x1, area.y1, area.x2, area.y2);
+
+		hotspot_centers.add(i, ev.center.x, ev.center.y, ev.center.x, ev.center.y);
+	}
+}
+
+void EventIndex::clear() {
+	triggers.clear();
+	hotspots.clear();
+	hotspot_centers.clear();
+	hover_areas.clear();
+	unindexed_triggers.clear();
+	npc_hotspots.clear();
+}
+
+/**
+ * Get the events that checkEvents() needs to look at while the hero stands on this tile:
+ * on_trigger events whose location may contain the tile, and all static, on_clear and on_leave events.
+ */
+void EventIndex::getTriggerEvents(const Point& tile, std::vector<size_t>& result) const {
+	result = unindexed_triggers;
+
+	float x = static_cast<float>(tile.x);
+	float y = static_cast<float>(tile.y);
+	const std::vector<size_t>& cell = triggers.cells[triggers.getCellY(y) * triggers.cols + triggers.getCellX(x)];
+	result.insert(result.end(), cell.begin(), cell.end());
+
+	sortResult(result);
+}
+
+/**
+ * Get the events with hotspots whose graphics may be under this map position, plus all npc hotspots
+ */
+void EventIndex::getHoveredHotspots(const FPoint& pos, std::vector<size_t>& result) const {
+	result = npc_hotspots;
+
+	const std::vector<size_t>& cell = hotspots.cells[hotspots.getCellY(pos.y) * hotspots.cols + hotspots.getCellX(pos.x)];
+	for (size_t i = 0; i < cell.size(); ++i) {
+		if (isInside(hover_areas[cell[i]], pos))
+			result.push_back(cell[i]);
+	}
+
+	sortResult(result);
+}
+
+/**
+ * Get the events with hotspots whose center may be within radius of pos, plus all npc hotspots.
+ * Events that are a little further away can be included, so the distance still needs to be checked.
+ */
+void EventIndex::getHotspotsNear(const FPoint& pos, float radius, std::vector<size_t>& result) const {
+	result = npc_hotspots;
+
+	int x1 = hotspot_centers.getCellX(pos.x - radius);
+	int y1 = hotspot_centers.getCellY(pos.y - radius);
+	int x2 = hotspot_centers.getCellX(pos.x + radius);
+	int y2 = hotspot_centers.getCellY(pos.y + radius);
+
+	for (int y = y1; y <= y2; ++y) {
+		for (int x = x1; x <= x2; ++x) {
+			const std::vector<size_t>& cell = hotspot_centers.cells[y * hotspot_centers.cols + x];
+			result.insert(result.end(), cell.begin(), cell.end());
+		}
+	}
+
+	sortResult(result);
+}
+
+bool EventIndex::isInside(const Area& area, const FPoint& pos) {
+	return pos.x >= area.x1 && pos.y >= area.y1 && pos.x <= area.x2 && pos.y <= area.y2;
+}
+
+void EventIndex::sortResult(std::vector<size_t>& result) {
+	std::sort(result.begin(), result.end(), std::greater<size_t>());
+}
@@ -0,0 +1,84 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class EventIndex
+ *
+ * Buckets the map's events into square cells of map tiles, so that the per-frame event
+ * checks only look at the events near the hero or the mouse cursor.
+ * The index holds positions in the event list, so it must be rebuilt whenever events are
+ * added, removed or moved.
+ * Query results are sorted from the last event in the list to the first, so erasing a
+ * result doesn't move the results that come after it.
+ */
+
+#ifndef EVENT_INDEX_H
+#define EVENT_INDEX_H
+
+#include "CommonIncludes.h"
+#include "Utils.h"
+
+class Event;
+
+class EventIndex {
+public:
+	static const int CELL_SIZE = 8;
+
+	EventIndex();
+	~EventIndex();
+
+	void build(const std::vector<Event>& events, int map_w, int map_h, const std::vector<float>& hotspot_margins);
+	void clear();
+
+	void getTriggerEvents(const Point& tile, std::vector<size_t>& result) const;
+	void getHoveredHotspots(const FPoint& pos, std::vector<size_t>& result) const;
+	void getHotspotsNear(const FPoint& pos, float radius, std::vector<size_t>& result) const;
+
+private:
+	class Area {
+	public:
+		float x1, y1, x2, y2;
+	};
+
+	class Grid {
+	public:
+		Grid();
+		void init(int map_w, int map_h);
+		void clear();
+		void add(size_t index, float x1, float y1, float x2, float y2);
+		int getCellX(float x) const;
+		int getCellY(float y) const;
+
+		std::vector< std::vector<size_t> > cells;
+		int cols;
+		int rows;
+	};
+
+	static bool isInside(const Area& area, const FPoint& pos);
+	static void sortResult(std::vector<size_t>& result);
+
+	Grid triggers; // on_trigger events, by location
+	Grid hotspots; // by hotspot, grown by the size of the hotspot graphics
+	Grid hotspot_centers; // by center, for range checks
+
+	std::vector<Area> hover_areas; // one per event in the list
+
+	std::vector<size_t> unindexed_triggers; // checked every frame regardless of position
+	std::vector<size_t> npc_hotspots; // npc events are moved with the npc, so they're checked every frame
+};
+
+#endif
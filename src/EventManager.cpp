@@ -34,6 +34,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "SharedGameResources.h"
 #include "SharedResources.h"
 #include "SoundManager.h"
+#include "SymbolTable.h"
 #include "UtilsFileSystem.h"
 #include "UtilsMath.h"
 #include "UtilsParsing.h"
@@ -49,9 +50,18 @@ EventComponent::EventComponent()
 	}
 }
 
+EventRequirement::EventRequirement()
+	: type(EventComponent::NONE)
+	, value(0)
+	, id(0)
+{
+}
+
 /**
  * Class: Event
  */
+size_t Event::next_serial = 0;
+
 Event::Event()
 	: type("")
 	, activate_type(ACTIVATE_ON_TRIGGER)
@@ -62,7 +72,12 @@ Event::Event()
 	, delay()
 	, keep_after_trigger(true)
 	, center(FPoint(-1, -1))
-	, reachable_from(Rect()) {
+	, reachable_from(Rect())
+	, serial(next_serial++)
+	, requirements()
+	, requirements_compiled(false)
+	, requirements_met(false)
+	, requirements_version(0) {
 }
 
 Event::~Event() {
@@ -88,6 +103,28 @@ void Event::deleteAllComponents(const int _type) {
 			it = components.erase(it);
 }
 
+/**
+ * Requirement components are only added while an event is being loaded,
+ * so they are compiled once and reused for every check after that.
+ */
+const std::vector<EventRequirement>& Event::getRequirements() const {
+	if (!requirements_compiled) {
+		EventManager::compileRequirements(components, requirements);
+		requirements_compiled = true;
+	}
+	return requirements;
+}
+
+/**
+ * The result is reused until the campaign version changes, since nothing else can change it.
+ */
+bool Event::checkRequirements() const {
+	if (requirements_version != camp->getVersion()) {
+		requirements_met = camp->checkRequirements(getRequirements());
+		requirements_version = camp->getVersion();
+	}
+	return requirements_met;
+}
 
 /**
  * Class: EventManager
@@ -756,11 +793,18 @@ bool EventManager::loadEventComponentString(std::string &key, std::string &val,
 }
 
 bool EventManager::executeEvent(Event &e) {
-	return executeEventInternal(e, !SKIP_DELAY);
+	return executeEventInternal(e, !SKIP_DELAY, !IN_EVENT_LIST);
+}
+
+/**
+ * Use for events in the map's event list, so that their delay and cooldown timers are tracked
+ */
+bool EventManager::executeMapEvent(Event &e) {
+	return executeEventInternal(e, !SKIP_DELAY, IN_EVENT_LIST);
 }
 
 bool EventManager::executeDelayedEvent(Event &e) {
-	return executeEventInternal(e, SKIP_DELAY);
+	return executeEventInternal(e, SKIP_DELAY, !IN_EVENT_LIST);
 }
 
 /**
@@ -769,9 +813,10 @@ bool EventManager::executeDelayedEvent(Event &e) {
  *
  * @param The triggered event
  * @param Delay ignore flag
+ * @param True if the event is in the map's event list
  * @return Returns true if the event shall not be run again.
  */
-bool EventManager::executeEventInternal(Event &ev, bool skip_delay) {
+bool EventManager::executeEventInternal(Event &ev, bool skip_delay, bool in_event_list) {
 	// skip executing events that are on cooldown
 	if (!ev.delay.isEnd() || !ev.cooldown.isEnd()) return false;
 
@@ -788,14 +833,18 @@ bool EventManager::executeEventInternal(Event &ev, bool skip_delay) {
 	// The copy only starts the delay timer. The cooldown is not needed because the copy never repeats.
 	if (ev.delay.getDuration() > 0 && !skip_delay) {
 		ev.delay.reset(Timer::BEGIN);
-		mapr->delayed_events.push_back(ev);
+		mapr->addDelayedEvent(ev);
 		ev.cooldown.reset(Timer::BEGIN);
+		if (in_event_list)
+			mapr->startEventTimers(ev);
 
 		return !ev.keep_after_trigger;
 	}
 
 	// set cooldown
 	ev.cooldown.reset(Timer::BEGIN);
+	if (in_event_list)
+		mapr->startEventTimers(ev);
 
 	// if chance_exec roll fails, don't execute the event
 	// we respect the value of "repeat", even if the event doesn't execute
@@ -856,6 +905,7 @@ bool EventManager::executeEventInternal(Event &ev, bool skip_delay) {
 			if (ec->s == "collision") {
 				if (ec->data[0].Int >= 0 && ec->data[0].Int < mapr->w && ec->data[1].Int >= 0 && ec->data[1].Int < mapr->h) {
 					mapr->collider.colmap[ec->data[0].Int][ec->data[1].Int] = static_cast<unsigned short>(ec->data[2].Int);
+					mapr->collider.invalidateRegions();
 					mapr->map_change = true;
 				}
 				else
@@ -867,8 +917,12 @@ bool EventManager::executeEventInternal(Event &ev, bool skip_delay) {
 					Utils::logError("EventManager: Mapmod at position (%d, %d) contains invalid tile id (%d).", ec->data[0].Int, ec->data[1].Int, ec->data[2].Int);
 				else if (index >= mapr->layers.size())
 					Utils::logError("EventManager: Mapmod at position (%d, %d) is on an invalid layer.", ec->data[0].Int, ec->data[1].Int);
-				else if (ec->data[0].Int >= 0 && ec->data[0].Int < mapr->w && ec->data[1].Int >= 0 && ec->data[1].Int < mapr->h)
+				else if (ec->data[0].Int >= 0 && ec->data[0].Int < mapr->w && ec->data[1].Int >= 0 && ec->data[1].Int < mapr->h) {
 					mapr->layers[index][ec->data[0].Int][ec->data[1].Int] = static_cast<unsigned short>(ec->data[2].Int);
+
+					// the new tile may change how far an event hotspot's graphics reach
+					mapr->invalidateEventIndex();
+				}
 				else
 					Utils::logError("EventManager: Mapmod at position (%d, %d) is out of bounds 0-255.", ec->data[0].Int, ec->data[1].Int);
 			}
@@ -1098,7 +1152,70 @@ bool EventManager::executeEventInternal(Event &ev, bool skip_delay) {
 
 
 bool EventManager::isActive(const Event &e) {
-	return camp->checkRequirementsInVector(e.components);
+	return e.checkRequirements();
+}
+
+/**
+ * Collect the requirement components, with ids resolved and class names interned.
+ * The cheapest checks are placed first, since checking stops at the first one that fails.
+ */
+void EventManager::compileRequirements(const std::vector<EventComponent>& components, std::vector<EventRequirement>& result) {
+	result.clear();
+
+	for (size_t i = 0; i < components.size(); ++i) {
+		const EventComponent& ec = components[i];
+		EventRequirement req;
+		req.type = ec.type;
+
+		switch (ec.type) {
+			case EventComponent::REQUIRES_STATUS:
+			case EventComponent::REQUIRES_NOT_STATUS:
+				req.id = static_cast<size_t>(ec.status);
+				break;
+			case EventComponent::REQUIRES_CURRENCY:
+			case EventComponent::REQUIRES_NOT_CURRENCY:
+			case EventComponent::REQUIRES_LEVEL:
+			case EventComponent::REQUIRES_NOT_LEVEL:
+				req.value = ec.data[0].Int;
+				break;
+			case EventComponent::REQUIRES_ITEM:
+			case EventComponent::REQUIRES_NOT_ITEM:
+				req.id = ec.id;
+				req.value = ec.data[0].Int;
+				break;
+			case EventComponent::REQUIRES_CLASS:
+			case EventComponent::REQUIRES_NOT_CLASS:
+				req.id = symbols->intern(ec.s);
+				break;
+			default:
+				// not a requirement
+				continue;
+		}
+
+		result.push_back(req);
+	}
+
+	std::stable_sort(result.begin(), result.end(), compareRequirementCost);
+}
+
+int EventManager::getRequirementCost(const EventRequirement& req) {
+	switch (req.type) {
+		case EventComponent::REQUIRES_LEVEL:
+		case EventComponent::REQUIRES_NOT_LEVEL:
+		case EventComponent::REQUIRES_CLASS:
+		case EventComponent::REQUIRES_NOT_CLASS:
+			return 0;
+		case EventComponent::REQUIRES_STATUS:
+		case EventComponent::REQUIRES_NOT_STATUS:
+			return 1;
+		default:
+			// currency and items search the inventory
+			return 2;
+	}
+}
+
+bool EventManager::compareRequirementCost(const EventRequirement& a, const EventRequirement& b) {
+	return getRequirementCost(a) < getRequirementCost(b);
 }
 
 void EventManager::executeScript(const std::string& filename, float x, float y) {
@@ -1147,7 +1264,7 @@ void EventManager::executeScript(const std::string& filename, float x, float y)
 
 			if (script_evnt.front().delay.getDuration() > 0) {
 				// handle delayed events
-				mapr->delayed_events.push_back(script_evnt.front());
+				mapr->addDelayedEvent(script_evnt.front());
 			}
 			else if (isActive(script_evnt.front())) {
 				executeEvent(script_evnt.front());
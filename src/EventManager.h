@@ -121,6 +121,18 @@ public:
 	EventComponent();
 };
 
+/**
+ * A requirement component in a compact form that is quick to check
+ */
+class EventRequirement {
+public:
+	int type; // one of the EventComponent::REQUIRES_* types
+	int value; // currency amount, item quantity or level
+	size_t id; // status, item id or class symbol
+
+	EventRequirement();
+};
+
 class Event {
 public:
 	enum {
@@ -143,12 +155,26 @@ public:
 	bool keep_after_trigger; // if this event has been triggered once, should this event be kept? If so, this event can be triggered multiple times.
 	FPoint center;
 	Rect reachable_from;
+	size_t serial; // unique to each event, copies share it. Used by the map's timers to find the event
 
 	Event();
 	~Event();
 
 	EventComponent* getComponent(const int _type);
 	void deleteAllComponents(const int _type);
+	const std::vector<EventRequirement>& getRequirements() const;
+	bool checkRequirements() const;
+
+private:
+	static size_t next_serial;
+
+	// compiled from the components the first time they are checked
+	mutable std::vector<EventRequirement> requirements;
+	mutable bool requirements_compiled;
+
+	// the last result of checkRequirements(), and the campaign version it was checked at
+	mutable bool requirements_met;
+	mutable unsigned requirements_version;
 };
 
 class EventManager {
@@ -160,13 +186,18 @@ public:
 	static bool loadEventComponentString(std::string &key, std::string &val, Event* evnt, EventComponent* ec);
 
 	static bool executeEvent(Event &e);
+	static bool executeMapEvent(Event &e);
 	static bool executeDelayedEvent(Event &e);
 	static bool isActive(const Event &e);
+	static void compileRequirements(const std::vector<EventComponent>& components, std::vector<EventRequirement>& result);
 	static void executeScript(const std::string& filename, float x, float y);
 
 private:
 	static const bool SKIP_DELAY = true;
-	static bool executeEventInternal(Event &e, bool skip_delay);
+	static const bool IN_EVENT_LIST = true;
+	static bool executeEventInternal(Event &e, bool skip_delay, bool in_event_list);
+	static int getRequirementCost(const EventRequirement& req);
+	static bool compareRequirementCost(const EventRequirement& a, const EventRequirement& b);
 	static EventComponent getRandomMapFromFile(const std::string& fname);
 
 };
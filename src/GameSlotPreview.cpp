@@ -115,8 +115,8 @@ void GameSlotPreview::loadGraphics(std::vector<std::string> _img_gfx) {
 			anim->increaseCount(name);
 			animsets.push_back(anim->getAnimationSet(name));
 			animsets.back()->setParent(animationSet);
-			anims.push_back(animsets.back()->getAnimation(activeAnimation->getName()));
-			setAnimation("stance");
+			anims.push_back(animsets.back()->getAnimation(activeAnimation->getID()));
+			setAnimation(SymbolTable::ANIM_STANCE);
 			if(!anims.back()->syncTo(activeAnimation)) {
 				Utils::logError("GameSlotPreview: Error syncing animation in '%s' to 'animations/hero.txt'.", animsets.back()->getName().c_str());
 			}
@@ -128,7 +128,7 @@ void GameSlotPreview::loadGraphics(std::vector<std::string> _img_gfx) {
 	}
 	anim->cleanUp();
 
-	setAnimation("stance");
+	setAnimation(SymbolTable::ANIM_STANCE);
 }
 
 void GameSlotPreview::logic() {
@@ -140,22 +140,28 @@ void GameSlotPreview::logic() {
 	}
 }
 
-void GameSlotPreview::setAnimation(const std::string& name) {
+void GameSlotPreview::setAnimation(SymbolID animation) {
 	if (activeAnimation) {
-		if (name == activeAnimation->getName())
+		if (animation == activeAnimation->getID())
 			return;
 
-		delete activeAnimation;
+		activeAnimation->setDef(animationSet->getAnimationDef(animation));
+	}
+	else {
+		activeAnimation = animationSet->getAnimation(animation);
 	}
-
-	activeAnimation = animationSet->getAnimation(name);
 
 	for (unsigned i=0; i < animsets.size(); i++) {
-		delete anims[i];
-		if (animsets[i])
-			anims[i] = animsets[i]->getAnimation(name);
-		else
+		if (!animsets[i]) {
+			delete anims[i];
 			anims[i] = 0;
+		}
+		else if (anims[i]) {
+			anims[i]->setDef(animsets[i]->getAnimationDef(animation));
+		}
+		else {
+			anims[i] = animsets[i]->getAnimation(animation);
+		}
 	}
 }
 
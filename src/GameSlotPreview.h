@@ -28,6 +28,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #define AVATAR_GRAPHICS_H
 
 #include "CommonIncludes.h"
+#include "SymbolTable.h"
 #include "Utils.h"
 
 class Animation;
@@ -48,7 +49,7 @@ public:
 	GameSlotPreview();
 	~GameSlotPreview();
 
-	void setAnimation(const std::string& name);
+	void setAnimation(SymbolID animation);
 	void setStatBlock(StatBlock *_stats);
 	void setPos(Point _pos);
 	void loadGraphics(std::vector<std::string> _img_gfx);
@@ -897,13 +897,13 @@ void GameStateLoad::setSelectedSlot(int slot) {
 	if (selected_slot != -1 && static_cast<size_t>(selected_slot) < game_slots.size() && game_slots[selected_slot]) {
 		game_slots[selected_slot]->stats.direction = 6;
 		game_slots[selected_slot]->preview_turn_timer.reset(Timer::BEGIN);
-		game_slots[selected_slot]->preview.setAnimation("stance");
+		game_slots[selected_slot]->preview.setAnimation(SymbolTable::ANIM_STANCE);
 	}
 
 	if (slot != -1 && static_cast<size_t>(slot) < game_slots.size() && game_slots[slot]) {
 		game_slots[slot]->stats.direction = 6;
 		game_slots[slot]->preview_turn_timer.reset(Timer::BEGIN);
-		game_slots[slot]->preview.setAnimation("run");
+		game_slots[slot]->preview.setAnimation(SymbolTable::ANIM_RUN);
 	}
 
 	selected_slot = slot;
@@ -322,6 +322,7 @@ void GameStatePlay::checkTeleport() {
 					mapr->collider.unblock(entitym->entities[i]->stats.pos.x, entitym->entities[i]->stats.pos.y);
 					entitym->entities[i]->stats.pos = spawn_pos;
 					mapr->collider.block(entitym->entities[i]->stats.pos.x, entitym->entities[i]->stats.pos.y, MapCollision::IS_ALLY);
+					entitym->grid.update(entitym->entities[i]);
 				}
 			}
 		}
@@ -902,6 +903,9 @@ void GameStatePlay::logic() {
 	checkNotifications();
 	checkCancel();
 
+	// pick up item and level changes from this frame before the map events check their requirements
+	camp->updateVersion();
+
 	mapr->logic(isPaused());
 	mapr->enemies_cleared = entitym->isCleared();
 	quests->logic();
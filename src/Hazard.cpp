@@ -94,6 +94,7 @@ Hazard& Hazard::operator=(const Hazard& other) {
 	power_index = other.power_index;
 
 	pos = other.pos;
+	prev_pos = other.prev_pos;
 	speed = other.speed;
 	pos_offset = other.pos_offset;
 
@@ -112,6 +113,62 @@ Hazard& Hazard::operator=(const Hazard& other) {
 }
 
 Hazard::~Hazard() {
+	release();
+
+	if (!animation_name.empty()) {
+		anim->decreaseCount(animation_name);
+	}
+
+	if (activeAnimation) {
+		delete activeAnimation;
+	}
+
+	anim->cleanUp();
+}
+
+/**
+ * Return the hazard to its initial state so that HazardPool can reuse it.
+ * The collision lists keep their memory, and the animation is kept so that
+ * loadAnimation() can reuse it if the next power has the same one.
+ */
+void Hazard::reset(MapCollision *_collider) {
+	active = true;
+	remove_now = false;
+	hit_wall = false;
+	relative_pos = false;
+	sfx_hit_played = false;
+
+	dmg_min = 0;
+	dmg_max = 0;
+	crit_chance = 0;
+	accuracy = 0;
+	source_type = 0;
+	base_speed = 0;
+	lifespan = 1;
+	animationKind = 0;
+	delay_frames = 0;
+	angle = 0;
+
+	src_stats = NULL;
+	power = NULL;
+	power_index = 0;
+
+	pos = FPoint();
+	speed = FPoint();
+	pos_offset = FPoint();
+	prev_pos = FPoint();
+
+	parent = NULL;
+	children.clear();
+
+	collider = _collider;
+	entitiesCollided.clear();
+}
+
+/**
+ * Detach the hazard from any other hazards it is linked to
+ */
+void Hazard::release() {
 	if (!parent && !children.empty()) {
 		// make the next child the parent for the existing children
 		Hazard* new_parent = children[0];
@@ -136,41 +193,25 @@ Hazard::~Hazard() {
 		}
 	}
 
-	if (!animation_name.empty()) {
-		anim->decreaseCount(animation_name);
-	}
-
-	if (activeAnimation) {
-		delete activeAnimation;
-	}
-
-	anim->cleanUp();
+	parent = NULL;
+	children.clear();
+	entitiesCollided.clear();
 }
 
+/**
+ * HazardManager advances the delay, lifespan and speed-based movement of all hazards
+ * before this is called, and doesn't call this for hazards that are on delay.
+ */
 void Hazard::logic() {
-
-	// if the hazard is on delay, take no action
-	if (delay_frames > 0) {
-		delay_frames--;
-		return;
-	}
-
-	// handle tickers
-	if (lifespan > 0) lifespan--;
-
 	if (power->expire_with_caster && !src_stats->alive)
 		lifespan = 0;
 
 	if (activeAnimation)
 		activeAnimation->advanceFrame();
 
-	prev_pos = pos;
-
 	// handle movement
 	bool check_collide = false;
 	if (!(speed.x == 0 && speed.y == 0)) {
-		pos.x += speed.x;
-		pos.y += speed.y;
 		check_collide = true;
 	}
 	else if (!(pos_offset.x == 0 && pos_offset.y == 0)) {
@@ -223,6 +264,12 @@ void Hazard::reflect() {
 }
 
 void Hazard::loadAnimation(const std::string &s) {
+	if (s == animation_name) {
+		if (activeAnimation)
+			activeAnimation->reset();
+		return;
+	}
+
 	if (!animation_name.empty()) {
 		anim->decreaseCount(animation_name);
 	}
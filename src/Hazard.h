@@ -43,6 +43,9 @@ public:
 	Hazard & operator= (const Hazard& other);
 	~Hazard();
 
+	void reset(MapCollision *_collider);
+	void release();
+
 	void logic();
 	bool hasEntity(Entity*);
 	void addEntity(Entity*);
@@ -69,7 +72,7 @@ public:
 	float angle; // in radians
 
 	StatBlock *src_stats;
-	Power *power;
+	const Power *power;
 	PowerID power_index;
 
 	FPoint pos;
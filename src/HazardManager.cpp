@@ -46,22 +46,29 @@ void HazardManager::logic() {
 
 	// remove all hazards with lifespan 0.  Most hazards still display their last frame.
 	for (size_t i=h.size(); i>0; i--) {
-		if (h[i-1]->lifespan == 0) {
-			delete h[i-1];
-			h.erase(h.begin()+(i-1));
+		if (motion.lifespan[i-1] == 0) {
+			removeHazard(i-1);
 		}
 	}
 
 	checkNewHazards();
 
+	advanceMotion();
+
 	// handle single-frame transforms
 	for (size_t i=h.size(); i>0; i--) {
+		storeMotion(i-1);
+
+		// if the hazard is on delay, take no action
+		if (motion.waiting[i-1])
+			continue;
+
 		h[i-1]->logic();
+		loadMotion(i-1);
 
 		// remove all hazards that need to die immediately (e.g. exit the map)
 		if (h[i-1]->remove_now) {
-			delete h[i-1];
-			h.erase(h.begin()+(i-1));
+			removeHazard(i-1);
 			continue;
 		}
 
@@ -87,23 +94,26 @@ void HazardManager::logic() {
 	}
 
 	// handle collisions
+	entitym->grid.sync(entitym->entities);
+	std::vector<Entity*> targets;
+
 	for (size_t i=0; i<h.size(); i++) {
 		if (h[i]->isDangerousNow()) {
+			// test everything the hazard passed through since the last frame, so fast missiles can't skip over targets
+			entitym->grid.getInSweptRadius(h[i]->prev_pos, h[i]->pos, h[i]->power->radius, targets);
 
 			// process hazards that can hurt enemies
 			if (h[i]->source_type != Power::SOURCE_TYPE_ENEMY) { //hero or neutral sources
-				for (unsigned int eindex = 0; eindex < entitym->entities.size(); eindex++) {
+				for (size_t eindex = 0; eindex < targets.size(); eindex++) {
 
 					// only check living enemies
-					if (entitym->entities[eindex]->stats.hp > 0 && h[i]->active && (entitym->entities[eindex]->stats.hero_ally == h[i]->power->target_party)) {
-						if (Utils::isWithinRadius(h[i]->pos, h[i]->power->radius, entitym->entities[eindex]->stats.pos)) {
-							if (!h[i]->hasEntity(entitym->entities[eindex])) {
-								// hit!
-								h[i]->addEntity(entitym->entities[eindex]);
-								hitEntity(i, entitym->entities[eindex]->takeHit(*h[i]));
-								if (!h[i]->power->beacon) {
-									last_enemy = entitym->entities[eindex];
-								}
+					if (targets[eindex]->stats.hp > 0 && h[i]->active && (targets[eindex]->stats.hero_ally == h[i]->power->target_party)) {
+						if (!h[i]->hasEntity(targets[eindex])) {
+							// hit!
+							h[i]->addEntity(targets[eindex]);
+							hitEntity(i, targets[eindex]->takeHit(*h[i]));
+							if (!h[i]->power->beacon) {
+								last_enemy = targets[eindex];
 							}
 						}
 					}
@@ -114,7 +124,8 @@ void HazardManager::logic() {
 			// process hazards that can hurt the hero
 			if (h[i]->source_type != Power::SOURCE_TYPE_HERO && h[i]->source_type != Power::SOURCE_TYPE_ALLY) { //enemy or neutral sources
 				if (pc->stats.hp > 0 && h[i]->active) {
-					if (Utils::isWithinRadius(h[i]->pos, h[i]->power->radius, pc->stats.pos)) {
+					FPoint closest = Utils::calcClosestPointOnSegment(h[i]->prev_pos, h[i]->pos, pc->stats.pos);
+					if (Utils::isWithinRadius(closest, h[i]->power->radius, pc->stats.pos)) {
 						if (!h[i]->hasEntity(pc)) {
 							// hit!
 							h[i]->addEntity(pc);
@@ -124,25 +135,83 @@ void HazardManager::logic() {
 				}
 
 				//now process allies
-				for (unsigned int eindex = 0; eindex < entitym->entities.size(); eindex++) {
+				for (size_t eindex = 0; eindex < targets.size(); eindex++) {
 					// only check living allies
-					if (entitym->entities[eindex]->stats.hp > 0 && h[i]->active && entitym->entities[eindex]->stats.hero_ally) {
-						if (Utils::isWithinRadius(h[i]->pos, h[i]->power->radius, entitym->entities[eindex]->stats.pos)) {
-							if (!h[i]->hasEntity(entitym->entities[eindex])) {
-								// hit!
-								h[i]->addEntity(entitym->entities[eindex]);
-								hitEntity(i, entitym->entities[eindex]->takeHit(*h[i]));
-							}
+					if (targets[eindex]->stats.hp > 0 && h[i]->active && targets[eindex]->stats.hero_ally) {
+						if (!h[i]->hasEntity(targets[eindex])) {
+							// hit!
+							h[i]->addEntity(targets[eindex]);
+							hitEntity(i, targets[eindex]->takeHit(*h[i]));
 						}
 					}
 				}
 
 			}
 
+			// being hit can change the hazard's movement (e.g. reflected missiles)
+			loadMotion(i);
 		}
 	}
 }
 
+/**
+ * Advance the delay, lifespan and position of every hazard.
+ * Hazards that are on delay keep their lifespan and position.
+ */
+void HazardManager::advanceMotion() {
+	size_t count = h.size();
+
+	for (size_t i = 0; i < count; ++i) {
+		// collision checks cover the path from prev_pos to pos
+		motion.prev_x[i] = motion.pos_x[i];
+		motion.prev_y[i] = motion.pos_y[i];
+
+		int is_waiting = motion.delay_frames[i] > 0;
+		int is_ticking = !is_waiting && motion.lifespan[i] > 0;
+		float step = static_cast<float>(1 - is_waiting);
+
+		motion.waiting[i] = static_cast<unsigned char>(is_waiting);
+		motion.delay_frames[i] -= is_waiting;
+		motion.lifespan[i] -= is_ticking;
+		motion.pos_x[i] += motion.speed_x[i] * step;
+		motion.pos_y[i] += motion.speed_y[i] * step;
+	}
+}
+
+/**
+ * Copy the movement state of a hazard into the motion arrays, after it was changed by the hazard itself
+ */
+void HazardManager::loadMotion(size_t index) {
+	const Hazard* haz = h[index];
+	motion.pos_x[index] = haz->pos.x;
+	motion.pos_y[index] = haz->pos.y;
+	motion.prev_x[index] = haz->prev_pos.x;
+	motion.prev_y[index] = haz->prev_pos.y;
+	motion.speed_x[index] = haz->speed.x;
+	motion.speed_y[index] = haz->speed.y;
+	motion.lifespan[index] = haz->lifespan;
+	motion.delay_frames[index] = haz->delay_frames;
+}
+
+/**
+ * Copy the movement state from the motion arrays back to a hazard
+ */
+void HazardManager::storeMotion(size_t index) {
+	Hazard* haz = h[index];
+	haz->pos.x = motion.pos_x[index];
+	haz->pos.y = motion.pos_y[index];
+	haz->prev_pos.x = motion.prev_x[index];
+	haz->prev_pos.y = motion.prev_y[index];
+	haz->lifespan = motion.lifespan[index];
+	haz->delay_frames = motion.delay_frames[index];
+}
+
+void HazardManager::removeHazard(size_t index) {
+	powers->hazard_pool.destroy(h[index]);
+	h.erase(h.begin() + index);
+	motion.erase(index);
+}
+
 void HazardManager::hitEntity(size_t index, const bool hit) {
 	if (!hit) return;
 
@@ -171,6 +240,7 @@ void HazardManager::checkNewHazards() {
 		powers->hazards.pop();
 
 		h.push_back(new_haz);
+		motion.add(new_haz);
 	}
 }
 
@@ -179,9 +249,10 @@ void HazardManager::checkNewHazards() {
  */
 void HazardManager::handleNewMap() {
 	for (unsigned int i = 0; i < h.size(); i++) {
-		delete h[i];
+		powers->hazard_pool.destroy(h[i]);
 	}
 	h.clear();
+	motion.clear();
 	last_enemy = NULL;
 }
 
@@ -198,7 +269,43 @@ void HazardManager::addRenders(std::vector<Renderable> &r, std::vector<Renderabl
 
 HazardManager::~HazardManager() {
 	for (unsigned int i = 0; i < h.size(); i++)
-		delete h[i];
+		powers->hazard_pool.destroy(h[i]);
 	// h.clear(); not needed in destructor
 	last_enemy = NULL;
 }
+
+void HazardManager::HazardMotion::add(const Hazard* haz) {
+	pos_x.push_back(haz->pos.x);
+	pos_y.push_back(haz->pos.y);
+	prev_x.push_back(haz->prev_pos.x);
+	prev_y.push_back(haz->prev_pos.y);
+	speed_x.push_back(haz->speed.x);
+	speed_y.push_back(haz->speed.y);
+	lifespan.push_back(haz->lifespan);
+	delay_frames.push_back(haz->delay_frames);
+	waiting.push_back(0);
+}
+
+void HazardManager::HazardMotion::erase(size_t index) {
+	pos_x.erase(pos_x.begin() + index);
+	pos_y.erase(pos_y.begin() + index);
+	prev_x.erase(prev_x.begin() + index);
+	prev_y.erase(prev_y.begin() + index);
+	speed_x.erase(speed_x.begin() + index);
+	speed_y.erase(speed_y.begin() + index);
+	lifespan.erase(lifespan.begin() + index);
+	delay_frames.erase(delay_frames.begin() + index);
+	waiting.erase(waiting.begin() + index);
+}
+
+void HazardManager::HazardMotion::clear() {
+	pos_x.clear();
+	pos_y.clear();
+	prev_x.clear();
+	prev_y.clear();
+	speed_x.clear();
+	speed_y.clear();
+	lifespan.clear();
+	delay_frames.clear();
+	waiting.clear();
+}
@@ -34,7 +34,35 @@ class Hazard;
 
 class HazardManager {
 private:
+	/**
+	 * The movement state of the hazards in 'h', stored by field so that every hazard
+	 * can be advanced in one tight loop. Index i belongs to h[i].
+	 * These values are copied back to the hazards before any per-hazard logic runs.
+	 */
+	class HazardMotion {
+	public:
+		void add(const Hazard* haz);
+		void erase(size_t index);
+		void clear();
+
+		std::vector<float> pos_x;
+		std::vector<float> pos_y;
+		std::vector<float> prev_x;
+		std::vector<float> prev_y;
+		std::vector<float> speed_x;
+		std::vector<float> speed_y;
+		std::vector<int> lifespan;
+		std::vector<int> delay_frames;
+		std::vector<unsigned char> waiting; // the hazard was on delay this frame
+	};
+
 	void hitEntity(size_t index, const bool hit);
+	void removeHazard(size_t index);
+	void advanceMotion();
+	void loadMotion(size_t index);
+	void storeMotion(size_t index);
+
+	HazardMotion motion;
 
 public:
 	HazardManager();
@@ -0,0 +1,59 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class HazardPool
+ *
+ * Keeps expired hazards around so that new ones can reuse them instead of
+ * being allocated. Reused hazards keep the memory of their collision lists
+ * and their animation.
+ */
+
+#include "Hazard.h"
+#include "HazardPool.h"
+
+HazardPool::HazardPool()
+	: free_hazards()
+{
+}
+
+HazardPool::~HazardPool() {
+	for (size_t i = 0; i < free_hazards.size(); ++i) {
+		delete free_hazards[i];
+	}
+}
+
+Hazard* HazardPool::create(MapCollision *collider) {
+	if (free_hazards.empty())
+		return new Hazard(collider);
+
+	Hazard* haz = free_hazards.back();
+	free_hazards.pop_back();
+	haz->reset(collider);
+	return haz;
+}
+
+/**
+ * The hazard is unlinked from any repeater group and kept for reuse
+ */
+void HazardPool::destroy(Hazard *haz) {
+	if (!haz)
+		return;
+
+	haz->release();
+	free_hazards.push_back(haz);
+}
@@ -0,0 +1,46 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class HazardPool
+ *
+ * Keeps expired hazards around so that new ones can reuse them instead of
+ * being allocated. Reused hazards keep the memory of their collision lists
+ * and their animation.
+ */
+
+#ifndef HAZARD_POOL_H
+#define HAZARD_POOL_H
+
+#include "CommonIncludes.h"
+
+class Hazard;
+class MapCollision;
+
+class HazardPool {
+public:
+	HazardPool();
+	~HazardPool();
+
+	Hazard* create(MapCollision *collider);
+	void destroy(Hazard *haz);
+
+private:
+	std::vector<Hazard*> free_hazards;
+};
+
+#endif
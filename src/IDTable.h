@@ -0,0 +1,91 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class IDTable
+ *
+ * Stores definitions (powers, items, etc) keyed by their integer id.
+ * Entries are kept contiguously, and a flat array maps each id to its entry, so a
+ * lookup is two array reads instead of a tree search.
+ * Looking up an id that was never defined returns a default entry without adding it.
+ */
+
+#ifndef ID_TABLE_H
+#define ID_TABLE_H
+
+#include "CommonIncludes.h"
+
+template <typename T>
+class IDTable {
+public:
+	IDTable()
+		: slots()
+		, entries()
+		, fallback()
+	{}
+
+	const T& operator[](size_t id) const {
+		if (id < slots.size() && slots[id] != NO_SLOT)
+			return entries[slots[id]];
+		return fallback;
+	}
+
+	/**
+	 * Get an entry for modification, adding it if it doesn't exist yet.
+	 * Adding entries may move the others, so references to them should not be kept.
+	 */
+	T& edit(size_t id) {
+		if (id >= slots.size())
+			slots.resize(id+1, NO_SLOT);
+
+		if (slots[id] == NO_SLOT) {
+			slots[id] = entries.size();
+			entries.push_back(T());
+		}
+
+		return entries[slots[id]];
+	}
+
+	bool contains(size_t id) const {
+		return id < slots.size() && slots[id] != NO_SLOT;
+	}
+
+	/**
+	 * All ids are below this value. Used to visit entries in id order.
+	 */
+	size_t getIDLimit() const {
+		return slots.size();
+	}
+
+	bool empty() const {
+		return entries.empty();
+	}
+
+	void clear() {
+		slots.clear();
+		entries.clear();
+	}
+
+private:
+	static const size_t NO_SLOT = static_cast<size_t>(-1);
+
+	std::vector<size_t> slots;
+	std::vector<T> entries;
+	T fallback;
+};
+
+#endif
@@ -138,11 +138,11 @@ void ItemManager::loadItems(const std::string& filename) {
 			// @ATTR id|item_id|An uniq id of the item used as reference from other classes.
 			id_line = true;
 			id = Parse::toItemID(infile.val);
-			items[id] = Item();
+			items.edit(id) = Item();
 
 			// set the max quantity if it has not been done yet
-			if (items[id].max_quantity == INT_MAX)
-				items[id].max_quantity = 1;
+			if (items.edit(id).max_quantity == INT_MAX)
+				items.edit(id).max_quantity = 1;
 
 			clear_req_stat = true;
 			clear_bonus = true;
@@ -157,44 +157,46 @@ void ItemManager::loadItems(const std::string& filename) {
 		}
 		if (id_line) continue;
 
+		Item& item = items.edit(id);
+
 		if (infile.key == "name") {
 			// @ATTR name|string|Item name displayed on long and short tooltips.
-			items[id].name = msg->get(infile.val);
-			items[id].has_name = true;
+			item.name = msg->get(infile.val);
+			item.has_name = true;
 		}
 		else if (infile.key == "flavor")
 			// @ATTR flavor|string|A description of the item.
-			items[id].flavor = msg->get(infile.val);
+			item.flavor = msg->get(infile.val);
 		else if (infile.key == "level")
 			// @ATTR level|int|The item's level. Has no gameplay impact. (Deprecated?)
-			items[id].level = Parse::toInt(infile.val);
+			item.level = Parse::toInt(infile.val);
 		else if (infile.key == "icon") {
 			// @ATTR icon|icon_id|An id for the icon to display for this item.
-			items[id].icon = Parse::toInt(infile.val);
+			item.icon = Parse::toInt(infile.val);
 		}
 		else if (infile.key == "book") {
 			// @ATTR book|filename|A book file to open when this item is activated.
-			items[id].book = infile.val;
+			item.book = infile.val;
 		}
 		else if (infile.key == "book_is_readable") {
 			// @ATTR book_is_readable|bool|If true, "read" is displayed in the tooltip instead of "use". Defaults to true.
-			items[id].book_is_readable = Parse::toBool(infile.val);
+			item.book_is_readable = Parse::toBool(infile.val);
 		}
 		else if (infile.key == "quality") {
 			// @ATTR quality|predefined_string|Item quality matching an id in items/qualities.txt
-			items[id].quality = infile.val;
+			item.quality = infile.val;
 		}
 		else if (infile.key == "item_type") {
 			// @ATTR item_type|predefined_string|Equipment slot matching an id in items/types.txt
-			items[id].type = infile.val;
+			item.type = infile.val;
 		}
 		else if (infile.key == "equip_flags") {
 			// @ATTR equip_flags|list(predefined_string)|A comma separated list of flags to set when this item is equipped. See engine/equip_flags.txt.
-			items[id].equip_flags.clear();
+			item.equip_flags.clear();
 			std::string flag = Parse::popFirstString(infile.val);
 
 			while (flag != "") {
-				items[id].equip_flags.push_back(flag);
+				item.equip_flags.push_back(flag);
 				flag = Parse::popFirstString(infile.val);
 			}
 		}
@@ -214,154 +216,154 @@ void ItemManager::loadItems(const std::string& filename) {
 				infile.error("ItemManager: '%s' is not a known damage type id.", dmg_type_str.c_str());
 			}
 			else {
-				items[id].base_dmg[dmg_type].min = Parse::popFirstFloat(infile.val);
+				item.base_dmg[dmg_type].min = Parse::popFirstFloat(infile.val);
 				if (infile.val.length() > 0)
-					items[id].base_dmg[dmg_type].max = Parse::popFirstFloat(infile.val);
+					item.base_dmg[dmg_type].max = Parse::popFirstFloat(infile.val);
 				else
-					items[id].base_dmg[dmg_type].max = items[id].base_dmg[dmg_type].min;
+					item.base_dmg[dmg_type].max = item.base_dmg[dmg_type].min;
 			}
 		}
 		else if (infile.key == "abs") {
 			// @ATTR abs|float, float : Min, Max|Defines the item absorb value, if only min is specified the absorb value is fixed.
-			items[id].base_abs.min = Parse::popFirstFloat(infile.val);
+			item.base_abs.min = Parse::popFirstFloat(infile.val);
 			if (infile.val.length() > 0)
-				items[id].base_abs.max = Parse::popFirstFloat(infile.val);
+				item.base_abs.max = Parse::popFirstFloat(infile.val);
 			else
-				items[id].base_abs.max = items[id].base_abs.min;
+				item.base_abs.max = item.base_abs.min;
 		}
 		else if (infile.key == "requires_level") {
 			// @ATTR requires_level|int|The hero's level must match or exceed this value in order to equip this item.
-			items[id].requires_level = Parse::toInt(infile.val);
+			item.requires_level = Parse::toInt(infile.val);
 		}
 		else if (infile.key == "requires_stat") {
 			// @ATTR requires_stat|repeatable(predefined_string, int) : Primary stat name, Value|Make item require specific stat level ex. requires_stat=physical,6 will require hero to have level 6 in physical stats
 			if (clear_req_stat) {
-				items[id].requires_stat.clear();
+				item.requires_stat.clear();
 				clear_req_stat = false;
 			}
 
 			std::string s = Parse::popFirstString(infile.val);
 			size_t req_stat_index = eset->primary_stats.getIndexByID(s);
 			if (req_stat_index != eset->primary_stats.list.size())
-				items[id].requires_stat[req_stat_index] = Parse::popFirstInt(infile.val);
+				item.requires_stat[req_stat_index] = Parse::popFirstInt(infile.val);
 			else
 				infile.error("ItemManager: '%s' is not a valid primary stat.", s.c_str());
 		}
 		else if (infile.key == "requires_class") {
 			// @ATTR requires_class|predefined_string|The hero's base class (engine/classes.txt) must match for this item to be equipped.
-			items[id].requires_class = infile.val;
+			item.requires_class = infile.val;
 		}
 		else if (infile.key == "bonus") {
 			// @ATTR bonus|repeatable(stat_id, float) : Stat ID, Value|Adds a bonus to the item by stat ID, example: bonus=hp,50
 			if (clear_bonus) {
-				items[id].bonus.clear();
+				item.bonus.clear();
 				clear_bonus = false;
 			}
 			BonusData bdata;
 			parseBonus(bdata, infile);
-			items[id].bonus.push_back(bdata);
+			item.bonus.push_back(bdata);
 		}
 		else if (infile.key == "bonus_power_level") {
 			// @ATTR bonus_power_level|repeatable(power_id, int) : Base power, Bonus levels|Grants bonus levels to a given base power.
 			BonusData bdata;
 			bdata.power_id = Parse::toPowerID(Parse::popFirstString(infile.val));
 			bdata.value = Parse::popFirstFloat(infile.val);
-			items[id].bonus.push_back(bdata);
+			item.bonus.push_back(bdata);
 		}
 		else if (infile.key == "soundfx") {
 			// @ATTR soundfx|filename|Sound effect filename to play for the specific item.
-			items[id].sfx = infile.val;
-			items[id].sfx_id = snd->load(items[id].sfx, "ItemManager");
+			item.sfx = infile.val;
+			item.sfx_id = snd->load(item.sfx, "ItemManager");
 		}
 		else if (infile.key == "gfx")
 			// @ATTR gfx|filename|Filename of an animation set to display when the item is equipped.
-			items[id].gfx = infile.val;
+			item.gfx = infile.val;
 		else if (infile.key == "loot_animation") {
 			// @ATTR loot_animation|repeatable(filename, int, int) : Loot image, Min quantity, Max quantity|Specifies the loot animation file for the item. The max quantity, or both quantity values, may be omitted.
 			if (clear_loot_anim) {
-				items[id].loot_animation.clear();
+				item.loot_animation.clear();
 				clear_loot_anim = false;
 			}
 			LootAnimation la;
 			la.name = Parse::popFirstString(infile.val);
 			la.low = Parse::popFirstInt(infile.val);
 			la.high = Parse::popFirstInt(infile.val);
-			items[id].loot_animation.push_back(la);
+			item.loot_animation.push_back(la);
 		}
 		else if (infile.key == "power") {
 			// @ATTR power|power_id|Adds a specific power to the item which makes it usable as a power and can be placed in action bar.
 			if (Parse::toInt(infile.val) > 0)
-				items[id].power = Parse::toInt(infile.val);
+				item.power = Parse::toInt(infile.val);
 			else
 				infile.error("ItemManager: Power index out of bounds 1-%d, skipping power.", INT_MAX);
 		}
 		else if (infile.key == "replace_power") {
 			// @ATTR replace_power|repeatable(int, int) : Old power, New power|Replaces the old power id with the new power id in the action bar when equipped.
 			if (clear_replace_power) {
-				items[id].replace_power.clear();
+				item.replace_power.clear();
 				clear_replace_power = false;
 			}
 			std::pair<PowerID, PowerID> power_ids;
 			power_ids.first = Parse::toPowerID(Parse::popFirstString(infile.val));
 			power_ids.second = Parse::toPowerID(Parse::popFirstString(infile.val));
-			items[id].replace_power.push_back(power_ids);
+			item.replace_power.push_back(power_ids);
 		}
 		else if (infile.key == "power_desc")
 			// @ATTR power_desc|string|A string describing the additional power.
-			items[id].power_desc = msg->get(infile.val);
+			item.power_desc = msg->get(infile.val);
 		else if (infile.key == "price")
 			// @ATTR price|int|The amount of currency the item costs, if set to 0 the item cannot be sold.
-			items[id].price = Parse::toInt(infile.val);
+			item.price = Parse::toInt(infile.val);
 		else if (infile.key == "price_per_level")
 			// @ATTR price_per_level|int|Additional price for each player level above 1
-			items[id].price_per_level = Parse::toInt(infile.val);
+			item.price_per_level = Parse::toInt(infile.val);
 		else if (infile.key == "price_sell")
 			// @ATTR price_sell|int|The amount of currency the item is sold for, if set to 0 the sell prices is prices*vendor_ratio.
-			items[id].price_sell = Parse::toInt(infile.val);
+			item.price_sell = Parse::toInt(infile.val);
 		else if (infile.key == "max_quantity")
 			// @ATTR max_quantity|int|Max item count per stack.
-			items[id].max_quantity = Parse::toInt(infile.val);
+			item.max_quantity = Parse::toInt(infile.val);
 		else if (infile.key == "pickup_status")
 			// @ATTR pickup_status|string|Set a campaign status when item is picked up, this is used for quest items.
-			items[id].pickup_status = infile.val;
+			item.pickup_status = infile.val;
 		else if (infile.key == "stepfx")
 			// @ATTR stepfx|predefined_string|Sound effect when walking, this applies only to armors.
-			items[id].stepfx = infile.val;
+			item.stepfx = infile.val;
 		else if (infile.key == "disable_slots") {
 			// @ATTR disable_slots|list(predefined_string)|A comma separated list of equip slot types to disable when this item is equipped.
-			items[id].disable_slots.clear();
+			item.disable_slots.clear();
 			std::string slot_type = Parse::popFirstString(infile.val);
 
 			while (slot_type != "") {
-				items[id].disable_slots.push_back(slot_type);
+				item.disable_slots.push_back(slot_type);
 				slot_type = Parse::popFirstString(infile.val);
 			}
 		}
 		else if (infile.key == "quest_item") {
 			// @ATTR quest_item|bool|If true, this item is a quest item and can not be dropped or sold. The item also can't be stashed, unless the no_stash property is set to something other than "all".
-			items[id].quest_item = Parse::toBool(infile.val);
+			item.quest_item = Parse::toBool(infile.val);
 
 			// for legacy reasons, quest items can't be stashed by default
-			if (items[id].no_stash == Item::NO_STASH_NULL)
-				items[id].no_stash = Item::NO_STASH_ALL;
+			if (item.no_stash == Item::NO_STASH_NULL)
+				item.no_stash = Item::NO_STASH_ALL;
 		}
 		else if (infile.key == "no_stash") {
 			// @ATTR no_stash|["ignore", "private", "shared", "all"]|If not set to 'ignore', this item will not be able to be put in the corresponding stash.
 			std::string temp = Parse::popFirstString(infile.val);
 			if (temp == "ignore")
-				items[id].no_stash = Item::NO_STASH_IGNORE;
+				item.no_stash = Item::NO_STASH_IGNORE;
 			else if (temp == "private")
-				items[id].no_stash = Item::NO_STASH_PRIVATE;
+				item.no_stash = Item::NO_STASH_PRIVATE;
 			else if (temp == "shared")
-				items[id].no_stash = Item::NO_STASH_SHARED;
+				item.no_stash = Item::NO_STASH_SHARED;
 			else if (temp == "all")
-				items[id].no_stash = Item::NO_STASH_ALL;
+				item.no_stash = Item::NO_STASH_ALL;
 			else
 				infile.error("ItemManager: '%s' is not a valid value for 'no_stash'. Use 'ignore', 'private', 'shared', or 'all'.", temp.c_str());
 		}
 		else if (infile.key == "script") {
 			// @ATTR script|filename|Loads and executes a script file when the item is activated from the player's inventory.
-			items[id].script = Parse::popFirstString(infile.val);
+			item.script = Parse::popFirstString(infile.val);
 		}
 		else {
 			infile.error("ItemManager: '%s' is not a valid key.", infile.key.c_str());
@@ -371,10 +373,9 @@ void ItemManager::loadItems(const std::string& filename) {
 	infile.close();
 
 	// normal items can be stored in either stash
-	std::map<ItemID, Item>::iterator item_it;
-	for (item_it = items.begin(); item_it != items.end(); ++item_it) {
-		if (item_it->second.no_stash == Item::NO_STASH_NULL) {
-			item_it->second.no_stash = Item::NO_STASH_IGNORE;
+	for (ItemID i = 0; i < items.getIDLimit(); ++i) {
+		if (items.contains(i) && items[i].no_stash == Item::NO_STASH_NULL) {
+			items.edit(i).no_stash = Item::NO_STASH_IGNORE;
 		}
 	}
 }
@@ -471,7 +472,7 @@ void ItemManager::loadQualities(const std::string& filename) {
 
 std::string ItemManager::getItemName(ItemID id) {
 	if (!items[id].has_name)
-		items[id].name = msg->get("Unknown Item");
+		return msg->get("Unknown Item");
 
 	return items[id].name;
 }
@@ -534,7 +535,7 @@ void ItemManager::loadSets(const std::string& filename) {
 			id = Parse::toSizeT(infile.val);
 
 			if (id > 0) {
-				item_sets[id] = ItemSet();
+				item_sets.edit(id) = ItemSet();
 			}
 
 			clear_bonus = true;
@@ -547,35 +548,37 @@ void ItemManager::loadSets(const std::string& filename) {
 		}
 		if (id_line) continue;
 
+		ItemSet& item_set = item_sets.edit(id);
+
 		if (infile.key == "name") {
 			// @ATTR name|string|Name of the item set.
-			item_sets[id].name = msg->get(infile.val);
+			item_set.name = msg->get(infile.val);
 		}
 		else if (infile.key == "items") {
 			// @ATTR items|list(item_id)|List of item id's that is part of the set.
-			item_sets[id].items.clear();
+			item_set.items.clear();
 			std::string item_id = Parse::popFirstString(infile.val);
 			while (item_id != "") {
 				ItemID temp_id = Parse::toItemID(item_id);
-				items[temp_id].set = id;
-				item_sets[id].items.push_back(temp_id);
+				items.edit(temp_id).set = id;
+				item_set.items.push_back(temp_id);
 				item_id = Parse::popFirstString(infile.val);
 			}
 		}
 		else if (infile.key == "color") {
 			// @ATTR color|color|A specific of color for the set.
-			item_sets[id].color = Parse::toRGB(infile.val);
+			item_set.color = Parse::toRGB(infile.val);
 		}
 		else if (infile.key == "bonus") {
 			// @ATTR bonus|repeatable(int, stat_id, float) : Required set item count, Stat ID, Value|Bonus to append to items in the set.
 			if (clear_bonus) {
-				item_sets[id].bonus.clear();
+				item_set.bonus.clear();
 				clear_bonus = false;
 			}
 			SetBonusData bonus;
 			bonus.requirement = Parse::popFirstInt(infile.val);
 			parseBonus(bonus, infile);
-			item_sets[id].bonus.push_back(bonus);
+			item_set.bonus.push_back(bonus);
 		}
 		else if (infile.key == "bonus_power_level") {
 			// @ATTR bonus_power_level|repeatable(int, power_id, int) : Required set item count, Base power, Bonus levels|Grants bonus levels to a given base power.
@@ -583,7 +586,7 @@ void ItemManager::loadSets(const std::string& filename) {
 			bonus.requirement = Parse::popFirstInt(infile.val);
 			bonus.power_id = Parse::toPowerID(Parse::popFirstString(infile.val));
 			bonus.value = Parse::popFirstFloat(infile.val);
-			item_sets[id].bonus.push_back(bonus);
+			item_set.bonus.push_back(bonus);
 		}
 		else {
 			infile.error("ItemManager: '%s' is not a valid key.", infile.key.c_str());
@@ -673,7 +676,7 @@ void ItemManager::parseBonus(BonusData& bdata, FileParser& infile) {
 	infile.error("ItemManager: Unknown bonus type '%s'.", bonus_str.c_str());
 }
 
-void ItemManager::getBonusString(std::stringstream& ss, BonusData* bdata) {
+void ItemManager::getBonusString(std::stringstream& ss, const BonusData* bdata) {
 	if (bdata->is_speed) {
 		ss << msg->getv("%s%% Speed", Utils::floatToString(bdata->value, eset->number_format.item_tooltips).c_str());
 		return;
@@ -836,7 +839,7 @@ TooltipData ItemManager::getTooltip(ItemStack stack, StatBlock *stats, int conte
 	while (bonus_counter < items[stack.item].bonus.size()) {
 		ss.str("");
 
-		BonusData* bdata = &items[stack.item].bonus[bonus_counter];
+		const BonusData* bdata = &items[stack.item].bonus[bonus_counter];
 
 		if (bdata->is_speed || bdata->is_attack_speed) {
 			if (bdata->value >= 100)
@@ -878,7 +881,7 @@ TooltipData ItemManager::getTooltip(ItemStack stack, StatBlock *stats, int conte
 	}
 
 	// base stat requirement
-	std::map<size_t, int>::iterator it;
+	std::map<size_t, int>::const_iterator it;
 	for (it = items[stack.item].requires_stat.begin(); it != items[stack.item].requires_stat.end(); ++it) {
 		if (it->second > 0) {
 			if (stats->get_primary(it->first) < it->second)
@@ -1035,7 +1038,7 @@ bool ItemManager::requirementsMet(const StatBlock *stats, ItemID item) {
 	}
 
 	// base stats
-	std::map<size_t, int>::iterator it;
+	std::map<size_t, int>::const_iterator it;
 	for (it = items[item].requires_stat.begin(); it != items[item].requires_stat.end(); ++it) {
 		if (stats->get_primary(it->first) < it->second)
 			return false;
@@ -1094,7 +1097,7 @@ void ItemStack::clear() {
 	can_buyback = false;
 }
 
-int Item::getPrice(bool use_vendor_ratio) {
+int Item::getPrice(bool use_vendor_ratio) const {
 	int new_price = price + (price_per_level * (pc->stats.level - 1));
 	if (new_price == 0)
 		return new_price;
@@ -1113,7 +1116,7 @@ int Item::getPrice(bool use_vendor_ratio) {
 	return std::max(new_price, 1);
 }
 
-int Item::getSellPrice(bool is_new_buyback) {
+int Item::getSellPrice(bool is_new_buyback) const {
 	int new_price = 0;
 	NPC* vendor_npc = ((menu && menu->vendor && menu->vendor->visible) ? menu->vendor->npc : NULL);
 
@@ -27,6 +27,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #define ITEM_MANAGER_H
 
 #include "CommonIncludes.h"
+#include "IDTable.h"
 #include "Utils.h"
 
 class FileParser;
@@ -142,8 +143,8 @@ public:
 	int no_stash;
 	std::string script;
 
-	int getPrice(bool use_vendor_ratio);
-	int getSellPrice(bool is_new_buyback);
+	int getPrice(bool use_vendor_ratio) const;
+	int getSellPrice(bool is_new_buyback) const;
 
 	Item();
 	~Item() {
@@ -208,7 +209,7 @@ protected:
 private:
 	void loadAll();
 	void parseBonus(BonusData& bdata, FileParser& infile);
-	void getBonusString(std::stringstream& ss, BonusData* bdata);
+	void getBonusString(std::stringstream& ss, const BonusData* bdata);
 	void getTooltipInputHint(TooltipData& tip, ItemStack stack, int context);
 
 public:
@@ -233,9 +234,9 @@ public:
 	int getItemIconOverlay(size_t id);
 	bool requirementsMet(const StatBlock *stats, ItemID item);
 
-	std::map<ItemID, Item> items;
+	IDTable<Item> items;
 	std::vector<ItemType> item_types;
-	std::map<ItemSetID, ItemSet> item_sets;
+	IDTable<ItemSet> item_sets;
 	std::vector<ItemQuality> item_qualities;
 };
 
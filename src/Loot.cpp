@@ -31,7 +31,8 @@ Loot::Loot()
 	, tip_visible(false)
 	, dropped_by_hero(false)
 	, on_ground(false)
-	, sound_played(false) {
+	, sound_played(false)
+	, serial(0) {
 	tip.clear();
 }
 
@@ -69,6 +70,7 @@ Loot& Loot::operator= (const Loot &other) {
 	dropped_by_hero = other.dropped_by_hero;
 	on_ground = other.on_ground;
 	sound_played = other.sound_played;
+	serial = other.serial;
 
 	return *this;
 }
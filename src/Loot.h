@@ -40,6 +40,7 @@ public:
 	bool dropped_by_hero;
 	bool on_ground;
 	bool sound_played;
+	size_t serial; // the order that loot was dropped in
 
 	Loot();
 	Loot(const Loot &other);
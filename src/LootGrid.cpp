@@ -0,0 +1,116 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class LootGrid
+ *
+ * Buckets floor loot into square cells of map tiles so that pickup checks and
+ * tooltip rendering only look at nearby loot. Loot doesn't move once it is
+ * dropped, so it is only added and removed.
+ * Query results are returned in the order the loot was dropped.
+ */
+
+#include "Animation.h"
+#include "Loot.h"
+#include "LootGrid.h"
+
+LootGrid::LootGrid()
+	: cells()
+	, cols(1)
+	, rows(1)
+{
+	cells.resize(1);
+}
+
+LootGrid::~LootGrid() {
+}
+
+/**
+ * Resize the grid to cover a map. Any loot in the grid is removed.
+ */
+void LootGrid::init(int map_w, int map_h) {
+	cols = std::max((map_w + CELL_SIZE - 1) / CELL_SIZE, 1);
+	rows = std::max((map_h + CELL_SIZE - 1) / CELL_SIZE, 1);
+
+	cells.clear();
+	cells.resize(cols * rows);
+}
+
+void LootGrid::clear() {
+	for (size_t i = 0; i < cells.size(); ++i) {
+		cells[i].clear();
+	}
+}
+
+void LootGrid::add(Loot* l) {
+	cells[getCellY(l->pos.y) * cols + getCellX(l->pos.x)].push_back(l);
+}
+
+void LootGrid::remove(Loot* l) {
+	std::vector<Loot*>& bucket = cells[getCellY(l->pos.y) * cols + getCellX(l->pos.x)];
+	for (size_t i = 0; i < bucket.size(); ++i) {
+		if (bucket[i] == l) {
+			bucket[i] = bucket.back();
+			bucket.pop_back();
+			break;
+		}
+	}
+}
+
+/**
+ * Positions outside of the map are placed in the nearest edge cell
+ */
+int LootGrid::getCellX(float x) {
+	if (x < 0)
+		return 0;
+	return std::min(static_cast<int>(x) / CELL_SIZE, cols - 1);
+}
+
+int LootGrid::getCellY(float y) {
+	if (y < 0)
+		return 0;
+	return std::min(static_cast<int>(y) / CELL_SIZE, rows - 1);
+}
+
+bool LootGrid::compareOrder(const Loot* a, const Loot* b) {
+	return a->serial < b->serial;
+}
+
+/**
+ * Get all loot inside the rectangle from top_left to bottom_right (map units)
+ */
+void LootGrid::getInArea(const FPoint& top_left, const FPoint& bottom_right, std::vector<Loot*>& result) {
+	result.clear();
+
+	int x1 = getCellX(top_left.x);
+	int y1 = getCellY(top_left.y);
+	int x2 = getCellX(bottom_right.x);
+	int y2 = getCellY(bottom_right.y);
+
+	for (int y = y1; y <= y2; ++y) {
+		for (int x = x1; x <= x2; ++x) {
+			const std::vector<Loot*>& bucket = cells[y * cols + x];
+			for (size_t i = 0; i < bucket.size(); ++i) {
+				const FPoint& pos = bucket[i]->pos;
+				if (pos.x >= top_left.x && pos.y >= top_left.y && pos.x <= bottom_right.x && pos.y <= bottom_right.y)
+					result.push_back(bucket[i]);
+			}
+		}
+	}
+
+	std::sort(result.begin(), result.end(), compareOrder);
+}
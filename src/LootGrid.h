@@ -0,0 +1,60 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class LootGrid
+ *
+ * Buckets floor loot into square cells of map tiles so that pickup checks and
+ * tooltip rendering only look at nearby loot. Loot doesn't move once it is
+ * dropped, so it is only added and removed.
+ * Query results are returned in the order the loot was dropped.
+ */
+
+#ifndef LOOT_GRID_H
+#define LOOT_GRID_H
+
+#include "CommonIncludes.h"
+#include "Utils.h"
+
+class Loot;
+
+class LootGrid {
+public:
+	static const int CELL_SIZE = 4;
+
+	LootGrid();
+	~LootGrid();
+
+	void init(int map_w, int map_h);
+	void clear();
+	void add(Loot* l);
+	void remove(Loot* l);
+
+	void getInArea(const FPoint& top_left, const FPoint& bottom_right, std::vector<Loot*>& result);
+
+private:
+	static bool compareOrder(const Loot* a, const Loot* b);
+
+	int getCellX(float x);
+	int getCellY(float y);
+
+	std::vector< std::vector<Loot*> > cells;
+	int cols;
+	int rows;
+};
+
+#endif
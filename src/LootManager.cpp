@@ -59,6 +59,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 LootManager::LootManager()
 	: sfx_loot(snd->load(eset->loot.sfx_loot, "LootManager dropping loot"))
 	, sfx_loot_channel("loot")
+	, next_serial(0)
 {
 	loadGraphics();
 	loadLootTables();
@@ -70,22 +71,23 @@ LootManager::LootManager()
  */
 void LootManager::loadGraphics() {
 	// check all items in the item database
-	std::map<ItemID, Item>::iterator item_it;
-	for (item_it = items->items.begin(); item_it != items->items.end(); ++item_it) {
-		if (item_it->second.loot_animation.empty())
+	for (ItemID id = 0; id < items->items.getIDLimit(); ++id) {
+		const Item& item = items->items[id];
+		if (item.loot_animation.empty())
 			continue;
 
-		animations[item_it->first].resize(item_it->second.loot_animation.size());
+		animations[id].resize(item.loot_animation.size());
 
-		for (size_t i = 0; i < item_it->second.loot_animation.size(); ++i) {
-			anim->increaseCount(item_it->second.loot_animation[i].name);
-			animations[item_it->first][i] = anim->getAnimationSet(item_it->second.loot_animation[i].name)->getAnimation("");
+		for (size_t i = 0; i < item.loot_animation.size(); ++i) {
+			anim->increaseCount(item.loot_animation[i].name);
+			animations[id][i] = anim->getAnimationSet(item.loot_animation[i].name)->getAnimation("");
 		}
 	}
 }
 
 void LootManager::handleNewMap() {
-	loot.clear();
+	clearLoot();
+	grid.init(mapr->w, mapr->h);
 	enemiesDroppingLoot.clear();
 }
 
@@ -104,23 +106,23 @@ void LootManager::logic() {
 			pc->logMsg(msg->get("Loot tooltip visibility") + ": " + msg->get("Show All"), Avatar::MSG_UNIQUE);
 	}
 
-	std::vector<Loot>::iterator it;
+	std::vector<Loot*>::iterator it;
 	for (it = loot.begin(); it != loot.end(); ++it) {
 
 		// animate flying loot
-		if (it->animation) {
-			it->animation->advanceFrame();
-			if (!it->on_ground && it->animation->isSecondLastFrame()) {
-				it->on_ground = true;
+		if ((*it)->animation) {
+			(*it)->animation->advanceFrame();
+			if (!(*it)->on_ground && (*it)->animation->isSecondLastFrame()) {
+				(*it)->on_ground = true;
 			}
 		}
 
-		if (it->on_ground && !it->sound_played && !it->stack.empty()) {
+		if ((*it)->on_ground && !(*it)->sound_played && !(*it)->stack.empty()) {
 			Point pos;
-			pos.x = static_cast<int>(it->pos.x);
-			pos.y = static_cast<int>(it->pos.y);
-			items->playSound(it->stack.item, pos);
-			it->sound_played = true;
+			pos.x = static_cast<int>((*it)->pos.x);
+			pos.y = static_cast<int>((*it)->pos.y);
+			items->playSound((*it)->stack.item, pos);
+			(*it)->sound_played = true;
 		}
 	}
 
@@ -138,27 +140,33 @@ void LootManager::logic() {
  * Show all tooltips for loot on the floor
  */
 void LootManager::renderTooltips(const FPoint& cam) {
+	// tooltips that were shown last frame may have scrolled off the screen
+	for (size_t i = 0; i < visible_tips.size(); ++i) {
+		visible_tips[i]->tip_visible = false;
+	}
+	visible_tips.clear();
+
 	if (!settings->show_hud) return;
 
 	Point dest;
 	bool tooltip_below = true;
 	Rect screen_rect(0, 0, settings->view_w, settings->view_h);
 
-	std::vector<Loot>::iterator it;
-	for (it = loot.begin(); it != loot.end(); ) {
-		it->tip_visible = false;
+	getLootOnScreen(cam, loot_candidates);
+
+	for (size_t i = 0; i < loot_candidates.size(); ++i) {
+		Loot* l = loot_candidates[i];
 
-		if (it->on_ground) {
+		if (l->on_ground) {
 			if (mapr->fogofwar > FogOfWar::TYPE_MINIMAP) {
-				float delta = Utils::calcDist(pc->stats.pos, it->pos);
+				float delta = Utils::calcDist(pc->stats.pos, l->pos);
 				if (delta > fow->mask_radius-1.0) {
-					break;
+					continue;
 				}
 			}
 
-			Point p = Utils::mapToScreen(it->pos.x, it->pos.y, cam.x, cam.y);
+			Point p = Utils::mapToScreen(l->pos.x, l->pos.y, cam.x, cam.y);
 			if (!Utils::isWithinRect(screen_rect, p)) {
-				++it;
 				continue;
 			}
 
@@ -179,11 +187,11 @@ void LootManager::renderTooltips(const FPoint& cam) {
 			bool default_visibility = true;
 
 			if (settings->loot_tooltips == Settings::LOOT_TIPS_DEFAULT && eset->loot.hide_radius > 0) {
-				if (Utils::calcDist(pc->stats.pos, it->pos) < eset->loot.hide_radius) {
+				if (Utils::calcDist(pc->stats.pos, l->pos) < eset->loot.hide_radius) {
 					default_visibility = false;
 				}
 				else {
-					Entity* test_enemy = entitym->getNearestEntity(it->pos, !EntityManager::GET_CORPSE, NULL, eset->loot.hide_radius);
+					Entity* test_enemy = entitym->getNearestEntity(l->pos, !EntityManager::GET_CORPSE, NULL, eset->loot.hide_radius);
 					if (test_enemy) {
 						default_visibility = false;
 					}
@@ -200,32 +208,32 @@ void LootManager::renderTooltips(const FPoint& cam) {
 				forced_visibility = Utils::isWithinRect(hover, inpt->mouse) || (inpt->pressing[Input::ALT] && settings->loot_tooltips != Settings::LOOT_TIPS_SHOW_ALL);
 
 			if (default_visibility || forced_visibility) {
-				it->tip_visible = true;
-
 				// create tooltip data if needed
-				if (it->tip.isEmpty()) {
-					if (!it->stack.empty()) {
-						it->tip = items->getShortTooltip(it->stack);
+				// the tooltip image is kept by l->wtip until the tooltip data changes
+				if (l->tip.isEmpty()) {
+					if (!l->stack.empty()) {
+						l->tip = items->getShortTooltip(l->stack);
 					}
 				}
 
 				// try to prevent tooltips from overlapping
-				it->wtip->prerender(it->tip, dest, TooltipData::STYLE_TOPLABEL);
-				std::vector<Loot>::iterator test_it;
-				for (test_it = loot.begin(); test_it != it; ) {
-					if (test_it->tip_visible && Utils::rectsOverlap(test_it->wtip->bounds, it->wtip->bounds)) {
+				l->wtip->prerender(l->tip, dest, TooltipData::STYLE_TOPLABEL);
+				for (size_t j = 0; j < visible_tips.size(); ++j) {
+					const Rect& test_bounds = visible_tips[j]->wtip->bounds;
+					if (Utils::rectsOverlap(test_bounds, l->wtip->bounds)) {
 						if (tooltip_below)
-							dest.y = test_it->wtip->bounds.y + test_it->wtip->bounds.h + eset->tooltips.offset;
+							dest.y = test_bounds.y + test_bounds.h + eset->tooltips.offset;
 						else
-							dest.y = test_it->wtip->bounds.y - test_it->wtip->bounds.h + eset->tooltips.offset;
+							dest.y = test_bounds.y - test_bounds.h + eset->tooltips.offset;
 
-						it->wtip->bounds.y = dest.y;
+						l->wtip->bounds.y = dest.y;
 					}
-
-					++test_it;
 				}
 
-				it->wtip->render(it->tip, dest, TooltipData::STYLE_TOPLABEL);
+				l->wtip->render(l->tip, dest, TooltipData::STYLE_TOPLABEL);
+
+				l->tip_visible = true;
+				visible_tips.push_back(l);
 
 				if (settings->loot_tooltips == Settings::LOOT_TIPS_HIDE_ALL && !inpt->pressing[Input::ALT])
 					break;
@@ -233,9 +241,36 @@ void LootManager::renderTooltips(const FPoint& cam) {
 		}
 
 		tooltip_below = !tooltip_below;
+	}
+}
 
-		++it;
+/**
+ * Get the loot that could be on the screen. The corners of the screen are converted
+ * to map positions, so the area is larger than the screen when using isometric tiles.
+ */
+void LootManager::getLootOnScreen(const FPoint& cam, std::vector<Loot*>& result) {
+	FPoint corners[4];
+	corners[0] = Utils::screenToMap(0, 0, cam.x, cam.y);
+	corners[1] = Utils::screenToMap(settings->view_w, 0, cam.x, cam.y);
+	corners[2] = Utils::screenToMap(0, settings->view_h, cam.x, cam.y);
+	corners[3] = Utils::screenToMap(settings->view_w, settings->view_h, cam.x, cam.y);
+
+	FPoint top_left = corners[0];
+	FPoint bottom_right = corners[0];
+	for (int i = 1; i < 4; ++i) {
+		top_left.x = std::min(top_left.x, corners[i].x);
+		top_left.y = std::min(top_left.y, corners[i].y);
+		bottom_right.x = std::max(bottom_right.x, corners[i].x);
+		bottom_right.y = std::max(bottom_right.y, corners[i].y);
 	}
+
+	// extra tile on each side, since loot is positioned at tile centers
+	top_left.x -= 1;
+	top_left.y -= 1;
+	bottom_right.x += 1;
+	bottom_right.y += 1;
+
+	grid.getInArea(top_left, bottom_right, result);
 }
 
 /**
@@ -263,7 +298,9 @@ void LootManager::checkEnemiesForLoot() {
 			checkLoot(quest_loot_table, &e->pos, NULL);
 		}
 
-		if (!e->loot_table.empty()) {
+		// the loot table is shared with other enemies of the same type, so it is only read here
+		const std::vector<EventComponent>& loot_table = e->getTemplate().loot_table;
+		if (!loot_table.empty() && !e->loot_dropped) {
 			unsigned drops;
 			if (e->loot_count.y != 0) {
 				drops = Math::randBetween(e->loot_count.x, e->loot_count.y);
@@ -272,11 +309,15 @@ void LootManager::checkEnemiesForLoot() {
 				drops = Math::randBetween(1, eset->loot.drop_max);
 			}
 
+			// 'fixed' items only drop once, no matter how many drops there are
+			if (drops > 0)
+				dropFixedLoot(loot_table, &e->pos, NULL);
+
 			for (unsigned j=0; j<drops; ++j) {
-				checkLoot(e->loot_table, &e->pos, NULL);
+				rollLoot(loot_table, &e->pos, NULL);
 			}
 
-			e->loot_table.clear();
+			e->loot_dropped = true;
 		}
 	}
 	enemiesDroppingLoot.clear();
@@ -309,79 +350,104 @@ void LootManager::addEnemyLoot(StatBlock *e) {
 	enemiesDroppingLoot.push_back(e);
 }
 
+/**
+ * Drops the 'fixed' items and removes them from the table, then rolls for a random item
+ */
 void LootManager::checkLoot(std::vector<EventComponent> &loot_table, FPoint *pos, std::vector<ItemStack> *itemstack_vec) {
-	FPoint p;
-	EventComponent *ec;
-	ItemStack new_loot;
-	std::vector<EventComponent*> possible_ids;
+	dropFixedLoot(loot_table, pos, itemstack_vec);
 
-	float chance = Math::randBetweenF(0,100);
-
-	// first drop any 'fixed' (0% chance) items
 	for (size_t i = loot_table.size(); i > 0; i--) {
-		ec = &loot_table[i-1];
-		if (ec->data[LOOT_EC_CHANCE].Float == 0) {
-			if (ec->status == 0 || (ec->status > 0 && camp->checkStatus(ec->status))) {
-				checkLootComponent(ec, pos, itemstack_vec);
-			}
+		if (loot_table[i-1].data[LOOT_EC_CHANCE].Float == 0)
 			loot_table.erase(loot_table.begin()+i-1);
+	}
+
+	rollLoot(loot_table, pos, itemstack_vec);
+}
+
+bool LootManager::checkLootStatus(const EventComponent* ec) {
+	return ec->status == 0 || (ec->status > 0 && camp->checkStatus(ec->status));
+}
+
+/**
+ * Drop any 'fixed' (0% chance) items
+ */
+void LootManager::dropFixedLoot(const std::vector<EventComponent> &loot_table, FPoint *pos, std::vector<ItemStack> *itemstack_vec) {
+	for (size_t i = loot_table.size(); i > 0; i--) {
+		const EventComponent *ec = &loot_table[i-1];
+		if (ec->data[LOOT_EC_CHANCE].Float == 0 && checkLootStatus(ec)) {
+			checkLootComponent(ec, pos, itemstack_vec);
 		}
 	}
+}
+
+/**
+ * Pick up to 1 random item to drop. 'Fixed' items are skipped.
+ * Candidates are chosen with reservoir sampling, so no list of them needs to be built.
+ */
+void LootManager::rollLoot(const std::vector<EventComponent> &loot_table, FPoint *pos, std::vector<ItemStack> *itemstack_vec) {
+	const EventComponent *chosen_ec = NULL;
+	size_t candidate_count = 0;
 
-	// now pick up to 1 random item to drop
-	float threshold = static_cast<float>(pc->stats.get(Stats::ITEM_FIND) + 100);
+	float chance = Math::randBetweenF(0,100);
+	float item_find = pc->stats.get(Stats::ITEM_FIND) + 100.f;
+
+	float threshold = item_find;
 	for (unsigned i = 0; i < loot_table.size(); i++) {
-		ec = &loot_table[i];
+		const EventComponent *ec = &loot_table[i];
 
 		float real_chance = ec->data[LOOT_EC_CHANCE].Float;
+		if (real_chance == 0)
+			continue;
 
 		if (ec->id != 0) {
-			real_chance = real_chance * (pc->stats.get(Stats::ITEM_FIND) + 100.f) / 100.f;
+			real_chance = real_chance * item_find / 100.f;
 		}
 
-		if (real_chance >= chance && (ec->status == 0 || (ec->status > 0 && camp->checkStatus(ec->status)))) {
+		if (real_chance >= chance && checkLootStatus(ec)) {
 			if (real_chance <= threshold) {
 				if (real_chance != threshold) {
-					possible_ids.clear();
+					candidate_count = 0;
 				}
 
 				threshold = real_chance;
 			}
 
+			// if there was more than one item with the same chance, randomly pick one of them
 			if (chance <= threshold) {
-				possible_ids.push_back(ec);
+				candidate_count++;
+				if (static_cast<size_t>(rand()) % candidate_count == 0)
+					chosen_ec = ec;
 			}
 		}
 	}
 
-	if (!possible_ids.empty()) {
-		// if there was more than one item with the same chance, randomly pick one of them
-		size_t chosen_loot = static_cast<size_t>(rand()) % possible_ids.size();
-		ec = possible_ids[chosen_loot];
-		checkLootComponent(ec, pos, itemstack_vec);
+	if (chosen_ec) {
+		checkLootComponent(chosen_ec, pos, itemstack_vec);
 	}
 }
 
 void LootManager::addLoot(ItemStack stack, const FPoint& pos, bool dropped_by_hero) {
-	Loot ld;
-	ld.stack = stack;
-	ld.pos.x = pos.x;
-	ld.pos.y = pos.y;
-	ld.pos.align(); // prevent "rounding jitter"
-	ld.dropped_by_hero = dropped_by_hero;
+	FPoint loot_pos = pos;
+	loot_pos.align(); // prevent "rounding jitter"
 
 	// merge stacks that have the same item id and position
-	std::vector<Loot>::iterator it;
-	for (it = loot.end(); it != loot.begin(); ) {
-		--it;
-		if (it->stack.item == ld.stack.item && it->pos.x == ld.pos.x && it->pos.y == ld.pos.y) {
-			it->stack.quantity += ld.stack.quantity;
-			it->tip.clear();
+	grid.getInArea(loot_pos, loot_pos, loot_candidates);
+	for (size_t i = loot_candidates.size(); i > 0; i--) {
+		Loot* l = loot_candidates[i-1];
+		if (l->stack.item == stack.item && l->pos.x == loot_pos.x && l->pos.y == loot_pos.y) {
+			l->stack.quantity += stack.quantity;
+			l->tip.clear();
 			snd->play(sfx_loot, sfx_loot_channel, pos, false);
 			return;
 		}
 	}
 
+	Loot* ld = new Loot();
+	ld->stack = stack;
+	ld->pos = loot_pos;
+	ld->dropped_by_hero = dropped_by_hero;
+	ld->serial = next_serial++;
+
 	if (!items->items[stack.item].loot_animation.empty()) {
 		size_t index = items->items[stack.item].loot_animation.size()-1;
 
@@ -393,17 +459,47 @@ void LootManager::addLoot(ItemStack stack, const FPoint& pos, bool dropped_by_he
 				break;
 			}
 		}
-		ld.loadAnimation(items->items[stack.item].loot_animation[index].name);
+		ld->loadAnimation(items->items[stack.item].loot_animation[index].name);
 	}
 	else {
 		// immediately place the loot on the ground if there's no animation
-		ld.on_ground = true;
+		ld->on_ground = true;
 	}
 
 	loot.push_back(ld);
+	grid.add(ld);
 	snd->play(sfx_loot, sfx_loot_channel, pos, false);
 }
 
+/**
+ * Take loot off the floor and return its item stack
+ */
+ItemStack LootManager::removeLoot(Loot* l) {
+	ItemStack stack = l->stack;
+
+	grid.remove(l);
+
+	std::vector<Loot*>::iterator it = std::find(loot.begin(), loot.end(), l);
+	if (it != loot.end())
+		loot.erase(it);
+
+	it = std::find(visible_tips.begin(), visible_tips.end(), l);
+	if (it != visible_tips.end())
+		visible_tips.erase(it);
+
+	delete l;
+	return stack;
+}
+
+void LootManager::clearLoot() {
+	for (size_t i = 0; i < loot.size(); ++i) {
+		delete loot[i];
+	}
+	loot.clear();
+	grid.clear();
+	visible_tips.clear();
+}
+
 /**
  * Click on the map to pick up loot.  We need the camera position to translate
  * screen coordinates to map locations.
@@ -416,14 +512,18 @@ ItemStack LootManager::checkPickup(const Point& mouse, const FPoint& cam, const
 		// I'm starting at the end of the loot list so that more recently-dropped
 		// loot is picked up first.  If a player drops several loot in the same
 		// location, picking it back up will work like a stack.
-		std::vector<Loot>::iterator it, it_tip, it_hotspot;
-		it_tip = it_hotspot = loot.end();
-		for (it = loot.end(); it != loot.begin(); ) {
-			--it;
+		Loot* l_tip = NULL;
+		Loot* l_hotspot = NULL;
+
+		float range = eset->misc.interact_range;
+		grid.getInArea(FPoint(hero_pos.x - range, hero_pos.y - range), FPoint(hero_pos.x + range, hero_pos.y + range), loot_candidates);
+
+		for (size_t i = loot_candidates.size(); i > 0; i--) {
+			Loot* l = loot_candidates[i-1];
 
 			// loot close enough to pickup?
-			if (fabs(hero_pos.x - it->pos.x) < eset->misc.interact_range && fabs(hero_pos.y - it->pos.y) < eset->misc.interact_range && !it->isFlying()) {
-				Point p = Utils::mapToScreen(it->pos.x, it->pos.y, cam.x, cam.y);
+			if (fabs(hero_pos.x - l->pos.x) < range && fabs(hero_pos.y - l->pos.y) < range && !l->isFlying()) {
+				Point p = Utils::mapToScreen(l->pos.x, l->pos.y, cam.x, cam.y);
 
 				Rect r;
 				r.x = p.x - eset->tileset.tile_w_half;
@@ -431,38 +531,34 @@ ItemStack LootManager::checkPickup(const Point& mouse, const FPoint& cam, const
 				r.w = eset->tileset.tile_w;
 				r.h = eset->tileset.tile_h;
 
-				if (it_tip == loot.end() && it->tip_visible && Utils::isWithinRect(it->wtip->bounds, mouse)) {
+				if (!l_tip && l->tip_visible && Utils::isWithinRect(l->wtip->bounds, mouse)) {
 					// clicked on a tooltip
 					curs->setCursor(CursorManager::CURSOR_INTERACT);
-					if (inpt->pressing[Input::MAIN1] && !inpt->lock[Input::MAIN1] && !it->stack.empty()) {
-						it_tip = it;
+					if (inpt->pressing[Input::MAIN1] && !inpt->lock[Input::MAIN1] && !l->stack.empty()) {
+						l_tip = l;
 					}
 				}
-				else if (it_hotspot == loot.end() && Utils::isWithinRect(r, mouse)) {
+				else if (!l_hotspot && Utils::isWithinRect(r, mouse)) {
 					// clicked on a hotspot
 					curs->setCursor(CursorManager::CURSOR_INTERACT);
-					if (inpt->pressing[Input::MAIN1] && !inpt->lock[Input::MAIN1] && !it->stack.empty()) {
-						it_hotspot = it;
+					if (inpt->pressing[Input::MAIN1] && !inpt->lock[Input::MAIN1] && !l->stack.empty()) {
+						l_hotspot = l;
 					}
 				}
 
 				// tooltips take priority over hotspots, so we can jump out here if we clicked on a tooltip
-				if (it_tip != loot.end())
+				if (l_tip)
 					break;
 			}
 		}
 
-		if (it_tip != loot.end()) {
+		if (l_tip) {
 			inpt->lock[Input::MAIN1] = true;
-			loot_stack = it_tip->stack;
-			loot.erase(it_tip);
-			return loot_stack;
+			return removeLoot(l_tip);
 		}
-		else if (it_hotspot != loot.end()) {
+		else if (l_hotspot) {
 			inpt->lock[Input::MAIN1] = true;
-			loot_stack = it_hotspot->stack;
-			loot.erase(it_hotspot);
-			return loot_stack;
+			return removeLoot(l_hotspot);
 		}
 	}
 
@@ -484,14 +580,17 @@ ItemStack LootManager::checkPickup(const Point& mouse, const FPoint& cam, const
 ItemStack LootManager::checkAutoPickup(const FPoint& hero_pos) {
 	ItemStack loot_stack;
 
-	std::vector<Loot>::iterator it;
-	for (it = loot.end(); it != loot.begin(); ) {
-		--it;
-		if (!it->dropped_by_hero && fabs(hero_pos.x - it->pos.x) < eset->loot.autopickup_range && fabs(hero_pos.y - it->pos.y) < eset->loot.autopickup_range && !it->isFlying()) {
-			if (it->stack.item == eset->misc.currency_id && eset->loot.autopickup_currency) {
-				loot_stack = it->stack;
-				it = loot.erase(it);
-				return loot_stack;
+	if (!eset->loot.autopickup_currency)
+		return loot_stack;
+
+	float range = eset->loot.autopickup_range;
+	grid.getInArea(FPoint(hero_pos.x - range, hero_pos.y - range), FPoint(hero_pos.x + range, hero_pos.y + range), loot_candidates);
+
+	for (size_t i = loot_candidates.size(); i > 0; i--) {
+		Loot* l = loot_candidates[i-1];
+		if (!l->dropped_by_hero && fabs(hero_pos.x - l->pos.x) < range && fabs(hero_pos.y - l->pos.y) < range && !l->isFlying()) {
+			if (l->stack.item == eset->misc.currency_id) {
+				return removeLoot(l);
 			}
 		}
 	}
@@ -502,45 +601,52 @@ ItemStack LootManager::checkNearestPickup(const FPoint& hero_pos) {
 	ItemStack loot_stack;
 
 	float best_distance = std::numeric_limits<float>::max();
+	Loot* nearest = NULL;
 
-	std::vector<Loot>::iterator it;
-	std::vector<Loot>::iterator nearest = loot.end();
+	float range = eset->misc.interact_range;
+	grid.getInArea(FPoint(hero_pos.x - range, hero_pos.y - range), FPoint(hero_pos.x + range, hero_pos.y + range), loot_candidates);
 
-	for (it = loot.end(); it != loot.begin(); ) {
-		--it;
+	for (size_t i = loot_candidates.size(); i > 0; i--) {
+		Loot* l = loot_candidates[i-1];
 
-		float distance = Utils::calcDist(hero_pos, it->pos);
-		if (distance < eset->misc.interact_range && distance < best_distance) {
+		float distance = Utils::calcDist(hero_pos, l->pos);
+		if (distance < range && distance < best_distance) {
 			best_distance = distance;
-			nearest = it;
+			nearest = l;
 		}
 	}
 
-	if (nearest != loot.end() && !nearest->stack.empty()) {
-		loot_stack = nearest->stack;
-		loot.erase(nearest);
-		return loot_stack;
+	if (nearest && !nearest->stack.empty()) {
+		return removeLoot(nearest);
 	}
 
 	return loot_stack;
 }
 
 void LootManager::addRenders(std::vector<Renderable> &ren, std::vector<Renderable> &ren_dead) {
-	std::vector<Loot>::iterator it;
+	Rect screen_rect(0, 0, settings->view_w, settings->view_h);
+
+	std::vector<Loot*>::iterator it;
 	for (it = loot.begin(); it != loot.end(); ++it) {
 		if (mapr->fogofwar > FogOfWar::TYPE_MINIMAP) {
-			float delta = Utils::calcDist(pc->stats.pos, it->pos);
+			float delta = Utils::calcDist(pc->stats.pos, (*it)->pos);
 			if (delta > fow->mask_radius-1.0) {
 				continue;
 			}
 		}
 
-		if (it->animation) {
-			Renderable r = it->animation->getCurrentFrame(0);
-			r.map_pos.x = it->pos.x;
-			r.map_pos.y = it->pos.y;
+		if ((*it)->animation) {
+			Renderable r = (*it)->animation->getCurrentFrame(0);
+			r.map_pos.x = (*it)->pos.x;
+			r.map_pos.y = (*it)->pos.y;
 
-			(it->animation->isLastFrame() ? ren_dead : ren).push_back(r);
+			// skip sprites that are off the screen, using the same position as MapRenderer::drawRenderable()
+			Point p = Utils::mapToScreen(r.map_pos.x, r.map_pos.y, mapr->cam.shake.x, mapr->cam.shake.y);
+			Rect dest(p.x - r.offset.x, p.y - r.offset.y, r.src.w, r.src.h);
+			if (!Utils::rectsOverlap(screen_rect, dest))
+				continue;
+
+			((*it)->animation->isLastFrame() ? ren_dead : ren).push_back(r);
 		}
 	}
 }
@@ -713,7 +819,7 @@ void LootManager::getLootTable(const std::string &filename, std::vector<EventCom
 	}
 }
 
-void LootManager::checkLootComponent(EventComponent* ec, FPoint *pos, std::vector<ItemStack> *itemstack_vec) {
+void LootManager::checkLootComponent(const EventComponent* ec, FPoint *pos, std::vector<ItemStack> *itemstack_vec) {
 	FPoint p;
 	ItemStack new_loot;
 	Point src;
@@ -770,19 +876,19 @@ void LootManager::removeFromEnemiesDroppingLoot(const StatBlock* sb) {
 
 LootManager::~LootManager() {
 	// remove all items in the item database
-	std::map<ItemID, Item>::iterator item_it;
-	for (item_it = items->items.begin(); item_it != items->items.end(); ++item_it) {
-		if (item_it->second.loot_animation.empty())
+	for (ItemID id = 0; id < items->items.getIDLimit(); ++id) {
+		const Item& item = items->items[id];
+		if (item.loot_animation.empty())
 			continue;
 
-		for (size_t i = 0; i < item_it->second.loot_animation.size(); ++i) {
-			anim->decreaseCount(item_it->second.loot_animation[i].name);
-			delete animations[item_it->first][i];
+		for (size_t i = 0; i < item.loot_animation.size(); ++i) {
+			anim->decreaseCount(item.loot_animation[i].name);
+			delete animations[id][i];
 		}
 	}
 
 	// remove items, so Loots get destroyed!
-	loot.clear();
+	clearLoot();
 
 	anim->cleanUp();
 
@@ -31,6 +31,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "FileParser.h"
 #include "ItemManager.h"
 #include "Loot.h"
+#include "LootGrid.h"
 #include "Utils.h"
 
 class Animation;
@@ -53,13 +54,25 @@ private:
 	void checkMapForLoot();
 	void loadLootTables();
 	void getLootTable(const std::string &filename, std::vector<EventComponent> *ec_list);
-	void checkLootComponent(EventComponent* ec, FPoint *pos, std::vector<ItemStack> *itemstack_vec);
+	void checkLootComponent(const EventComponent* ec, FPoint *pos, std::vector<ItemStack> *itemstack_vec);
+	bool checkLootStatus(const EventComponent* ec);
+	void dropFixedLoot(const std::vector<EventComponent> &loot_table, FPoint *pos, std::vector<ItemStack> *itemstack_vec);
+	void rollLoot(const std::vector<EventComponent> &loot_table, FPoint *pos, std::vector<ItemStack> *itemstack_vec);
+	void getLootOnScreen(const FPoint& cam, std::vector<Loot*>& result);
+	ItemStack removeLoot(Loot* l);
+	void clearLoot();
 
 	SoundID sfx_loot;
 	std::string sfx_loot_channel;
 
 	// loot refers to ItemManager indices
-	std::vector<Loot> loot;
+	// listed in the order it was dropped
+	std::vector<Loot*> loot;
+	LootGrid grid;
+	size_t next_serial;
+
+	std::vector<Loot*> loot_candidates; // reused for grid queries
+	std::vector<Loot*> visible_tips; // loot that had its tooltip shown by the last renderTooltips()
 
 	// enemies which should drop loot, but didnt yet.
 	std::vector<class StatBlock*> enemiesDroppingLoot;
@@ -39,7 +39,10 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "UtilsParsing.h"
 
 Map::Map()
-	: filename("")
+	: timers()
+	, next_delayed_event(0)
+	, event_index_outdated(true)
+	, filename("")
 	, layers()
 	, events()
 	, w(1)
@@ -69,6 +72,8 @@ void Map::clearEvents() {
 	events.clear();
 	delayed_events.clear();
 	statblocks.clear();
+	timers.clear();
+	invalidateEventIndex();
 }
 
 void Map::removeLayer(unsigned index) {
@@ -647,6 +652,7 @@ int Map::addEventStatBlock(Event &evnt) {
 	// create a temporary EffectDef for immunity; will be used for map StatBlocks
 	EffectDef immunity_effect;
 	immunity_effect.id = "MAP_EVENT_IMMUNITY";
+	immunity_effect.symbol = symbols->intern(immunity_effect.id);
 	immunity_effect.type = Effect::RESIST_ALL;
 
 	EffectParams immunity_params;
@@ -663,3 +669,35 @@ int Map::addEventStatBlock(Event &evnt) {
 
 	return static_cast<int>(statblocks.size())-1;
 }
+
+/**
+ * Queue a copy of an event that runs once its delay timer ends
+ */
+void Map::addDelayedEvent(const Event& evnt) {
+	size_t id = next_delayed_event++;
+	Event& delayed = delayed_events[id];
+	delayed = evnt;
+	timers.schedule(delayed.delay.getCurrent(), TIMER_DELAYED_EVENT, id);
+}
+
+/**
+ * Call after resetting the delay or cooldown of an event in the event list.
+ * The delay runs first, followed by the cooldown.
+ */
+void Map::startEventTimers(Event& evnt) {
+	if (!evnt.delay.isEnd())
+		timers.schedule(evnt.delay.getCurrent(), TIMER_EVENT_DELAY, evnt.serial);
+	else if (!evnt.cooldown.isEnd())
+		timers.schedule(evnt.cooldown.getCurrent(), TIMER_EVENT_COOLDOWN, evnt.serial);
+}
+
+/**
+ * Returns NULL if the event has been removed
+ */
+Event* Map::getEventBySerial(size_t serial) {
+	for (size_t i = 0; i < events.size(); ++i) {
+		if (events[i].serial == serial)
+			return &events[i];
+	}
+	return NULL;
+}
@@ -24,6 +24,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "CommonIncludes.h"
 #include "EventManager.h"
 #include "MapCollision.h"
+#include "TimerWheel.h"
 #include "Utils.h"
 
 class Event;
@@ -151,6 +152,23 @@ protected:
 
 	std::vector<StatBlock> statblocks;
 
+	// types of timers in 'timers'
+	enum {
+		TIMER_EVENT_DELAY = 0,
+		TIMER_EVENT_COOLDOWN = 1,
+		TIMER_DELAYED_EVENT = 2,
+		TIMER_POWER_COOLDOWN = 3
+	};
+
+	// event delays and cooldowns, delayed events, and map power cooldowns
+	TimerWheel timers;
+	size_t next_delayed_event;
+
+	// set when the event list changes, so that MapRenderer rebuilds its event index
+	bool event_index_outdated;
+
+	Event* getEventBySerial(size_t serial);
+
 	std::string filename;
 	std::string tileset;
 public:
@@ -169,8 +187,11 @@ public:
 	std::vector<std::string> layernames;
 
 	void clearEvents();
+	void invalidateEventIndex() { event_index_outdated = true; } // call after adding, removing or moving events
 
 	int addEventStatBlock(Event &evnt);
+	void addDelayedEvent(const Event& evnt);
+	void startEventTimers(Event& evnt);
 
 	// enemy load handling
 	std::queue<Map_Enemy> enemies;
@@ -181,7 +202,7 @@ public:
 
 	// map events
 	std::vector<Event> events;
-	std::vector<Event> delayed_events;
+	std::map<size_t, Event> delayed_events;
 
 	// intemap_random queue
 	std::string intermap_random_filename;
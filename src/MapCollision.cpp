@@ -39,14 +39,27 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include <cfloat>
 #include <math.h>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
 
 // this value is used to determine the greatest possible position within a tile before transitioning to the next tile
 // so if an entity has a position of (1-MIN_TILE_GAP, 0) and moves to the east, they will move to (1,0)
 const float MapCollision::MIN_TILE_GAP = 0.001f;
 
+const int64_t MapCollision::LINE_CHECK_PRECISION = 1024;
+
+MapCollision::LineCacheEntry::LineCacheEntry()
+	: result(false)
+	, version(0)
+{
+}
+
 MapCollision::MapCollision()
-	: map_size(Point())
+	: regions_dirty(true)
+	, line_cache()
+	, wall_version(0)
+	, tile_version(0)
+	, map_size(Point())
 {
 	colmap.resize(1);
 	colmap[0].resize(1);
@@ -63,6 +76,10 @@ void MapCollision::setMap(const Map_Layer& _colmap, unsigned short w, unsigned s
 
 	map_size.x = w;
 	map_size.y = h;
+
+	invalidateRegions();
+	updateRegions();
+	line_cache.clear();
 }
 
 int sgn(float f) {
@@ -284,43 +301,70 @@ bool MapCollision::isValidPosition(const float& x, const float& y, int movement_
 /**
  * Does not have the "slide" submovement that move() features
  * Line can be arbitrary angles.
+ *
+ * Visits every tile that the line passes through (Amanatides & Woo grid traversal).
+ * Positions are converted to fixed point, so tile boundary crossings are compared exactly with integer math.
+ * If the line passes exactly through a tile corner, we step diagonally.
+ * When ignore_target is true, the end tile is treated as empty (e.g. it contains the entity we're checking against).
  */
-bool MapCollision::lineCheck(const float& x1, const float& y1, const float& x2, const float& y2, int check_type, int movement_type) {
-	float x = x1;
-	float y = y1;
-	float dx = static_cast<float>(fabs(x2 - x1));
-	float dy = static_cast<float>(fabs(y2 - y1));
-	float step_x;
-	float step_y;
-	int steps = static_cast<int>(std::max(dx, dy));
-
-
-	if (dx > dy) {
-		step_x = 1;
-		step_y = dy / dx;
-	}
-	else {
-		step_y = 1;
-		step_x = dx / dy;
-	}
-	// fix signs
-	if (x1 > x2) step_x = -step_x;
-	if (y1 > y2) step_y = -step_y;
+bool MapCollision::lineCheck(const float& x1, const float& y1, const float& x2, const float& y2, int check_type, int movement_type, bool ignore_target) const {
+	int tile_x = static_cast<int>(floorf(x1));
+	int tile_y = static_cast<int>(floorf(y1));
+	const int end_x = static_cast<int>(floorf(x2));
+	const int end_y = static_cast<int>(floorf(y2));
+
+	const int64_t start_fx = static_cast<int64_t>(floorf(x1 * LINE_CHECK_PRECISION));
+	const int64_t start_fy = static_cast<int64_t>(floorf(y1 * LINE_CHECK_PRECISION));
+	const int64_t end_fx = static_cast<int64_t>(floorf(x2 * LINE_CHECK_PRECISION));
+	const int64_t end_fy = static_cast<int64_t>(floorf(y2 * LINE_CHECK_PRECISION));
+
+	const int step_x = (end_x > tile_x) ? 1 : ((end_x < tile_x) ? -1 : 0);
+	const int step_y = (end_y > tile_y) ? 1 : ((end_y < tile_y) ? -1 : 0);
+	const int64_t delta_x = (end_fx > start_fx) ? end_fx - start_fx : start_fx - end_fx;
+	const int64_t delta_y = (end_fy > start_fy) ? end_fy - start_fy : start_fy - end_fy;
+
+	// distance along each axis to the first tile boundary
+	int64_t edge_x = 0;
+	int64_t edge_y = 0;
+	if (step_x > 0) edge_x = static_cast<int64_t>(tile_x + 1) * LINE_CHECK_PRECISION - start_fx;
+	else if (step_x < 0) edge_x = start_fx - static_cast<int64_t>(tile_x) * LINE_CHECK_PRECISION;
+	if (step_y > 0) edge_y = static_cast<int64_t>(tile_y + 1) * LINE_CHECK_PRECISION - start_fy;
+	else if (step_y < 0) edge_y = start_fy - static_cast<int64_t>(tile_y) * LINE_CHECK_PRECISION;
+
+	int steps = abs(end_x - tile_x) + abs(end_y - tile_y);
+
+	while (steps > 0 && !(tile_x == end_x && tile_y == end_y)) {
+		// compare the line parameter of the next x and y crossings: edge_x/delta_x vs edge_y/delta_y
+		int64_t cross_x = edge_x * delta_y;
+		int64_t cross_y = edge_y * delta_x;
+
+		if (step_y == 0 || (step_x != 0 && cross_x < cross_y)) {
+			tile_x += step_x;
+			edge_x += LINE_CHECK_PRECISION;
+			steps--;
+		}
+		else if (step_x == 0 || cross_y < cross_x) {
+			tile_y += step_y;
+			edge_y += LINE_CHECK_PRECISION;
+			steps--;
+		}
+		else {
+			tile_x += step_x;
+			tile_y += step_y;
+			edge_x += LINE_CHECK_PRECISION;
+			edge_y += LINE_CHECK_PRECISION;
+			steps -= 2;
+		}
 
+		if (ignore_target && tile_x == end_x && tile_y == end_y)
+			break;
 
-	if (check_type == CHECK_SIGHT) {
-		for (int i=0; i<steps; i++) {
-			x += step_x;
-			y += step_y;
-			if (isWall(x, y))
+		if (check_type == CHECK_SIGHT) {
+			if (isTileOutsideMap(tile_x, tile_y) || colmap[tile_x][tile_y] == BLOCKS_ALL || colmap[tile_x][tile_y] == BLOCKS_ALL_HIDDEN)
 				return false;
 		}
-	}
-	else if (check_type == CHECK_MOVEMENT) {
-		for (int i=0; i<steps; i++) {
-			x += step_x;
-			y += step_y;
-			if (!isValidPosition(x, y, movement_type, COLLIDE_NORMAL))
+		else if (check_type == CHECK_MOVEMENT) {
+			if (!isValidTile(tile_x, tile_y, movement_type, COLLIDE_NORMAL))
 				return false;
 		}
 	}
@@ -328,8 +372,60 @@ bool MapCollision::lineCheck(const float& x1, const float& y1, const float& x2,
 	return true;
 }
 
+/**
+ * Line checks are cached by tile until the end of the frame, or until the collision layer changes.
+ * Sight only depends on walls, so those results survive entities moving around.
+ */
+uint64_t MapCollision::getLineCacheKey(int x1, int y1, int x2, int y2, int check_type, int movement_type) const {
+	// sight is symmetric, so both directions share an entry
+	if (check_type == CHECK_SIGHT && (x2 < x1 || (x2 == x1 && y2 < y1))) {
+		std::swap(x1, x2);
+		std::swap(y1, y2);
+	}
+
+	uint64_t key = static_cast<uint64_t>(x1 & 0x3fff);
+	key = (key << 14) | static_cast<uint64_t>(y1 & 0x3fff);
+	key = (key << 14) | static_cast<uint64_t>(x2 & 0x3fff);
+	key = (key << 14) | static_cast<uint64_t>(y2 & 0x3fff);
+	key = (key << 2) | static_cast<uint64_t>(check_type & 0x3);
+	key = (key << 2) | static_cast<uint64_t>(movement_type & 0x3);
+	return key;
+}
+
+bool MapCollision::cachedLineCheck(const float& x1, const float& y1, const float& x2, const float& y2, int check_type, int movement_type, bool ignore_target) {
+	if (x1 < 0 || y1 < 0 || x2 < 0 || y2 < 0 || isOutsideMap(x1, y1) || isOutsideMap(x2, y2))
+		return lineCheck(x1, y1, x2, y2, check_type, movement_type, ignore_target);
+
+	uint64_t key = getLineCacheKey(static_cast<int>(x1), static_cast<int>(y1), static_cast<int>(x2), static_cast<int>(y2), check_type, movement_type);
+	unsigned version = (check_type == CHECK_SIGHT) ? wall_version : tile_version;
+
+	std::map<uint64_t, LineCacheEntry>::iterator it = line_cache.find(key);
+	if (it != line_cache.end() && it->second.version == version)
+		return it->second.result;
+
+	LineCacheEntry& entry = line_cache[key];
+	entry.result = lineCheck(x1, y1, x2, y2, check_type, movement_type, ignore_target);
+	entry.version = version;
+	return entry.result;
+}
+
+/**
+ * Per-frame upkeep: rebuild region labels if needed and drop cached line checks
+ */
+void MapCollision::logic() {
+	updateRegions();
+	line_cache.clear();
+}
+
 bool MapCollision::lineOfSight(const float& x1, const float& y1, const float& x2, const float& y2) {
-	return lineCheck(x1, y1, x2, y2, CHECK_SIGHT, MOVE_NORMAL);
+	return cachedLineCheck(x1, y1, x2, y2, CHECK_SIGHT, MOVE_NORMAL, false);
+}
+
+/**
+ * Same as lineOfSight(), but doesn't touch the line cache, so it can be called from worker threads
+ */
+bool MapCollision::uncachedLineOfSight(const float& x1, const float& y1, const float& x2, const float& y2) const {
+	return lineCheck(x1, y1, x2, y2, CHECK_SIGHT, MOVE_NORMAL, false);
 }
 
 bool MapCollision::lineOfMovement(const float& x1, const float& y1, const float& x2, const float& y2, int movement_type) {
@@ -338,21 +434,12 @@ bool MapCollision::lineOfMovement(const float& x1, const float& y1, const float&
 	// intangible entities can always move
 	if (movement_type == MOVE_INTANGIBLE) return true;
 
-	// if the target is blocking, clear it temporarily
+	// if the target is blocking, ignore it
 	int tile_x = int(x2);
 	int tile_y = int(y2);
-	bool target_blocks = false;
-	int target_blocks_type = colmap[tile_x][tile_y];
-	if (colmap[tile_x][tile_y] == BLOCKS_ENTITIES || colmap[tile_x][tile_y] == BLOCKS_ENEMIES) {
-		target_blocks = true;
-		unblock(x2,y2);
-	}
-
-	bool has_movement = lineCheck(x1, y1, x2, y2, CHECK_MOVEMENT, movement_type);
-
-	if (target_blocks) block(x2,y2, target_blocks_type == BLOCKS_ENEMIES);
-	return has_movement;
+	bool target_blocks = (colmap[tile_x][tile_y] == BLOCKS_ENTITIES || colmap[tile_x][tile_y] == BLOCKS_ENEMIES);
 
+	return cachedLineCheck(x1, y1, x2, y2, CHECK_MOVEMENT, movement_type, target_blocks);
 }
 
 /**
@@ -383,13 +470,158 @@ bool MapCollision::isFacing(const float& x1, const float& y1, char direction, co
 	return false;
 }
 
+/**
+ * Is this tile part of the walkable area for this movement type?
+ * Entities are ignored, since they don't permanently block a tile.
+ */
+bool MapCollision::isRegionTile(const int& tile_x, const int& tile_y, int movement_type) const {
+	unsigned short tile = colmap[tile_x][tile_y];
+
+	if (movement_type == MOVE_FLYING)
+		return !(tile == BLOCKS_ALL || tile == BLOCKS_ALL_HIDDEN);
+
+	return (tile == BLOCKS_NONE || tile == MAP_ONLY || tile == MAP_ONLY_ALT || tile == BLOCKS_ENTITIES || tile == BLOCKS_ENEMIES);
+}
+
+/**
+ * Flood fill the map, giving each connected area of valid tiles its own label
+ */
+void MapCollision::labelRegions(int movement_type) {
+	Region_Layer& layer = regions[movement_type];
+
+	layer.resize(map_size.x);
+	for (int i = 0; i < map_size.x; ++i) {
+		layer[i].assign(map_size.y, 0);
+	}
+
+	unsigned label = 0;
+	std::vector<Point> stack;
+
+	for (int x = 0; x < map_size.x; ++x) {
+		for (int y = 0; y < map_size.y; ++y) {
+			if (layer[x][y] != 0 || !isRegionTile(x, y, movement_type))
+				continue;
+
+			label++;
+			layer[x][y] = label;
+			stack.push_back(Point(x, y));
+
+			while (!stack.empty()) {
+				Point p = stack.back();
+				stack.pop_back();
+
+				// same 8-way neighbours as the pathfinder
+				for (int i = -1; i <= 1; ++i) {
+					for (int j = -1; j <= 1; ++j) {
+						int nx = p.x + i;
+						int ny = p.y + j;
+						if ((i == 0 && j == 0) || isTileOutsideMap(nx, ny))
+							continue;
+						if (layer[nx][ny] != 0 || !isRegionTile(nx, ny, movement_type))
+							continue;
+
+						layer[nx][ny] = label;
+						stack.push_back(Point(nx, ny));
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Mark the region labels as outdated. Call this after changing colmap directly.
+ */
+void MapCollision::invalidateRegions() {
+	regions_dirty = true;
+	wall_version++;
+	tile_version++;
+}
+
+/**
+ * Recompute the region labels if the collision layer has changed
+ */
+void MapCollision::updateRegions() {
+	if (!regions_dirty)
+		return;
+
+	labelRegions(MOVE_NORMAL);
+	labelRegions(MOVE_FLYING);
+	regions_dirty = false;
+}
+
+unsigned MapCollision::getRegion(const int& tile_x, const int& tile_y, int movement_type) const {
+	if (movement_type == MOVE_INTANGIBLE || isTileOutsideMap(tile_x, tile_y))
+		return 0;
+
+	const Region_Layer& layer = regions[movement_type];
+	if (tile_x >= static_cast<int>(layer.size()) || tile_y >= static_cast<int>(layer[tile_x].size()))
+		return 0;
+
+	return layer[tile_x][tile_y];
+}
+
+/**
+ * Checks if there is any possible path between two positions, ignoring entities
+ * If either position is not part of a region (e.g. an enemy standing in a wall), we can't tell, so return true
+ */
+bool MapCollision::isReachable(const FPoint& start, const FPoint& end, int movement_type) const {
+	if (movement_type == MOVE_INTANGIBLE)
+		return true;
+
+	unsigned start_region = getRegion(static_cast<int>(start.x), static_cast<int>(start.y), movement_type);
+	unsigned end_region = getRegion(static_cast<int>(end.x), static_cast<int>(end.y), movement_type);
+
+	if (start_region == 0 || end_region == 0)
+		return true;
+
+	return start_region == end_region;
+}
+
+/**
+ * Search outwards from the target for the closest tile in the given region
+ * Returns the target itself if no such tile exists
+ */
+Point MapCollision::getNearestTileInRegion(const Point& target, unsigned region, int movement_type) const {
+	int max_range = std::max(map_size.x, map_size.y);
+
+	for (int range = 1; range < max_range; ++range) {
+		Point best = target;
+		int best_dist = -1;
+
+		// check the ring of tiles at this range
+		for (int i = -range; i <= range; ++i) {
+			for (int j = -range; j <= range; ++j) {
+				if (abs(i) != range && abs(j) != range)
+					continue;
+
+				int x = target.x + i;
+				int y = target.y + j;
+				if (getRegion(x, y, movement_type) != region)
+					continue;
+
+				int dist = i*i + j*j;
+				if (best_dist == -1 || dist < best_dist) {
+					best_dist = dist;
+					best = Point(x, y);
+				}
+			}
+		}
+
+		if (best_dist != -1)
+			return best;
+	}
+
+	return target;
+}
+
 /**
 * Compute a path from (x1,y1) to (x2,y2)
 * Store waypoint inside path
 * limit is the maximum number of explored node
 * @return true if a path is found
 */
-bool MapCollision::computePath(const FPoint& start_pos, const FPoint& end_pos, std::vector<FPoint> &path, int movement_type, unsigned int limit) {
+bool MapCollision::computePath(const FPoint& start_pos, const FPoint& end_pos, std::vector<FPoint> &path, int movement_type, unsigned int limit) const {
 
 	if (isOutsideMap(end_pos.x, end_pos.y)) return false;
 
@@ -405,14 +637,19 @@ bool MapCollision::computePath(const FPoint& start_pos, const FPoint& end_pos, s
 	Point start(start_pos);
 	Point end(end_pos);
 
-	// if the target square has an entity, temporarily clear it to compute the path
-	bool target_blocks = false;
-	int target_blocks_type = colmap[end.x][end.y];
-	if (colmap[end.x][end.y] == BLOCKS_ENTITIES || colmap[end.x][end.y] == BLOCKS_ENEMIES) {
-		target_blocks = true;
-		unblock(end_pos.x, end_pos.y);
+	// if the target is in a different region, no path exists
+	// instead of searching until the node limit is hit, go to the closest tile we can actually reach
+	if (!isReachable(start_pos, end_pos, movement_type)) {
+		unsigned start_region = getRegion(start.x, start.y, movement_type);
+		end = getNearestTileInRegion(end, start_region, movement_type);
+		if (end.x == start.x && end.y == start.y)
+			return false;
 	}
 
+	// if the target square has an entity, treat it as empty while computing the path
+	// the map itself is left untouched, so this can be called on a shared snapshot
+	const bool target_blocks = (colmap[end.x][end.y] == BLOCKS_ENTITIES || colmap[end.x][end.y] == BLOCKS_ENEMIES);
+
 	Point current = start;
 	AStarNode* node = new AStarNode(start);
 	node->setActualCost(0);
@@ -448,7 +685,7 @@ bool MapCollision::computePath(const FPoint& start_pos, const FPoint& end_pos, s
 			}
 
 			// if neighbour is not free of any collision, skip it
-			if (!isValidTile(neighbour.x,neighbour.y,movement_type, MapCollision::COLLIDE_NORMAL))
+			if (!(target_blocks && neighbour.x == end.x && neighbour.y == end.y) && !isValidTile(neighbour.x,neighbour.y,movement_type, MapCollision::COLLIDE_NORMAL))
 				continue;
 			// if nabour is already in close, skip it
 			if(close.exists(neighbour))
@@ -494,9 +731,6 @@ bool MapCollision::computePath(const FPoint& start_pos, const FPoint& end_pos, s
 			current = close.get(current.x, current.y)->getParent();
 		}
 	}
-	// reblock target if needed
-	if (target_blocks) block(end_pos.x, end_pos.y, target_blocks_type == BLOCKS_ENEMIES);
-
 	return !path.empty();
 }
 
@@ -512,6 +746,7 @@ void MapCollision::block(const float& map_x, const float& map_y, bool is_ally) {
 			colmap[tile_x][tile_y] = BLOCKS_ENEMIES;
 		else
 			colmap[tile_x][tile_y] = BLOCKS_ENTITIES;
+		tile_version++;
 	}
 
 }
@@ -525,6 +760,7 @@ void MapCollision::unblock(const float& map_x, const float& map_y) {
 
 	if (colmap[tile_x][tile_y] == BLOCKS_ENTITIES || colmap[tile_x][tile_y] == BLOCKS_ENEMIES) {
 		colmap[tile_x][tile_y] = BLOCKS_NONE;
+		tile_version++;
 	}
 
 }
@@ -553,7 +789,7 @@ FPoint MapCollision::getRandomNeighbor(const Point& target, int range, bool igno
 		return FPoint(target);
 }
 
-FPoint MapCollision::collisionToMap(const Point& p) {
+FPoint MapCollision::collisionToMap(const Point& p) const {
 	FPoint ret;
 	ret.x = static_cast<float>(p.x) + 0.5f;
 	ret.y = static_cast<float>(p.y) + 0.5f;
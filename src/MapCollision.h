@@ -30,6 +30,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "Utils.h"
 
 typedef std::vector< std::vector<unsigned short> > Map_Layer;
+typedef std::vector< std::vector<unsigned> > Region_Layer;
 
 class MapCollision {
 private:
@@ -43,7 +44,18 @@ private:
 
 	bool isTileOutsideMap(const int& tile_x, const int& tile_y) const;
 
-	bool lineCheck(const float& x1, const float& y1, const float& x2, const float& y2, int check_type, int movement_type);
+	static const int64_t LINE_CHECK_PRECISION;
+
+	class LineCacheEntry {
+	public:
+		bool result;
+		unsigned version;
+		LineCacheEntry();
+	};
+
+	bool lineCheck(const float& x1, const float& y1, const float& x2, const float& y2, int check_type, int movement_type, bool ignore_target) const;
+	bool cachedLineCheck(const float& x1, const float& y1, const float& x2, const float& y2, int check_type, int movement_type, bool ignore_target);
+	uint64_t getLineCacheKey(int x1, int y1, int x2, int y2, int check_type, int movement_type) const;
 
 	bool smallStepForcedSlideAlongGrid(
 		float &x, float &y, float step_x, float step_y, int movement_type, int collide_type);
@@ -54,7 +66,23 @@ private:
 
 	bool isValidTile(const int& x, const int& y, int movement_type, int collide_type) const;
 
-	FPoint collisionToMap(const Point& p);
+	FPoint collisionToMap(const Point& p) const;
+
+	bool isRegionTile(const int& tile_x, const int& tile_y, int movement_type) const;
+	void labelRegions(int movement_type);
+	unsigned getRegion(const int& tile_x, const int& tile_y, int movement_type) const;
+	Point getNearestTileInRegion(const Point& target, unsigned region, int movement_type) const;
+
+	// connected areas for each movement type, ignoring entities
+	// 0 means the tile can't be entered with that movement type
+	Region_Layer regions[2];
+	bool regions_dirty;
+
+	// line checks done this frame
+	// wall_version changes when walls change; tile_version changes when any tile changes, including entity blocking
+	std::map<uint64_t, LineCacheEntry> line_cache;
+	unsigned wall_version;
+	unsigned tile_version;
 
 public:
 	// const flags
@@ -95,6 +123,7 @@ public:
 	~MapCollision();
 
 	void setMap(const Map_Layer& _colmap, unsigned short w, unsigned short h);
+	void logic();
 	bool move(float &x, float &y, float step_x, float step_y, int movement_type, int collide_type);
 
 	bool isOutsideMap(const float& tile_x, const float& tile_y) const;
@@ -104,11 +133,16 @@ public:
 	bool isValidPosition(const float& x, const float& y, int movement_type, int collide_type) const;
 
 	bool lineOfSight(const float& x1, const float& y1, const float& x2, const float& y2);
+	bool uncachedLineOfSight(const float& x1, const float& y1, const float& x2, const float& y2) const;
 	bool lineOfMovement(const float& x1, const float& y1, const float& x2, const float& y2, int movement_type);
 
 	bool isFacing(const float& x1, const float& y1, char direction, const float& x2, const float& y2);
 
-	bool computePath(const FPoint& start, const FPoint& end, std::vector<FPoint> &path, int movement_type, unsigned int limit);
+	bool isReachable(const FPoint& start, const FPoint& end, int movement_type) const;
+	void invalidateRegions();
+	void updateRegions();
+
+	bool computePath(const FPoint& start, const FPoint& end, std::vector<FPoint> &path, int movement_type, unsigned int limit) const;
 
 	void block(const float& map_x, const float& map_y, bool is_ally);
 	void unblock(const float& map_x, const float& map_y);
@@ -63,6 +63,8 @@ MapRenderer::MapRenderer()
 	, show_tooltip(false)
 	, entity_hidden_normal(NULL)
 	, entity_hidden_enemy(NULL)
+	, event_index()
+	, event_candidates()
 	, cam()
 	, map_change(false)
 	, teleportation(false)
@@ -305,32 +307,51 @@ void MapRenderer::logic(bool paused) {
 	if (paused)
 		return;
 
-	// handle statblock logic for map powers
-	for (unsigned i=0; i<statblocks.size(); ++i) {
-		for (size_t j=0; j<statblocks[i].powers_ai.size(); ++j) {
-			statblocks[i].powers_ai[j].cooldown.tick();
+	// handle the timers that are due this frame
+	std::vector<TimerWheel::Expired> expired;
+	timers.advance(expired);
+
+	std::vector<size_t> due_delayed_events;
+
+	for (size_t i = 0; i < expired.size(); ++i) {
+		const TimerWheel::Expired& timer = expired[i];
+
+		if (timer.type == TIMER_POWER_COOLDOWN) {
+			if (timer.id < statblocks.size())
+				statblocks[timer.id].powers_ai[0].cooldown.reset(Timer::END);
 		}
-	}
+		else if (timer.type == TIMER_DELAYED_EVENT) {
+			due_delayed_events.push_back(timer.id);
+		}
+		else {
+			Event* ev = getEventBySerial(timer.id);
+			if (!ev)
+				continue;
 
-	// handle event cooldowns
-	std::vector<Event>::iterator it;
-	for (it = events.begin(); it < events.end(); ++it) {
-		if (!it->delay.isEnd())
-			it->delay.tick();
-		else
-			it->cooldown.tick();
+			if (timer.type == TIMER_EVENT_DELAY) {
+				ev->delay.reset(Timer::END);
+				if (!ev->cooldown.isEnd())
+					timers.schedule(ev->cooldown.getCurrent(), TIMER_EVENT_COOLDOWN, ev->serial);
+			}
+			else {
+				ev->cooldown.reset(Timer::END);
+			}
+		}
 	}
 
-	// handle delayed events
-	for (it = delayed_events.end(); it != delayed_events.begin(); ) {
-		--it;
+	// handle delayed events, newest first
+	std::sort(due_delayed_events.begin(), due_delayed_events.end(), std::greater<size_t>());
+	for (size_t i = 0; i < due_delayed_events.size(); ++i) {
+		std::map<size_t, Event>::iterator it = delayed_events.find(due_delayed_events[i]);
+		if (it == delayed_events.end())
+			continue;
 
-		it->delay.tick();
+		// executing the event can change the list, so it is removed first
+		Event ev = it->second;
+		delayed_events.erase(it);
 
-		if (it->delay.isEnd()) {
-			EventManager::executeDelayedEvent(*it);
-			it = delayed_events.erase(it);
-		}
+		ev.delay.reset(Timer::END);
+		EventManager::executeDelayedEvent(ev);
 	}
 
 	cam.logic();
@@ -1077,8 +1098,10 @@ void MapRenderer::executeOnLoadEvents() {
 		if (!EventManager::isActive(*it)) continue;
 
 		if ((*it).activate_type == Event::ACTIVATE_ON_LOAD) {
-			if (EventManager::executeEvent(*it))
+			if (EventManager::executeMapEvent(*it)) {
 				it = events.erase(it);
+				invalidateEventIndex();
+			}
 		}
 	}
 
@@ -1092,8 +1115,10 @@ void MapRenderer::executeOnLoadEvents() {
 		if (!EventManager::isActive(*it)) continue;
 
 		if ((*it).activate_type == Event::ACTIVATE_STATIC) {
-			if (EventManager::executeEvent(*it))
+			if (EventManager::executeMapEvent(*it)) {
 				it = events.erase(it);
+				invalidateEventIndex();
+			}
 		}
 	}
 }
@@ -1111,7 +1136,7 @@ void MapRenderer::executeOnMapExitEvents() {
 		if (!EventManager::isActive(*it)) continue;
 
 		if ((*it).activate_type == Event::ACTIVATE_ON_MAPEXIT)
-			EventManager::executeEvent(*it); // ignore repeat value
+			EventManager::executeMapEvent(*it); // ignore repeat value
 	}
 }
 
@@ -1119,52 +1144,57 @@ void MapRenderer::checkEvents(const FPoint& loc) {
 	Point maploc;
 	maploc.x = int(loc.x);
 	maploc.y = int(loc.y);
-	std::vector<Event>::iterator it;
 
-	// loop in reverse because we may erase elements
-	for (it = events.end(); it != events.begin(); ) {
-		--it;
+	updateEventIndex();
+	event_index.getTriggerEvents(maploc, event_candidates);
+
+	// candidates are sorted from last to first, because we may erase elements
+	for (size_t i = 0; i < event_candidates.size(); ++i) {
+		size_t index = event_candidates[i];
+		if (index >= events.size()) continue;
+
+		Event& ev = events[index];
 
 		// skip inactive events
-		if (!EventManager::isActive(*it)) continue;
+		if (!EventManager::isActive(ev)) continue;
 
 		// static events are run every frame without interaction from the player
-		if ((*it).activate_type == Event::ACTIVATE_STATIC) {
-			if (EventManager::executeEvent(*it))
-				it = events.erase(it);
+		if (ev.activate_type == Event::ACTIVATE_STATIC) {
+			if (EventManager::executeMapEvent(ev))
+				eraseEvent(index);
 			continue;
 		}
 
-		if ((*it).activate_type == Event::ACTIVATE_ON_CLEAR) {
-			if (enemies_cleared && EventManager::executeEvent(*it))
-				it = events.erase(it);
+		if (ev.activate_type == Event::ACTIVATE_ON_CLEAR) {
+			if (enemies_cleared && EventManager::executeMapEvent(ev))
+				eraseEvent(index);
 			continue;
 		}
 
-		bool inside = maploc.x >= (*it).location.x &&
-					  maploc.y >= (*it).location.y &&
-					  maploc.x <= (*it).location.x + (*it).location.w-1 &&
-					  maploc.y <= (*it).location.y + (*it).location.h-1;
+		bool inside = maploc.x >= ev.location.x &&
+					  maploc.y >= ev.location.y &&
+					  maploc.x <= ev.location.x + ev.location.w-1 &&
+					  maploc.y <= ev.location.y + ev.location.h-1;
 
-		if ((*it).activate_type == Event::ACTIVATE_ON_LEAVE) {
+		if (ev.activate_type == Event::ACTIVATE_ON_LEAVE) {
 			if (inside) {
-				if (!(*it).getComponent(EventComponent::WAS_INSIDE_EVENT_AREA)) {
-					(*it).components.push_back(EventComponent());
-					(*it).components.back().type = EventComponent::WAS_INSIDE_EVENT_AREA;
+				if (!ev.getComponent(EventComponent::WAS_INSIDE_EVENT_AREA)) {
+					ev.components.push_back(EventComponent());
+					ev.components.back().type = EventComponent::WAS_INSIDE_EVENT_AREA;
 				}
 			}
 			else {
-				if ((*it).getComponent(EventComponent::WAS_INSIDE_EVENT_AREA)) {
-					(*it).deleteAllComponents(EventComponent::WAS_INSIDE_EVENT_AREA);
-					if (EventManager::executeEvent(*it))
-						it = events.erase(it);
+				if (ev.getComponent(EventComponent::WAS_INSIDE_EVENT_AREA)) {
+					ev.deleteAllComponents(EventComponent::WAS_INSIDE_EVENT_AREA);
+					if (EventManager::executeMapEvent(ev))
+						eraseEvent(index);
 				}
 			}
 		}
-		else if ((*it).activate_type == Event::ACTIVATE_ON_TRIGGER) {
+		else if (ev.activate_type == Event::ACTIVATE_ON_TRIGGER) {
 			if (inside)
-				if (EventManager::executeEvent(*it))
-					it = events.erase(it);
+				if (EventManager::executeMapEvent(ev))
+					eraseEvent(index);
 		}
 	}
 }
@@ -1183,26 +1213,25 @@ void MapRenderer::checkHotspots() {
 
 	show_tooltip = false;
 
-	std::vector<Event>::iterator it;
+	// only the events whose graphics can be under the mouse need to be checked
+	updateEventIndex();
+	event_index.getHoveredHotspots(Utils::screenToMap(inpt->mouse.x, inpt->mouse.y, cam.shake.x, cam.shake.y), event_candidates);
 
-	// work backwards through events because events can be erased in the loop.
-	// this prevents the iterator from becoming invalid.
-	for (it = events.end(); it != events.begin(); ) {
-		--it;
+	// candidates are sorted from last to first, matching the order that the event list was searched in before
+	for (size_t i = 0; i < event_candidates.size(); ++i) {
+		size_t index = event_candidates[i];
+		Event& ev = events[index];
 
 		// skip inactive events
-		if (!EventManager::isActive(*it)) continue;
-
-		// skip events without hotspots
-		if (it->hotspot.h == 0) continue;
+		if (!EventManager::isActive(ev)) continue;
 
 		// skip events on cooldown
-		if (!it->cooldown.isEnd() || !it->delay.isEnd()) continue;
+		if (!ev.cooldown.isEnd() || !ev.delay.isEnd()) continue;
 
-		EventComponent* npc = (*it).getComponent(EventComponent::NPC_HOTSPOT);
+		EventComponent* npc = ev.getComponent(EventComponent::NPC_HOTSPOT);
 
-		for (int x=it->hotspot.x; x < it->hotspot.x + it->hotspot.w; ++x) {
-			for (int y=it->hotspot.y; y < it->hotspot.y + it->hotspot.h; ++y) {
+		for (int x=ev.hotspot.x; x < ev.hotspot.x + ev.hotspot.w; ++x) {
+			for (int y=ev.hotspot.y; y < ev.hotspot.y + ev.hotspot.h; ++y) {
 				bool matched = false;
 				bool is_npc = false;
 
@@ -1224,11 +1253,11 @@ void MapRenderer::checkHotspots() {
 					}
 				}
 				else {
-					for (unsigned index = 0; index <= index_objectlayer; ++index) {
+					for (unsigned index_layer = 0; index_layer <= index_objectlayer; ++index_layer) {
 						Point p = Utils::mapToScreen(float(x), float(y), cam.shake.x, cam.shake.y);
 						p = centerTile(p);
 
-						if (const short current_tile = layers[index][x][y]) {
+						if (const short current_tile = layers[index_layer][x][y]) {
 							// first check if mouse pointer is in rectangle of that tile:
 							const Tile_Def &tile = tset.tiles[current_tile];
 							Rect dest;
@@ -1239,7 +1268,7 @@ void MapRenderer::checkHotspots() {
 
 							if (Utils::isWithinRect(dest, inpt->mouse)) {
 								matched = true;
-								tip_pos = Utils::mapToScreen(it->center.x, it->center.y, cam.shake.x, cam.shake.y);
+								tip_pos = Utils::mapToScreen(ev.center.x, ev.center.y, cam.shake.x, cam.shake.y);
 								tip_pos.y -= eset->tileset.tile_h;
 							}
 						}
@@ -1248,10 +1277,10 @@ void MapRenderer::checkHotspots() {
 
 				if (matched) {
 					// new tooltip?
-					createTooltip(it->getComponent(EventComponent::TOOLTIP));
+					createTooltip(ev.getComponent(EventComponent::TOOLTIP));
 
-					if (((it->reachable_from.w == 0 && it->reachable_from.h == 0) || Utils::isWithinRect(it->reachable_from, Point(cam.pos)))
-							&& Utils::calcDist(pc->stats.pos, it->center) < eset->misc.interact_range) {
+					if (((ev.reachable_from.w == 0 && ev.reachable_from.h == 0) || Utils::isWithinRect(ev.reachable_from, Point(cam.pos)))
+							&& Utils::calcDist(pc->stats.pos, ev.center) < eset->misc.interact_range) {
 
 						// only check events if the player is clicking
 						// and allowed to click
@@ -1266,8 +1295,8 @@ void MapRenderer::checkHotspots() {
 						else if (pc->using_main1) return;
 
 						inpt->lock[Input::MAIN1] = true;
-						if (EventManager::executeEvent(*it))
-							it = events.erase(it);
+						if (EventManager::executeMapEvent(ev))
+							eraseEvent(index);
 					}
 					return;
 				}
@@ -1280,38 +1309,40 @@ void MapRenderer::checkHotspots() {
 void MapRenderer::checkNearestEvent() {
 	if (!inpt->usingMouse()) show_tooltip = false;
 
-	std::vector<Event>::iterator it;
-	std::vector<Event>::iterator nearest = events.end();
+	size_t nearest = events.size();
 	float best_distance = std::numeric_limits<float>::max();
 
-	// loop in reverse because we may erase elements
-	for (it = events.end(); it != events.begin(); ) {
-		--it;
+	updateEventIndex();
+	event_index.getHotspotsNear(pc->stats.pos, eset->misc.interact_range, event_candidates);
 
-		// skip inactive events
-		if (!EventManager::isActive(*it)) continue;
+	// candidates are sorted from last to first, so that ties are broken the same way as before
+	for (size_t i = 0; i < event_candidates.size(); ++i) {
+		size_t index = event_candidates[i];
+		Event& ev = events[index];
 
-		// skip events without hotspots
-		if (it->hotspot.h == 0) continue;
+		// skip inactive events
+		if (!EventManager::isActive(ev)) continue;
 
 		// skip events on cooldown
-		if (!it->cooldown.isEnd() || !it->delay.isEnd()) continue;
+		if (!ev.cooldown.isEnd() || !ev.delay.isEnd()) continue;
 
-		float distance = Utils::calcDist(pc->stats.pos, it->center);
-		if (((it->reachable_from.w == 0 && it->reachable_from.h == 0) || Utils::isWithinRect(it->reachable_from, Point(cam.pos)))
+		float distance = Utils::calcDist(pc->stats.pos, ev.center);
+		if (((ev.reachable_from.w == 0 && ev.reachable_from.h == 0) || Utils::isWithinRect(ev.reachable_from, Point(cam.pos)))
 				&& distance < eset->misc.interact_range && distance < best_distance) {
 			best_distance = distance;
-			nearest = it;
+			nearest = index;
 		}
 
 	}
 
-	if (nearest != events.end()) {
+	if (nearest < events.size()) {
+		Event& ev = events[nearest];
+
 		if (!inpt->usingMouse() || settings->touchscreen) {
 			// new tooltip?
-			createTooltip(nearest->getComponent(EventComponent::TOOLTIP));
-			tip_pos = Utils::mapToScreen(nearest->center.x, nearest->center.y, cam.shake.x, cam.shake.y);
-			if (nearest->getComponent(EventComponent::NPC_HOTSPOT)) {
+			createTooltip(ev.getComponent(EventComponent::TOOLTIP));
+			tip_pos = Utils::mapToScreen(ev.center.x, ev.center.y, cam.shake.x, cam.shake.y);
+			if (ev.getComponent(EventComponent::NPC_HOTSPOT)) {
 				tip_pos.y -= eset->tooltips.margin_npc;
 			}
 			else {
@@ -1322,10 +1353,63 @@ void MapRenderer::checkNearestEvent() {
 		if (inpt->pressing[Input::ACCEPT] && !inpt->lock[Input::ACCEPT]) {
 			inpt->lock[Input::ACCEPT] = true;
 
-			if(EventManager::executeEvent(*nearest))
-				events.erase(nearest);
+			if(EventManager::executeMapEvent(ev))
+				eraseEvent(nearest);
+		}
+	}
+}
+
+/**
+ * Rebuild the event index if the event list has changed since it was built
+ */
+void MapRenderer::updateEventIndex() {
+	if (!event_index_outdated)
+		return;
+
+	event_index_outdated = false;
+
+	std::vector<float> hotspot_margins(events.size(), 0);
+	for (size_t i = 0; i < events.size(); ++i) {
+		if (events[i].hotspot.h != 0)
+			hotspot_margins[i] = getHotspotMargin(events[i]);
+	}
+
+	event_index.build(events, w, h, hotspot_margins);
+}
+
+/**
+ * How far (in map units) the tile graphics in an event's hotspot can reach outside of the hotspot.
+ * checkHotspots() matches the mouse against these graphics, not the hotspot area itself.
+ */
+float MapRenderer::getHotspotMargin(const Event& ev) {
+	int extent_x = 0;
+	int extent_y = 0;
+
+	for (int x = ev.hotspot.x; x < ev.hotspot.x + ev.hotspot.w; ++x) {
+		for (int y = ev.hotspot.y; y < ev.hotspot.y + ev.hotspot.h; ++y) {
+			for (unsigned index = 0; index <= index_objectlayer && index < layers.size(); ++index) {
+				if (x < 0 || y < 0 || static_cast<size_t>(x) >= layers[index].size() || static_cast<size_t>(y) >= layers[index][x].size())
+					continue;
+
+				const unsigned short current_tile = layers[index][x][y];
+				if (current_tile == 0 || current_tile >= tset.tiles.size() || !tset.tiles[current_tile].tile)
+					continue;
+
+				const Tile_Def &tile = tset.tiles[current_tile];
+				const Rect& clip = tile.tile->getClip();
+				extent_x = std::max(extent_x, std::max(tile.offset.x, clip.w - tile.offset.x));
+				extent_y = std::max(extent_y, std::max(tile.offset.y, clip.h - tile.offset.y));
+			}
 		}
 	}
+
+	// covers both orientations; isometric tiles only need half of this
+	return eset->tileset.units_per_pixel_x * static_cast<float>(extent_x) + eset->tileset.units_per_pixel_y * static_cast<float>(extent_y);
+}
+
+void MapRenderer::eraseEvent(size_t index) {
+	events.erase(events.begin() + index);
+	invalidateEventIndex();
 }
 
 void MapRenderer::checkTooltip() {
@@ -1360,6 +1444,8 @@ void MapRenderer::activatePower(PowerID power_index, unsigned statblock_index, c
 		// check power cooldown before activating
 		if (statblocks[statblock_index].powers_ai[0].cooldown.isEnd()) {
 			statblocks[statblock_index].powers_ai[0].cooldown.setDuration(powers->powers[power_index].cooldown);
+			if (!statblocks[statblock_index].powers_ai[0].cooldown.isEnd())
+				timers.schedule(powers->powers[power_index].cooldown, TIMER_POWER_COOLDOWN, statblock_index);
 			powers->activate(power_index, &statblocks[statblock_index], target);
 		}
 	}
@@ -30,6 +30,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 
 #include "Camera.h"
 #include "CommonIncludes.h"
+#include "EventIndex.h"
 #include "Map.h"
 #include "MapCollision.h"
 #include "MapParallax.h"
@@ -74,6 +75,10 @@ private:
 
 	void createTooltip(EventComponent *ec);
 
+	void updateEventIndex();
+	float getHotspotMargin(const Event& ev);
+	void eraseEvent(size_t index);
+
 	void getTileBounds(const int_fast16_t x, const int_fast16_t y, const Map_Layer& layerdata, Rect& bounds, Point& center);
 
 	void drawDevCursor();
@@ -92,6 +97,9 @@ private:
 
 	std::vector<std::vector<Renderable>::iterator> hidden_entities;
 
+	EventIndex event_index;
+	std::vector<size_t> event_candidates; // reused by the per-frame event checks
+
 public:
 	// functions
 	MapRenderer();
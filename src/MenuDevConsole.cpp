@@ -452,16 +452,15 @@ void MenuDevConsole::execute() {
 
 		std::vector<size_t> matching_ids;
 
-		std::map<size_t, Item>::iterator item_it;
-		for (item_it = items->items.begin(); item_it != items->items.end(); ++item_it) {
-			if (!item_it->second.has_name)
+		for (ItemID id = 0; id < items->items.getIDLimit(); ++id) {
+			if (!items->items[id].has_name)
 				continue;
 
-			std::string item_name = items->getItemName(static_cast<int>(item_it->first));
+			std::string item_name = items->getItemName(id);
 			if (!search_terms.empty() && Utils::stringFindCaseInsensitive(item_name, search_terms) == std::string::npos)
 				continue;
 
-			matching_ids.push_back(item_it->first);
+			matching_ids.push_back(id);
 		}
 
 		if (!matching_ids.empty()) {
@@ -530,15 +529,15 @@ void MenuDevConsole::execute() {
 
 		std::vector<size_t> matching_ids;
 
-		std::map<size_t, Power>::iterator power_it;
-		for (power_it = powers->powers.begin(); power_it != powers->powers.end(); ++power_it) {
-			if (power_it->second.is_empty)
+		for (PowerID id = 0; id < powers->powers.getIDLimit(); ++id) {
+			const Power& power = powers->powers[id];
+			if (power.is_empty)
 				continue;
 
-			if (!search_terms.empty() && Utils::stringFindCaseInsensitive(power_it->second.name, search_terms) == std::string::npos)
+			if (!search_terms.empty() && Utils::stringFindCaseInsensitive(power.name, search_terms) == std::string::npos)
 				continue;
 
-			matching_ids.push_back(power_it->first);
+			matching_ids.push_back(id);
 		}
 
 		if (!matching_ids.empty()) {
@@ -1267,7 +1267,7 @@ void MenuInventory::applyItemSetBonuses() {
 	}
 	// apply item set bonuses
 	for (size_t i = 0; i < set.size(); ++i) {
-		ItemSet& temp_set = items->item_sets[set[i]];
+		const ItemSet& temp_set = items->item_sets[set[i]];
 		for (size_t j = 0; j < temp_set.bonus.size(); ++j) {
 			if (temp_set.bonus[j].requirement > quantity[i])
 				continue;
@@ -1305,6 +1305,7 @@ void MenuInventory::applyBonus(const BonusData* bdata) {
 		return; // don't add item effect
 	}
 
+	ed.symbol = symbols->intern(ed.id);
 	ed.type = Effect::getTypeFromString(ed.id);
 
 	EffectParams ep;
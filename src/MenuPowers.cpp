@@ -125,6 +125,7 @@ MenuPowers::MenuPowers()
 	, tab_control(NULL)
 	, tree_loaded(false)
 	, default_power_tab(-1)
+	, unlock_camp_version(0)
 	, newPowerNotification(false)
 {
 
@@ -653,6 +654,41 @@ bool MenuPowers::checkUpgrade(MenuPowersCell* pcell) {
 	return true;
 }
 
+/**
+ * Check if setUnlockedPowers() could change anything since logic() last ran it.
+ * Passive powers also depend on the hero's HP, MP, equipment flags, etc, so they are checked every time.
+ */
+bool MenuPowers::checkUnlocksChanged() {
+	if (unlock_camp_version != camp->getVersion() || unlock_powers_list != pc->stats.powers_list)
+		return true;
+
+	for (size_t i = 0; i < unlock_primary_stats.size(); ++i) {
+		if (unlock_primary_stats[i] != pc->stats.get_primary(i))
+			return true;
+	}
+
+	for (size_t i = 0; i < power_cell.size(); ++i) {
+		for (size_t j = 0; j < power_cell[i].cells.size(); ++j) {
+			MenuPowersCell* pcell = &power_cell[i].cells[j];
+			if (!powers->powers[pcell->id].passive)
+				continue;
+
+			bool can_unlock = pcell->is_unlocked || (!pcell->requires_point && pcell->upgrade_level <= 1) || std::find(pc->stats.powers_list.begin(), pc->stats.powers_list.end(), pcell->id) != pc->stats.powers_list.end();
+			if (pcell->is_unlocked != (can_unlock && checkRequirements(pcell)))
+				return true;
+		}
+
+		MenuPowersCell* current_pcell = power_cell[i].getCurrent();
+		if (current_pcell->is_unlocked) {
+			MenuPowersCell* bonus_pcell = power_cell[i].getBonusCurrent(current_pcell);
+			if (powers->powers[bonus_pcell->id].passive && bonus_pcell->passive_on != checkRequirements(current_pcell))
+				return true;
+		}
+	}
+
+	return false;
+}
+
 void MenuPowers::lockCell(MenuPowersCell* pcell) {
 	pcell->is_unlocked = false;
 
@@ -921,15 +957,9 @@ void MenuPowers::createTooltip(TooltipData* tip_data, MenuPowersCell* pcell, Pow
 
 	for (size_t i=0; i<pwr.post_effects.size(); ++i) {
 		std::stringstream ss;
-		EffectDef* effect_ptr = powers->getEffectDef(pwr.post_effects[i].id);
-
-		int effect_type = Effect::NONE;
-		if (effect_ptr) {
-			effect_type = effect_ptr->type;
-		}
-		else {
-			effect_type = Effect::getTypeFromString(pwr.post_effects[i].id);
-		}
+		const PostEffect& pe = pwr.post_effects[i];
+		const EffectDef* effect_ptr = (pe.def_index != PostEffect::NO_DEF ? &powers->effects[pe.def_index] : NULL);
+		int effect_type = pe.type;
 
 		if (Effect::typeIsStat(effect_type) ||
 		    Effect::typeIsDmgMin(effect_type) ||
@@ -1370,7 +1400,16 @@ void MenuPowers::logic() {
 		tablist.setNextTabList(&tablist_pow[default_power_tab]);
 	}
 
-	setUnlockedPowers();
+	if (checkUnlocksChanged()) {
+		setUnlockedPowers();
+
+		unlock_camp_version = camp->getVersion();
+		unlock_powers_list = pc->stats.powers_list;
+		unlock_primary_stats.resize(eset->primary_stats.list.size());
+		for (size_t i = 0; i < unlock_primary_stats.size(); ++i) {
+			unlock_primary_stats[i] = pc->stats.get_primary(i);
+		}
+	}
 
 	points_left = (pc->stats.level * pc->stats.power_points_per_level) - getPointsUsed();
 	if (points_left > 0) {
@@ -118,6 +118,7 @@ private:
 	bool checkUnlocked(MenuPowersCell* pcell);
 	bool checkUnlock(MenuPowersCell* pcell);
 	bool checkUpgrade(MenuPowersCell* pcell);
+	bool checkUnlocksChanged();
 	void lockCell(MenuPowersCell* pcell);
 	bool isBonusCell(MenuPowersCell* pcell);
 	bool isCellVisible(MenuPowersCell* pcell);
@@ -157,6 +158,11 @@ private:
 
 	std::vector<MenuPowersCell*> recently_locked_cells;
 
+	// what setUnlockedPowers() depended on the last time that logic() ran it
+	unsigned unlock_camp_version;
+	std::vector<PowerID> unlock_powers_list;
+	std::vector<int> unlock_primary_stats;
+
 public:
 	enum {
 		TOOLTIP_SHORT = 0,
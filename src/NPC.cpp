@@ -516,6 +516,11 @@ void NPC::moveMapEvents() {
 	{
 		if (mapr->events[i].type == filename)
 		{
+			// npc hotspots are checked every frame, but any other event of this npc is indexed by position
+			if (!mapr->events[i].getComponent(EventComponent::NPC_HOTSPOT)
+					&& (mapr->events[i].location.x != static_cast<int>(stats.pos.x) || mapr->events[i].location.y != static_cast<int>(stats.pos.y)))
+				mapr->invalidateEventIndex();
+
 			mapr->events[i].location.x = static_cast<int>(stats.pos.x);
 			mapr->events[i].location.y = static_cast<int>(stats.pos.y);
 
@@ -645,6 +650,7 @@ bool NPC::processDialog(unsigned int dialog_node, unsigned int &event_cursor) {
 					entitym->entities.push_back(this);
 				}
 				else {
+					entitym->grid.remove(this);
 					for (size_t i = entitym->entities.size(); i > 0; --i) {
 						if (entitym->entities[i-1] == this)
 							entitym->entities.erase(entitym->entities.begin() + i - 1);
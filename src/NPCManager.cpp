@@ -91,15 +91,8 @@ void NPCManager::handleNewMap() {
 			continue;
 		}
 
-		NPC *npc;
-		Entity *entity = entitym->getEntityPrototype(mn.id);
-		if (entity) {
-			npc = new NPC(*entity);
-			delete entity;
-		}
-		else {
-			npc = new NPC(Entity());
-		}
+		// NPCs are owned by NPCManager, so they are copied from the prototype instead of being created in the entity pool
+		NPC *npc = new NPC(entitym->getPrototype(mn.id));
 
 		npc->load(mn.id);
 
@@ -174,6 +167,7 @@ void NPCManager::createMapEvent(const NPC& npc, size_t _npcs) {
 	ev.type = npc.filename;
 
 	mapr->events.push_back(ev);
+	mapr->invalidateEventIndex();
 }
 
 void NPCManager::logic() {
@@ -188,15 +182,7 @@ int NPCManager::getID(const std::string& npcName) {
 	}
 
 	// could not find NPC, try loading it here
-	NPC *npc;
-	Entity *entity = entitym->getEntityPrototype(npcName);
-	if (entity) {
-		npc = new NPC(*entity);
-		delete entity;
-	}
-	else {
-		npc = new NPC(Entity());
-	}
+	NPC *npc = new NPC(entitym->getPrototype(npcName));
 
 	if (npc) {
 		npc->load(npcName);
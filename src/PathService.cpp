@@ -0,0 +1,216 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class PathService
+ *
+ * Queues path requests from entities and resolves them once per frame in a batch,
+ * spread over a ThreadPool and limited by a per-frame time budget.
+ * Requests that don't fit in the budget are resolved on a later frame, so entities
+ * keep their old path while waiting.
+ */
+
+#include "PathService.h"
+#include "SharedResources.h"
+#include "ThreadPool.h"
+
+// how long a batch may keep starting new jobs before the rest are deferred to the next frame
+const float PathService::FRAME_BUDGET_SECONDS = 0.002f;
+
+PathService::PathJob::PathJob()
+	: start()
+	, end()
+	, movement_type(MapCollision::MOVE_NORMAL)
+	, priority(PRIORITY_NORMAL)
+	, tickets()
+	, path()
+	, path_found(false)
+	, done(false)
+{
+}
+
+PathService::PathResult::PathResult()
+	: path()
+	, path_found(false)
+	, age(0)
+{
+}
+
+PathService::PathService()
+	: queue()
+	, batch()
+	, results()
+	, next_ticket(NO_TICKET)
+	, batch_collider(NULL)
+	, batch_start_ticks(0)
+{
+}
+
+PathService::~PathService() {
+}
+
+/**
+ * Run by the ThreadPool for each job in the batch. Jobs are handed out in order, so higher priority jobs start first.
+ */
+void PathService::jobTask(void* data, size_t index) {
+	PathService* service = static_cast<PathService*>(data);
+
+	// the first job of a batch always runs, so that every batch makes progress
+	if (index > 0 && service->isOverBudget())
+		return;
+
+	PathJob& job = service->batch[index];
+	job.path_found = service->batch_collider->computePath(FPoint(job.start), FPoint(job.end), job.path, job.movement_type, MapCollision::DEFAULT_PATH_LIMIT);
+	job.done = true;
+}
+
+bool PathService::isOverBudget() {
+	float elapsed = static_cast<float>(SDL_GetPerformanceCounter() - batch_start_ticks) / static_cast<float>(SDL_GetPerformanceFrequency());
+	return elapsed > FRAME_BUDGET_SECONDS;
+}
+
+/**
+ * Move finished jobs to the result list. Jobs that didn't fit in the budget go back in the queue.
+ */
+void PathService::collectBatch() {
+	for (size_t i = 0; i < batch.size(); ++i) {
+		PathJob& job = batch[i];
+
+		if (job.done) {
+			for (size_t j = 0; j < job.tickets.size(); ++j) {
+				PathResult& result = results[job.tickets[j]];
+				result.path = job.path;
+				result.path_found = job.path_found;
+				result.age = 0;
+			}
+		}
+		else {
+			queue.push_back(job);
+		}
+	}
+
+	batch.clear();
+}
+
+bool PathService::comparePriority(const PathJob& a, const PathJob& b) {
+	return a.priority > b.priority;
+}
+
+/**
+ * Called once per frame, before entities run their logic.
+ * The collision map must not change until this returns.
+ */
+void PathService::logic(const MapCollision& collider, ThreadPool& thread_pool) {
+	// results that nobody picked up are dropped (e.g. the requesting entity was removed)
+	std::map<unsigned long, PathResult>::iterator it = results.begin();
+	while (it != results.end()) {
+		it->second.age++;
+		if (it->second.age > RESULT_TIMEOUT_FRAMES)
+			results.erase(it++);
+		else
+			++it;
+	}
+
+	if (queue.empty())
+		return;
+
+	// higher priority jobs are started first; jobs with equal priority keep their request order
+	std::stable_sort(queue.begin(), queue.end(), comparePriority);
+
+	batch.swap(queue);
+	queue.clear();
+
+	batch_collider = &collider;
+	batch_start_ticks = SDL_GetPerformanceCounter();
+
+	thread_pool.run(jobTask, this, batch.size());
+
+	batch_collider = NULL;
+	collectBatch();
+}
+
+/**
+ * Drops all pending requests and results. Used when the map changes.
+ */
+void PathService::clear() {
+	queue.clear();
+	results.clear();
+}
+
+/**
+ * Queue a path request. The result can be picked up with getResult() on a later frame.
+ * Requests with the same start tile, destination tile and movement type share a single search.
+ */
+unsigned long PathService::request(const FPoint& start, const FPoint& end, int movement_type, int priority) {
+	next_ticket++;
+	if (next_ticket == NO_TICKET)
+		next_ticket++;
+
+	Point start_tile(start);
+	Point end_tile(end);
+
+	for (size_t i = 0; i < queue.size(); ++i) {
+		PathJob& job = queue[i];
+		if (job.end.x == end_tile.x && job.end.y == end_tile.y && job.start.x == start_tile.x && job.start.y == start_tile.y && job.movement_type == movement_type) {
+			job.tickets.push_back(next_ticket);
+			job.priority = std::max(job.priority, priority);
+			return next_ticket;
+		}
+	}
+
+	PathJob job;
+	job.start = start_tile;
+	job.end = end_tile;
+	job.movement_type = movement_type;
+	job.priority = priority;
+	job.tickets.push_back(next_ticket);
+	queue.push_back(job);
+
+	return next_ticket;
+}
+
+/**
+ * Returns true and fills path/path_found if the request has been resolved
+ */
+bool PathService::getResult(unsigned long ticket, std::vector<FPoint> &path, bool &path_found) {
+	std::map<unsigned long, PathResult>::iterator it = results.find(ticket);
+	if (it == results.end())
+		return false;
+
+	path.swap(it->second.path);
+	path_found = it->second.path_found;
+	results.erase(it);
+	return true;
+}
+
+void PathService::cancel(unsigned long ticket) {
+	if (ticket == NO_TICKET)
+		return;
+
+	results.erase(ticket);
+
+	for (size_t i = 0; i < queue.size(); ++i) {
+		std::vector<unsigned long>& tickets = queue[i].tickets;
+		std::vector<unsigned long>::iterator it = std::find(tickets.begin(), tickets.end(), ticket);
+		if (it != tickets.end()) {
+			tickets.erase(it);
+			if (tickets.empty())
+				queue.erase(queue.begin() + i);
+			return;
+		}
+	}
+}
@@ -0,0 +1,98 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class PathService
+ *
+ * Queues path requests from entities and resolves them once per frame in a batch,
+ * spread over a ThreadPool and limited by a per-frame time budget.
+ * Requests that don't fit in the budget are resolved on a later frame, so entities
+ * keep their old path while waiting.
+ */
+
+#ifndef PATH_SERVICE_H
+#define PATH_SERVICE_H
+
+#include "CommonIncludes.h"
+#include "MapCollision.h"
+#include "Utils.h"
+
+class ThreadPool;
+
+class PathService {
+public:
+	enum {
+		PRIORITY_LOW = 0,
+		PRIORITY_NORMAL = 1,
+		PRIORITY_HIGH = 2
+	};
+
+	static const unsigned long NO_TICKET = 0;
+
+	PathService();
+	~PathService();
+
+	void logic(const MapCollision& collider, ThreadPool& thread_pool);
+	void clear();
+
+	unsigned long request(const FPoint& start, const FPoint& end, int movement_type, int priority);
+	bool getResult(unsigned long ticket, std::vector<FPoint> &path, bool &path_found);
+	void cancel(unsigned long ticket);
+
+private:
+	class PathJob {
+	public:
+		Point start;
+		Point end;
+		int movement_type;
+		int priority;
+		std::vector<unsigned long> tickets;
+		std::vector<FPoint> path;
+		bool path_found;
+		bool done;
+
+		PathJob();
+	};
+
+	class PathResult {
+	public:
+		std::vector<FPoint> path;
+		bool path_found;
+		unsigned age;
+
+		PathResult();
+	};
+
+	static const unsigned RESULT_TIMEOUT_FRAMES = 60;
+	static const float FRAME_BUDGET_SECONDS;
+
+	static void jobTask(void* data, size_t index);
+	static bool comparePriority(const PathJob& a, const PathJob& b);
+	void collectBatch();
+	bool isOverBudget();
+
+	std::vector<PathJob> queue;
+	std::vector<PathJob> batch;
+	std::map<unsigned long, PathResult> results;
+	unsigned long next_ticket;
+
+	// only set while a batch is running
+	const MapCollision* batch_collider;
+	uint64_t batch_start_ticks;
+};
+
+#endif
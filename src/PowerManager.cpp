@@ -66,6 +66,7 @@ Power::Power()
 	, state_duration(0)
 	, prevent_interrupt(false)
 	, attack_anim("")
+	, attack_anim_id(SymbolTable::NONE)
 	, face(false)
 	, source_type(-1)
 	, beacon(false)
@@ -85,6 +86,7 @@ Power::Power()
 	, requires_spawns(0)
 	, cooldown(0)
 	, requires_max_hpmp()
+	, requirements(0)
 	, animation_name("")
 	, sfx_index(-1)
 	, sfx_hit(0)
@@ -264,6 +266,14 @@ void PowerManager::loadEffects() {
 	if (!effects.empty() && effects.back().id == "") {
 		effects.pop_back();
 	}
+
+	for (size_t i = 0; i < effects.size(); ++i) {
+		effects[i].symbol = symbols->intern(effects[i].id);
+
+		// like a linear search, the first definition with a given id is used
+		if (effect_ids.find(effects[i].id) == effect_ids.end())
+			effect_ids[effects[i].id] = i;
+	}
 }
 
 void PowerManager::loadPowers() {
@@ -285,10 +295,10 @@ void PowerManager::loadPowers() {
 			// @ATTR power.id|power_id|Uniq identifier for the power definition.
 			id_line = true;
 			input_id = Parse::toPowerID(infile.val);
-			powers[input_id] = Power();
+			powers.edit(input_id) = Power();
 
 			clear_post_effects = true;
-			powers[input_id].is_empty = false;
+			powers.edit(input_id).is_empty = false;
 
 			continue;
 		}
@@ -300,112 +310,115 @@ void PowerManager::loadPowers() {
 		if (id_line)
 			continue;
 
+		Power& power = powers.edit(input_id);
+
 		if (infile.key == "type") {
 			// @ATTR power.type|["fixed", "missile", "repeater", "spawn", "transform", "block"]|Defines the type of power definiton
-			if (infile.val == "fixed") powers[input_id].type = Power::TYPE_FIXED;
-			else if (infile.val == "missile") powers[input_id].type = Power::TYPE_MISSILE;
-			else if (infile.val == "repeater") powers[input_id].type = Power::TYPE_REPEATER;
-			else if (infile.val == "spawn") powers[input_id].type = Power::TYPE_SPAWN;
-			else if (infile.val == "transform") powers[input_id].type = Power::TYPE_TRANSFORM;
-			else if (infile.val == "block") powers[input_id].type = Power::TYPE_BLOCK;
+			if (infile.val == "fixed") power.type = Power::TYPE_FIXED;
+			else if (infile.val == "missile") power.type = Power::TYPE_MISSILE;
+			else if (infile.val == "repeater") power.type = Power::TYPE_REPEATER;
+			else if (infile.val == "spawn") power.type = Power::TYPE_SPAWN;
+			else if (infile.val == "transform") power.type = Power::TYPE_TRANSFORM;
+			else if (infile.val == "block") power.type = Power::TYPE_BLOCK;
 			else infile.error("PowerManager: Unknown type '%s'", infile.val.c_str());
 		}
 		else if (infile.key == "name")
 			// @ATTR power.name|string|The name of the power
-			powers[input_id].name = msg->get(infile.val);
+			power.name = msg->get(infile.val);
 		else if (infile.key == "description")
 			// @ATTR power.description|string|Description of the power
-			powers[input_id].description = msg->get(infile.val);
+			power.description = msg->get(infile.val);
 		else if (infile.key == "icon")
 			// @ATTR power.icon|icon_id|The icon to visually represent the power eg. in skill tree or action bar.
-			powers[input_id].icon = Parse::toInt(infile.val);
+			power.icon = Parse::toInt(infile.val);
 		else if (infile.key == "new_state") {
 			// @ATTR power.new_state|predefined_string|When power is used, hero or enemy will change to this state. Must be one of the states ["instant", user defined]
-			if (infile.val == "instant") powers[input_id].new_state = Power::STATE_INSTANT;
+			if (infile.val == "instant") power.new_state = Power::STATE_INSTANT;
 			else {
-				powers[input_id].new_state = Power::STATE_ATTACK;
-				powers[input_id].attack_anim = infile.val;
+				power.new_state = Power::STATE_ATTACK;
+				power.attack_anim = infile.val;
+				power.attack_anim_id = symbols->intern(infile.val);
 			}
 		}
 		else if (infile.key == "state_duration") {
 			// @ATTR power.state_duration|duration|Sets the length of time the caster is in their state animation. A time longer than the animation length will cause the animation to pause on the last frame. Times shorter than the state animation length will have no effect.
-			powers[input_id].state_duration = Parse::toDuration(infile.val);
+			power.state_duration = Parse::toDuration(infile.val);
 		}
 		else if (infile.key == "prevent_interrupt") {
 			// @ATTR power.prevent_interrupt|bool|Prevents the caster from being interrupted by a hit when casting this power.
-			powers[input_id].prevent_interrupt = Parse::toBool(infile.val);
+			power.prevent_interrupt = Parse::toBool(infile.val);
 		}
 		else if (infile.key == "face")
 			// @ATTR power.face|bool|Power will make hero or enemy to face the target location.
-			powers[input_id].face = Parse::toBool(infile.val);
+			power.face = Parse::toBool(infile.val);
 		else if (infile.key == "source_type") {
 			// @ATTR power.source_type|["hero", "neutral", "enemy"]|Determines which entities the power can effect.
-			if (infile.val == "hero") powers[input_id].source_type = Power::SOURCE_TYPE_HERO;
-			else if (infile.val == "neutral") powers[input_id].source_type = Power::SOURCE_TYPE_NEUTRAL;
-			else if (infile.val == "enemy") powers[input_id].source_type = Power::SOURCE_TYPE_ENEMY;
+			if (infile.val == "hero") power.source_type = Power::SOURCE_TYPE_HERO;
+			else if (infile.val == "neutral") power.source_type = Power::SOURCE_TYPE_NEUTRAL;
+			else if (infile.val == "enemy") power.source_type = Power::SOURCE_TYPE_ENEMY;
 			else infile.error("PowerManager: Unknown source_type '%s'", infile.val.c_str());
 		}
 		else if (infile.key == "beacon")
 			// @ATTR power.beacon|bool|True if enemy is calling its allies.
-			powers[input_id].beacon = Parse::toBool(infile.val);
+			power.beacon = Parse::toBool(infile.val);
 		else if (infile.key == "count")
 			// @ATTR power.count|int|The count of hazards/effect or spawns to be created by this power.
-			powers[input_id].count = Parse::toInt(infile.val);
+			power.count = Parse::toInt(infile.val);
 		else if (infile.key == "passive")
 			// @ATTR power.passive|bool|If power is unlocked when the hero or enemy spawns it will be automatically activated.
-			powers[input_id].passive = Parse::toBool(infile.val);
+			power.passive = Parse::toBool(infile.val);
 		else if (infile.key == "passive_trigger") {
 			// @ATTR power.passive_trigger|["on_block", "on_hit", "on_halfdeath", "on_joincombat", "on_death"]|This will only activate a passive power under a certain condition.
-			if (infile.val == "on_block") powers[input_id].passive_trigger = Power::TRIGGER_BLOCK;
-			else if (infile.val == "on_hit") powers[input_id].passive_trigger = Power::TRIGGER_HIT;
-			else if (infile.val == "on_halfdeath") powers[input_id].passive_trigger = Power::TRIGGER_HALFDEATH;
-			else if (infile.val == "on_joincombat") powers[input_id].passive_trigger = Power::TRIGGER_JOINCOMBAT;
-			else if (infile.val == "on_death") powers[input_id].passive_trigger = Power::TRIGGER_DEATH;
+			if (infile.val == "on_block") power.passive_trigger = Power::TRIGGER_BLOCK;
+			else if (infile.val == "on_hit") power.passive_trigger = Power::TRIGGER_HIT;
+			else if (infile.val == "on_halfdeath") power.passive_trigger = Power::TRIGGER_HALFDEATH;
+			else if (infile.val == "on_joincombat") power.passive_trigger = Power::TRIGGER_JOINCOMBAT;
+			else if (infile.val == "on_death") power.passive_trigger = Power::TRIGGER_DEATH;
 			else infile.error("PowerManager: Unknown passive trigger '%s'", infile.val.c_str());
 		}
 		else if (infile.key == "meta_power") {
 			// @ATTR power.meta_power|bool|If true, this power can not be used on it's own. Instead, it should be replaced via an item with a replace_power entry.
-			powers[input_id].meta_power = Parse::toBool(infile.val);
+			power.meta_power = Parse::toBool(infile.val);
 		}
 		else if (infile.key == "no_actionbar") {
 			// @ATTR power.no_actionbar|bool|If true, this power is prevented from being placed on the actionbar.
-			powers[input_id].no_actionbar = Parse::toBool(infile.val);
+			power.no_actionbar = Parse::toBool(infile.val);
 		}
 		// power requirements
 		else if (infile.key == "requires_flags") {
 			// @ATTR power.requires_flags|list(predefined_string)|A comma separated list of equip flags that are required to use this power. See engine/equip_flags.txt
-			powers[input_id].requires_flags.clear();
+			power.requires_flags.clear();
 			std::string flag = Parse::popFirstString(infile.val);
 
 			while (flag != "") {
-				powers[input_id].requires_flags.insert(flag);
+				power.requires_flags.insert(flag);
 				flag = Parse::popFirstString(infile.val);
 			}
 		}
 		else if (infile.key == "requires_mp")
 			// @ATTR power.requires_mp|float|Restrict power usage to a specified MP level.
-			powers[input_id].requires_mp = Parse::toFloat(infile.val);
+			power.requires_mp = Parse::toFloat(infile.val);
 		else if (infile.key == "requires_hp")
 			// @ATTR power.requires_hp|float|Restrict power usage to a specified HP level.
-			powers[input_id].requires_hp = Parse::toFloat(infile.val);
+			power.requires_hp = Parse::toFloat(infile.val);
 		else if (infile.key == "sacrifice")
 			// @ATTR power.sacrifice|bool|If the power has requires_hp, allow it to kill the caster.
-			powers[input_id].sacrifice = Parse::toBool(infile.val);
+			power.sacrifice = Parse::toBool(infile.val);
 		else if (infile.key == "requires_los") {
 			// @ATTR power.requires_los|bool|Requires a line-of-sight to target.
-			powers[input_id].requires_los = Parse::toBool(infile.val);
-			powers[input_id].requires_los_default = false;
+			power.requires_los = Parse::toBool(infile.val);
+			power.requires_los_default = false;
 		}
 		else if (infile.key == "requires_empty_target")
 			// @ATTR power.requires_empty_target|bool|The power can only be cast when target tile is empty.
-			powers[input_id].requires_empty_target = Parse::toBool(infile.val);
+			power.requires_empty_target = Parse::toBool(infile.val);
 		else if (infile.key == "requires_item") {
 			// @ATTR power.requires_item|repeatable(item_id, int) : Item, Quantity|Requires a specific item of a specific quantity in inventory. If quantity > 0, then the item will be removed.
 			PowerRequiredItem pri;
 			pri.id = Parse::toItemID(Parse::popFirstString(infile.val));
 			pri.quantity = Parse::toInt(Parse::popFirstString(infile.val), 1);
 			pri.equipped = false;
-			powers[input_id].required_items.push_back(pri);
+			power.required_items.push_back(pri);
 		}
 		else if (infile.key == "requires_equipped_item") {
 			// @ATTR power.requires_equipped_item|repeatable(item_id, int) : Item, Quantity|Requires a specific item of a specific quantity to be equipped on hero. If quantity > 0, then the item will be removed.
@@ -420,17 +433,17 @@ void PowerManager::loadPowers() {
 				pri.quantity = std::min(pri.quantity, 1);
 			}
 
-			powers[input_id].required_items.push_back(pri);
+			power.required_items.push_back(pri);
 		}
 		else if (infile.key == "requires_targeting")
 			// @ATTR power.requires_targeting|bool|Power is only used when targeting using click-to-target.
-			powers[input_id].requires_targeting = Parse::toBool(infile.val);
+			power.requires_targeting = Parse::toBool(infile.val);
 		else if (infile.key == "requires_spawns")
 			// @ATTR power.requires_spawns|int|The caster must have at least this many summoned creatures to use this power.
-			powers[input_id].requires_spawns = Parse::toInt(infile.val);
+			power.requires_spawns = Parse::toInt(infile.val);
 		else if (infile.key == "cooldown")
 			// @ATTR power.cooldown|duration|Specify the duration for cooldown of the power in 'ms' or 's'.
-			powers[input_id].cooldown = Parse::toDuration(infile.val);
+			power.cooldown = Parse::toDuration(infile.val);
 		else if (infile.key == "requires_hpmp_state") {
 			// @ATTR power.requires_hpmp_state|["all", "any"], ["percent", "not_percent", "ignore"], float , ["percent", "not_percent", "ignore"], float: Mode, HP state, HP Percentage value, MP state, MP Percentage value|Power can only be used when HP/MP matches the specified state. In 'all' mode, both HP and MP must meet the requirements, where as only one must in 'any' mode. To check a single stat, use 'all' mode and set the 'ignore' state for the other stat.
 
@@ -440,61 +453,61 @@ void PowerManager::loadPowers() {
 			std::string state_mp = Parse::popFirstString(infile.val);
 			std::string state_mp_val = Parse::popFirstString(infile.val);
 
-			powers[input_id].requires_max_hpmp.hp = state_hp_val.empty() ? -1 : Parse::toFloat(state_hp_val);
-			powers[input_id].requires_max_hpmp.mp = state_mp_val.empty() ? -1 : Parse::toFloat(state_mp_val);
+			power.requires_max_hpmp.hp = state_hp_val.empty() ? -1 : Parse::toFloat(state_hp_val);
+			power.requires_max_hpmp.mp = state_mp_val.empty() ? -1 : Parse::toFloat(state_mp_val);
 
 			if (state_hp == "percent") {
-				powers[input_id].requires_max_hpmp.hp_state = Power::HPMPSTATE_PERCENT;
+				power.requires_max_hpmp.hp_state = Power::HPMPSTATE_PERCENT;
 			}
 			else if (state_hp == "not_percent") {
-				powers[input_id].requires_max_hpmp.hp_state = Power::HPMPSTATE_NOT_PERCENT;
+				power.requires_max_hpmp.hp_state = Power::HPMPSTATE_NOT_PERCENT;
 			}
 			else if (state_hp == "ignore" || state_hp.empty()) {
-				powers[input_id].requires_max_hpmp.hp_state = Power::HPMPSTATE_IGNORE;
-				powers[input_id].requires_max_hpmp.hp = -1;
+				power.requires_max_hpmp.hp_state = Power::HPMPSTATE_IGNORE;
+				power.requires_max_hpmp.hp = -1;
 			}
 			else {
 				infile.error("PowerManager: '%s' is not a valid hp/mp state. Use 'percent', 'not_percent', or 'ignore'.", state_hp.c_str());
 			}
 
 			if (state_mp == "percent") {
-				powers[input_id].requires_max_hpmp.mp_state = Power::HPMPSTATE_PERCENT;
+				power.requires_max_hpmp.mp_state = Power::HPMPSTATE_PERCENT;
 			}
 			else if (state_mp == "not_percent") {
-				powers[input_id].requires_max_hpmp.mp_state = Power::HPMPSTATE_NOT_PERCENT;
+				power.requires_max_hpmp.mp_state = Power::HPMPSTATE_NOT_PERCENT;
 			}
 			else if (state_mp == "ignore" || state_mp.empty()) {
-				powers[input_id].requires_max_hpmp.mp_state = Power::HPMPSTATE_IGNORE;
-				powers[input_id].requires_max_hpmp.mp = -1;
+				power.requires_max_hpmp.mp_state = Power::HPMPSTATE_IGNORE;
+				power.requires_max_hpmp.mp = -1;
 			}
 			else {
 				infile.error("PowerManager: '%s' is not a valid hp/mp state. Use 'percent', 'not_percent', or 'ignore'.", state_mp.c_str());
 			}
 
 			if (mode == "any") {
-				powers[input_id].requires_max_hpmp.mode = Power::HPMPSTATE_ANY;
+				power.requires_max_hpmp.mode = Power::HPMPSTATE_ANY;
 			}
 			else if (mode == "all") {
-				powers[input_id].requires_max_hpmp.mode = Power::HPMPSTATE_ALL;
+				power.requires_max_hpmp.mode = Power::HPMPSTATE_ALL;
 			}
 			else if (mode == "hp") {
 				// TODO deprecated
 				infile.error("PowerManager: 'hp' has been deprecated. Use 'all' or 'any'.");
 
-				powers[input_id].requires_max_hpmp.mode = Power::HPMPSTATE_ALL;
-				powers[input_id].requires_max_hpmp.mp_state = Power::HPMPSTATE_IGNORE;
-				powers[input_id].requires_max_hpmp.mp = -1;
+				power.requires_max_hpmp.mode = Power::HPMPSTATE_ALL;
+				power.requires_max_hpmp.mp_state = Power::HPMPSTATE_IGNORE;
+				power.requires_max_hpmp.mp = -1;
 			}
 			else if (mode == "mp") {
 				// TODO deprecated
 				infile.error("PowerManager: 'mp' has been deprecated. Use 'any' or 'all'.");
 
 				// use the HP values for MP, then ignore the HP stat
-				powers[input_id].requires_max_hpmp.mode = Power::HPMPSTATE_ALL;
-				powers[input_id].requires_max_hpmp.mp_state = powers[input_id].requires_max_hpmp.hp_state;
-				powers[input_id].requires_max_hpmp.mp = powers[input_id].requires_max_hpmp.hp;
-				powers[input_id].requires_max_hpmp.hp_state = Power::HPMPSTATE_IGNORE;
-				powers[input_id].requires_max_hpmp.hp = -1;
+				power.requires_max_hpmp.mode = Power::HPMPSTATE_ALL;
+				power.requires_max_hpmp.mp_state = power.requires_max_hpmp.hp_state;
+				power.requires_max_hpmp.mp = power.requires_max_hpmp.hp;
+				power.requires_max_hpmp.hp_state = Power::HPMPSTATE_IGNORE;
+				power.requires_max_hpmp.hp = -1;
 			}
 			else {
 				infile.error("PowerManager: Please specify 'any' or 'all'.");
@@ -503,191 +516,191 @@ void PowerManager::loadPowers() {
 		// animation info
 		else if (infile.key == "animation") {
 			// @ATTR power.animation|filename|The filename of the power animation.
-			if (!powers[input_id].animation_name.empty()) {
-				anim->decreaseCount(powers[input_id].animation_name);
-				powers[input_id].animation_name.clear();
+			if (!power.animation_name.empty()) {
+				anim->decreaseCount(power.animation_name);
+				power.animation_name.clear();
 			}
 			if (!infile.val.empty()) {
-				powers[input_id].animation_name = infile.val;
-				anim->increaseCount(powers[input_id].animation_name);
-				power_animations[input_id] = anim->getAnimationSet(powers[input_id].animation_name)->getAnimation("");
+				power.animation_name = infile.val;
+				anim->increaseCount(power.animation_name);
+				power_animations[input_id] = anim->getAnimationSet(power.animation_name)->getAnimation("");
 			}
 		}
 		else if (infile.key == "soundfx")
 			// @ATTR power.soundfx|filename|Filename of a sound effect to play when the power is used.
-			powers[input_id].sfx_index = loadSFX(infile.val);
+			power.sfx_index = loadSFX(infile.val);
 		else if (infile.key == "soundfx_hit") {
 			// @ATTR power.soundfx_hit|filename|Filename of a sound effect to play when the power's hazard hits a valid target.
 			int sfx_id = loadSFX(infile.val);
 			if (sfx_id != -1) {
-				powers[input_id].sfx_hit = sfx[sfx_id];
-				powers[input_id].sfx_hit_enable = true;
+				power.sfx_hit = sfx[sfx_id];
+				power.sfx_hit_enable = true;
 			}
 		}
 		else if (infile.key == "directional")
 			// @ATTR power.directional|bool|The animation sprite sheet contains 8 directions, one per row.
-			powers[input_id].directional = Parse::toBool(infile.val);
+			power.directional = Parse::toBool(infile.val);
 		else if (infile.key == "visual_random")
 			// @ATTR power.visual_random|int|The animation sprite sheet contains rows of random options
-			powers[input_id].visual_random = Parse::toInt(infile.val);
+			power.visual_random = Parse::toInt(infile.val);
 		else if (infile.key == "visual_option")
 			// @ATTR power.visual_option|int|The animation sprite sheet containers rows of similar effects, use a specific option. If using visual_random, this serves as an offset for the lowest random index.
-			powers[input_id].visual_option = Parse::toInt(infile.val);
+			power.visual_option = Parse::toInt(infile.val);
 		else if (infile.key == "aim_assist")
 			// @ATTR power.aim_assist|bool|If true, power targeting will be offset vertically by the number of pixels set with "aim_assist" in engine/misc.txt.
-			powers[input_id].aim_assist = Parse::toBool(infile.val);
+			power.aim_assist = Parse::toBool(infile.val);
 		else if (infile.key == "speed")
 			// @ATTR power.speed|float|The speed of missile hazard, the unit is defined as map units per frame.
-			powers[input_id].speed = Parse::toFloat(infile.val) / settings->max_frames_per_sec;
+			power.speed = Parse::toFloat(infile.val) / settings->max_frames_per_sec;
 		else if (infile.key == "lifespan")
 			// @ATTR power.lifespan|duration|How long the hazard/animation lasts in 'ms' or 's'.
-			powers[input_id].lifespan = Parse::toDuration(infile.val);
+			power.lifespan = Parse::toDuration(infile.val);
 		else if (infile.key == "floor")
 			// @ATTR power.floor|bool|The hazard is drawn between the background and the object layer.
-			powers[input_id].on_floor = Parse::toBool(infile.val);
+			power.on_floor = Parse::toBool(infile.val);
 		else if (infile.key == "complete_animation")
 			// @ATTR power.complete_animation|bool|For hazards; Play the entire animation, even if the hazard has hit a target.
-			powers[input_id].complete_animation = Parse::toBool(infile.val);
+			power.complete_animation = Parse::toBool(infile.val);
 		else if (infile.key == "charge_speed")
 			// @ATTR power.charge_speed|float|Moves the caster at this speed in the direction they are facing until the state animation is finished.
-			powers[input_id].charge_speed = Parse::toFloat(infile.val) / settings->max_frames_per_sec;
+			power.charge_speed = Parse::toFloat(infile.val) / settings->max_frames_per_sec;
 		else if (infile.key == "attack_speed") {
 			// @ATTR power.attack_speed|float|Changes attack animation speed for this Power. A value of 100 is 100% speed (aka normal speed).
-			powers[input_id].attack_speed = Parse::toFloat(infile.val);
-			if (powers[input_id].attack_speed < 100) {
+			power.attack_speed = Parse::toFloat(infile.val);
+			if (power.attack_speed < 100) {
 				Utils::logInfo("PowerManager: Attack speeds less than 100 are unsupported."); // TODO is this still true?
-				powers[input_id].attack_speed = 100;
+				power.attack_speed = 100;
 			}
 		}
 		// hazard traits
 		else if (infile.key == "use_hazard")
 			// @ATTR power.use_hazard|bool|Power uses hazard.
-			powers[input_id].use_hazard = Parse::toBool(infile.val);
+			power.use_hazard = Parse::toBool(infile.val);
 		else if (infile.key == "no_attack")
 			// @ATTR power.no_attack|bool|Hazard won't affect other entities.
-			powers[input_id].no_attack = Parse::toBool(infile.val);
+			power.no_attack = Parse::toBool(infile.val);
 		else if (infile.key == "no_aggro")
 			// @ATTR power.no_aggro|bool|If true, the Hazard won't put its target in a combat state.
-			powers[input_id].no_aggro = Parse::toBool(infile.val);
+			power.no_aggro = Parse::toBool(infile.val);
 		else if (infile.key == "radius")
 			// @ATTR power.radius|float|Radius in map units
-			powers[input_id].radius = Parse::toFloat(infile.val);
+			power.radius = Parse::toFloat(infile.val);
 		else if (infile.key == "base_damage") {
 			// @ATTR power.base_damage|predefined_string : Damage type ID|Determines which damage stat will be used to calculate damage.
 			for (size_t i = 0; i < eset->damage_types.list.size(); ++i) {
 				if (infile.val == eset->damage_types.list[i].id) {
-					powers[input_id].base_damage = i;
+					power.base_damage = i;
 					break;
 				}
 			}
 
-			if (powers[input_id].base_damage == eset->damage_types.list.size()) {
+			if (power.base_damage == eset->damage_types.list.size()) {
 				infile.error("PowerManager: Unknown base_damage '%s'", infile.val.c_str());
 			}
 		}
 		else if (infile.key == "starting_pos") {
 			// @ATTR power.starting_pos|["source", "target", "melee"]|Start position for hazard
-			if (infile.val == "source")      powers[input_id].starting_pos = Power::STARTING_POS_SOURCE;
-			else if (infile.val == "target") powers[input_id].starting_pos = Power::STARTING_POS_TARGET;
-			else if (infile.val == "melee")  powers[input_id].starting_pos = Power::STARTING_POS_MELEE;
+			if (infile.val == "source")      power.starting_pos = Power::STARTING_POS_SOURCE;
+			else if (infile.val == "target") power.starting_pos = Power::STARTING_POS_TARGET;
+			else if (infile.val == "melee")  power.starting_pos = Power::STARTING_POS_MELEE;
 			else infile.error("PowerManager: Unknown starting_pos '%s'", infile.val.c_str());
 		}
 		else if (infile.key == "relative_pos") {
 			// @ATTR power.relative_pos|bool|Hazard will move relative to the caster's position.
-			powers[input_id].relative_pos = Parse::toBool(infile.val);
+			power.relative_pos = Parse::toBool(infile.val);
 		}
 		else if (infile.key == "multitarget")
 			// @ATTR power.multitarget|bool|Allows a hazard power to hit more than one entity.
-			powers[input_id].multitarget = Parse::toBool(infile.val);
+			power.multitarget = Parse::toBool(infile.val);
 		else if (infile.key == "multihit")
 			// @ATTR power.multihit|bool|Allows a hazard power to hit the same entity more than once.
-			powers[input_id].multihit = Parse::toBool(infile.val);
+			power.multihit = Parse::toBool(infile.val);
 		else if (infile.key == "expire_with_caster")
 			// @ATTR power.expire_with_caster|bool|If true, hazard will disappear when the caster dies.
-			powers[input_id].expire_with_caster = Parse::toBool(infile.val);
+			power.expire_with_caster = Parse::toBool(infile.val);
 		else if (infile.key == "ignore_zero_damage")
 			// @ATTR power.ignore_zero_damage|bool|If true, hazard can still hit the player when damage is 0, triggering post_power and post_effects.
-			powers[input_id].ignore_zero_damage = Parse::toBool(infile.val);
+			power.ignore_zero_damage = Parse::toBool(infile.val);
 		else if (infile.key == "lock_target_to_direction")
 			// @ATTR power.lock_target_to_direction|bool|If true, the target is "snapped" to one of the 8 directions.
-			powers[input_id].lock_target_to_direction = Parse::toBool(infile.val);
+			power.lock_target_to_direction = Parse::toBool(infile.val);
 		else if (infile.key == "movement_type") {
 			// @ATTR power.movement_type|["ground", "flying", "intangible"]|For moving hazards (missile/repeater), this defines which parts of the map it can collide with. The default is "flying".
-			if (infile.val == "ground")         powers[input_id].movement_type = MapCollision::MOVE_NORMAL;
-			else if (infile.val == "flying")    powers[input_id].movement_type = MapCollision::MOVE_FLYING;
-			else if (infile.val == "intangible") powers[input_id].movement_type = MapCollision::MOVE_INTANGIBLE;
+			if (infile.val == "ground")         power.movement_type = MapCollision::MOVE_NORMAL;
+			else if (infile.val == "flying")    power.movement_type = MapCollision::MOVE_FLYING;
+			else if (infile.val == "intangible") power.movement_type = MapCollision::MOVE_INTANGIBLE;
 			else infile.error("PowerManager: Unknown movement_type '%s'", infile.val.c_str());
 		}
 		else if (infile.key == "trait_armor_penetration")
 			// @ATTR power.trait_armor_penetration|bool|Ignores the target's Absorbtion stat
-			powers[input_id].trait_armor_penetration = Parse::toBool(infile.val);
+			power.trait_armor_penetration = Parse::toBool(infile.val);
 		else if (infile.key == "trait_avoidance_ignore")
 			// @ATTR power.trait_avoidance_ignore|bool|Ignores the target's Avoidance stat
-			powers[input_id].trait_avoidance_ignore = Parse::toBool(infile.val);
+			power.trait_avoidance_ignore = Parse::toBool(infile.val);
 		else if (infile.key == "trait_crits_impaired")
 			// @ATTR power.trait_crits_impaired|int|Increases critical hit percentage for slowed/immobile targets
-			powers[input_id].trait_crits_impaired = Parse::toFloat(infile.val);
+			power.trait_crits_impaired = Parse::toFloat(infile.val);
 		else if (infile.key == "trait_elemental") {
 			// @ATTR power.trait_elemental|predefined_string|Damage done is elemental. See engine/elements.txt
 			for (unsigned int i=0; i<eset->elements.list.size(); i++) {
-				if (infile.val == eset->elements.list[i].id) powers[input_id].trait_elemental = i;
+				if (infile.val == eset->elements.list[i].id) power.trait_elemental = i;
 			}
 		}
 		else if (infile.key == "target_range")
 			// @ATTR power.target_range|float|The distance from the caster that the power can be activated
-			powers[input_id].target_range = Parse::popFirstFloat(infile.val);
+			power.target_range = Parse::popFirstFloat(infile.val);
 		//steal effects
 		else if (infile.key == "hp_steal")
 			// @ATTR power.hp_steal|float|Percentage of damage to steal into HP
-			powers[input_id].hp_steal = Parse::toFloat(infile.val);
+			power.hp_steal = Parse::toFloat(infile.val);
 		else if (infile.key == "mp_steal")
 			// @ATTR power.mp_steal|float|Percentage of damage to steal into MP
-			powers[input_id].mp_steal = Parse::toFloat(infile.val);
+			power.mp_steal = Parse::toFloat(infile.val);
 		//missile modifiers
 		else if (infile.key == "missile_angle")
 			// @ATTR power.missile_angle|float|Angle of missile
-			powers[input_id].missile_angle = Parse::toFloat(infile.val);
+			power.missile_angle = Parse::toFloat(infile.val);
 		else if (infile.key == "angle_variance")
 			// @ATTR power.angle_variance|float|Percentage of variance added to missile angle
-			powers[input_id].angle_variance = Parse::toFloat(infile.val);
+			power.angle_variance = Parse::toFloat(infile.val);
 		else if (infile.key == "speed_variance")
 			// @ATTR power.speed_variance|float|Percentage of variance added to missile speed
-			powers[input_id].speed_variance = Parse::toFloat(infile.val);
+			power.speed_variance = Parse::toFloat(infile.val);
 		//repeater modifiers
 		else if (infile.key == "delay")
 			// @ATTR power.delay|duration|Delay between repeats in 'ms' or 's'.
-			powers[input_id].delay = Parse::toDuration(infile.val);
+			power.delay = Parse::toDuration(infile.val);
 		// buff/debuff durations
 		else if (infile.key == "transform_duration")
 			// @ATTR power.transform_duration|duration|Duration for transform in 'ms' or 's'.
-			powers[input_id].transform_duration = Parse::toDuration(infile.val);
+			power.transform_duration = Parse::toDuration(infile.val);
 		else if (infile.key == "manual_untransform")
 			// @ATTR power.manual_untransform|bool|Force manual untranform
-			powers[input_id].manual_untransform = Parse::toBool(infile.val);
+			power.manual_untransform = Parse::toBool(infile.val);
 		else if (infile.key == "keep_equipment")
 			// @ATTR power.keep_equipment|bool|Keep equipment while transformed
-			powers[input_id].keep_equipment = Parse::toBool(infile.val);
+			power.keep_equipment = Parse::toBool(infile.val);
 		else if (infile.key == "untransform_on_hit")
 			// @ATTR power.untransform_on_hit|bool|Force untransform when the player is hit
-			powers[input_id].untransform_on_hit = Parse::toBool(infile.val);
+			power.untransform_on_hit = Parse::toBool(infile.val);
 		// buffs
 		else if (infile.key == "buff")
 			// @ATTR power.buff|bool|Power is cast upon the caster.
-			powers[input_id].buff= Parse::toBool(infile.val);
+			power.buff= Parse::toBool(infile.val);
 		else if (infile.key == "buff_teleport")
 			// @ATTR power.buff_teleport|bool|Power is a teleportation power.
-			powers[input_id].buff_teleport = Parse::toBool(infile.val);
+			power.buff_teleport = Parse::toBool(infile.val);
 		else if (infile.key == "buff_party")
 			// @ATTR power.buff_party|bool|Power is cast upon party members
-			powers[input_id].buff_party = Parse::toBool(infile.val);
+			power.buff_party = Parse::toBool(infile.val);
 		else if (infile.key == "buff_party_power_id")
 			// @ATTR power.buff_party_power_id|power_id|Only party members that were spawned with this power ID are affected by "buff_party=true". Setting this to 0 will affect all party members.
-			powers[input_id].buff_party_power_id = Parse::toInt(infile.val);
+			power.buff_party_power_id = Parse::toInt(infile.val);
 		else if (infile.key == "post_effect" || infile.key == "post_effect_src") {
 			// @ATTR power.post_effect|predefined_string, float, duration , float: Effect ID, Magnitude, Duration, Chance to apply|Post effect to apply to target. Duration is in 'ms' or 's'.
 			// @ATTR power.post_effect_src|predefined_string, float, duration , float: Effect ID, Magnitude, Duration, Chance to apply|Post effect to apply to caster. Duration is in 'ms' or 's'.
 			if (clear_post_effects) {
-				powers[input_id].post_effects.clear();
+				power.post_effects.clear();
 				clear_post_effects = false;
 			}
 			PostEffect pe;
@@ -731,81 +744,84 @@ void PowerManager::loadPowers() {
 					pe.chance = Parse::toFloat(chance);
 				}
 
-				int pe_type;
+				// resolve the effect now, so that it doesn't need to be looked up by name when it is applied
 				bool is_immunity_type = false;
-				EffectDef* effect_def = getEffectDef(pe.id);
-				if (effect_def) {
-					pe_type = effect_def->type;
-					is_immunity_type = effect_def->is_immunity_type;
+				pe.symbol = symbols->intern(pe.id);
+				pe.is_revive = (pe.id == "revive");
+				std::map<std::string, size_t>::const_iterator effect_it = effect_ids.find(pe.id);
+				if (effect_it != effect_ids.end()) {
+					pe.def_index = effect_it->second;
+					pe.type = effects[pe.def_index].type;
+					is_immunity_type = effects[pe.def_index].is_immunity_type;
 				}
 				else {
-					pe_type = Effect::getTypeFromString(pe.id);
+					pe.type = Effect::getTypeFromString(pe.id);
 					is_immunity_type = Effect::isImmunityTypeString(pe.id);
 				}
 
-				if (is_immunity_type && (pe_type == Effect::RESIST_ALL || Effect::typeIsEffectResist(pe_type))) {
+				if (is_immunity_type && (pe.type == Effect::RESIST_ALL || Effect::typeIsEffectResist(pe.type))) {
 					infile.error("PowerManager: Post effect '%s' matches a deprecated type. Converting to a resistance with 100 magnitude.", pe.id.c_str());
 					pe.magnitude = 100;
 				}
 
-				powers[input_id].post_effects.push_back(pe);
+				power.post_effects.push_back(pe);
 			}
 		}
 		// pre and post power effects
 		else if (infile.key == "pre_power") {
 			// @ATTR power.pre_power|power_id, float : Power, Chance to cast|Trigger a power immediately when casting this one.
-			powers[input_id].pre_power = Parse::popFirstInt(infile.val);
+			power.pre_power = Parse::popFirstInt(infile.val);
 			std::string chance = Parse::popFirstString(infile.val);
 			if (!chance.empty()) {
-				powers[input_id].pre_power_chance = Parse::toFloat(chance);
+				power.pre_power_chance = Parse::toFloat(chance);
 			}
 		}
 		else if (infile.key == "post_power") {
 			// @ATTR power.post_power|power_id, int : Power, Chance to cast|Trigger a power if the hazard did damage. For 'block' type powers, this power will be triggered when the blocker takes damage.
-			powers[input_id].post_power = Parse::popFirstInt(infile.val);
+			power.post_power = Parse::popFirstInt(infile.val);
 			std::string chance = Parse::popFirstString(infile.val);
 			if (!chance.empty()) {
-				powers[input_id].post_power_chance = Parse::toFloat(chance);
+				power.post_power_chance = Parse::toFloat(chance);
 			}
 		}
 		else if (infile.key == "wall_power") {
 			// @ATTR power.wall_power|power_id, int : Power, Chance to cast|Trigger a power if the hazard hit a wall.
-			powers[input_id].wall_power = Parse::popFirstInt(infile.val);
+			power.wall_power = Parse::popFirstInt(infile.val);
 			std::string chance = Parse::popFirstString(infile.val);
 			if (!chance.empty()) {
-				powers[input_id].wall_power_chance = Parse::toFloat(chance);
+				power.wall_power_chance = Parse::toFloat(chance);
 			}
 		}
 		else if (infile.key == "wall_reflect")
 			// @ATTR power.wall_reflect|bool|Moving power will bounce off walls and keep going
-			powers[input_id].wall_reflect = Parse::toBool(infile.val);
+			power.wall_reflect = Parse::toBool(infile.val);
 
 		// spawn info
 		else if (infile.key == "spawn_type")
 			// @ATTR power.spawn_type|predefined_string|For non-transform powers, an enemy is spawned from this category. For transform powers, the caster will transform into a creature from this category.
-			powers[input_id].spawn_type = infile.val;
+			power.spawn_type = infile.val;
 		else if (infile.key == "target_neighbor")
 			// @ATTR power.target_neighbor|int|Target is changed to an adjacent tile within a radius.
-			powers[input_id].target_neighbor = Parse::toInt(infile.val);
+			power.target_neighbor = Parse::toInt(infile.val);
 		else if (infile.key == "spawn_limit") {
 			// @ATTR power.spawn_limit|["unlimited", "fixed", "stat"], int, float, predefined_string : Mode, Entity Level, Ratio, Primary stat|The maximum number of creatures that can be spawned and alive from this power. The need for the last three parameters depends on the mode being used. The "unlimited" mode requires no parameters and will remove any spawn limit requirements. The "fixed" mode takes one parameter as the spawn limit. The "stat" mode also requires the ratio and primary stat ID as parameters. The ratio adjusts the scaling of the spawn limit. For example, spawn_limit=stat,1,2,physical will set the spawn limit to 1/2 the summoner's Physical stat.
 			std::string mode = Parse::popFirstString(infile.val);
-			if (mode == "fixed") powers[input_id].spawn_limit_mode = Power::SPAWN_LIMIT_MODE_FIXED;
-			else if (mode == "stat") powers[input_id].spawn_limit_mode = Power::SPAWN_LIMIT_MODE_STAT;
-			else if (mode == "unlimited") powers[input_id].spawn_limit_mode = Power::SPAWN_LIMIT_MODE_UNLIMITED;
+			if (mode == "fixed") power.spawn_limit_mode = Power::SPAWN_LIMIT_MODE_FIXED;
+			else if (mode == "stat") power.spawn_limit_mode = Power::SPAWN_LIMIT_MODE_STAT;
+			else if (mode == "unlimited") power.spawn_limit_mode = Power::SPAWN_LIMIT_MODE_UNLIMITED;
 			else infile.error("PowerManager: Unknown spawn_limit_mode '%s'", mode.c_str());
 
-			if(powers[input_id].spawn_limit_mode != Power::SPAWN_LIMIT_MODE_UNLIMITED) {
-				powers[input_id].spawn_limit_count = static_cast<float>(Parse::popFirstInt(infile.val));
+			if(power.spawn_limit_mode != Power::SPAWN_LIMIT_MODE_UNLIMITED) {
+				power.spawn_limit_count = static_cast<float>(Parse::popFirstInt(infile.val));
 
-				if(powers[input_id].spawn_limit_mode == Power::SPAWN_LIMIT_MODE_STAT) {
-					powers[input_id].spawn_limit_ratio = Parse::popFirstFloat(infile.val);
+				if(power.spawn_limit_mode == Power::SPAWN_LIMIT_MODE_STAT) {
+					power.spawn_limit_ratio = Parse::popFirstFloat(infile.val);
 
 					std::string stat = Parse::popFirstString(infile.val);
 					size_t prim_stat_index = eset->primary_stats.getIndexByID(stat);
 
 					if (prim_stat_index != eset->primary_stats.list.size()) {
-						powers[input_id].spawn_limit_stat = prim_stat_index;
+						power.spawn_limit_stat = prim_stat_index;
 					}
 					else {
 						infile.error("PowerManager: '%s' is not a valid primary stat.", stat.c_str());
@@ -816,24 +832,24 @@ void PowerManager::loadPowers() {
 		else if (infile.key == "spawn_level") {
 			// @ATTR power.spawn_level|["default", "fixed", "level", "stat"], int, float, predefined_string : Mode, Entity Level, Ratio, Primary stat|The level of spawned creatures. The need for the last three parameters depends on the mode being used. The "default" mode will just use the entity's normal level and doesn't require any additional parameters. The "fixed" mode only requires the entity level as a parameter. The "stat" and "level" modes also require the ratio as a parameter. The ratio adjusts the scaling of the entity level. For example, spawn_level=stat,1,2,physical will set the spawned entity level to 1/2 the summoner's Physical stat. Only the "stat" mode requires the last parameter, which is simply the ID of the primary stat that should be used for scaling.
 			std::string mode = Parse::popFirstString(infile.val);
-			if (mode == "default") powers[input_id].spawn_level.mode = SpawnLevel::MODE_DEFAULT;
-			else if (mode == "fixed") powers[input_id].spawn_level.mode = SpawnLevel::MODE_FIXED;
-			else if (mode == "stat") powers[input_id].spawn_level.mode = SpawnLevel::MODE_STAT;
-			else if (mode == "level") powers[input_id].spawn_level.mode = SpawnLevel::MODE_LEVEL;
+			if (mode == "default") power.spawn_level.mode = SpawnLevel::MODE_DEFAULT;
+			else if (mode == "fixed") power.spawn_level.mode = SpawnLevel::MODE_FIXED;
+			else if (mode == "stat") power.spawn_level.mode = SpawnLevel::MODE_STAT;
+			else if (mode == "level") power.spawn_level.mode = SpawnLevel::MODE_LEVEL;
 			else infile.error("PowerManager: Unknown spawn level mode '%s'", mode.c_str());
 
-			if(powers[input_id].spawn_level.mode != SpawnLevel::MODE_DEFAULT) {
-				powers[input_id].spawn_level.count = static_cast<float>(Parse::popFirstInt(infile.val));
+			if(power.spawn_level.mode != SpawnLevel::MODE_DEFAULT) {
+				power.spawn_level.count = static_cast<float>(Parse::popFirstInt(infile.val));
 
-				if(powers[input_id].spawn_level.mode != SpawnLevel::MODE_FIXED) {
-					powers[input_id].spawn_level.ratio = Parse::popFirstFloat(infile.val);
+				if(power.spawn_level.mode != SpawnLevel::MODE_FIXED) {
+					power.spawn_level.ratio = Parse::popFirstFloat(infile.val);
 
-					if(powers[input_id].spawn_level.mode == SpawnLevel::MODE_STAT) {
+					if(power.spawn_level.mode == SpawnLevel::MODE_STAT) {
 						std::string stat = Parse::popFirstString(infile.val);
 						size_t prim_stat_index = eset->primary_stats.getIndexByID(stat);
 
 						if (prim_stat_index != eset->primary_stats.list.size()) {
-							powers[input_id].spawn_level.stat = prim_stat_index;
+							power.spawn_level.stat = prim_stat_index;
 						}
 						else {
 							infile.error("PowerManager: '%s' is not a valid primary stat.", stat.c_str());
@@ -844,108 +860,108 @@ void PowerManager::loadPowers() {
 		}
 		else if (infile.key == "target_party")
 			// @ATTR power.target_party|bool|Hazard will only affect party members.
-			powers[input_id].target_party = Parse::toBool(infile.val);
+			power.target_party = Parse::toBool(infile.val);
 		else if (infile.key == "target_categories") {
 			// @ATTR power.target_categories|list(predefined_string)|Hazard will only affect enemies in these categories.
-			powers[input_id].target_categories.clear();
+			power.target_categories.clear();
 			std::string cat;
 			while ((cat = Parse::popFirstString(infile.val)) != "") {
-				powers[input_id].target_categories.push_back(cat);
+				power.target_categories.push_back(cat);
 			}
 		}
 		else if (infile.key == "modifier_accuracy") {
 			// @ATTR power.modifier_accuracy|["multiply", "add", "absolute"], float : Mode, Value|Changes this power's accuracy.
 			std::string mode = Parse::popFirstString(infile.val);
-			if(mode == "multiply") powers[input_id].mod_accuracy_mode = Power::STAT_MODIFIER_MODE_MULTIPLY;
-			else if(mode == "add") powers[input_id].mod_accuracy_mode = Power::STAT_MODIFIER_MODE_ADD;
-			else if(mode == "absolute") powers[input_id].mod_accuracy_mode = Power::STAT_MODIFIER_MODE_ABSOLUTE;
+			if(mode == "multiply") power.mod_accuracy_mode = Power::STAT_MODIFIER_MODE_MULTIPLY;
+			else if(mode == "add") power.mod_accuracy_mode = Power::STAT_MODIFIER_MODE_ADD;
+			else if(mode == "absolute") power.mod_accuracy_mode = Power::STAT_MODIFIER_MODE_ABSOLUTE;
 			else infile.error("PowerManager: Unknown stat_modifier_mode '%s'", mode.c_str());
 
-			powers[input_id].mod_accuracy_value = Parse::popFirstFloat(infile.val);
+			power.mod_accuracy_value = Parse::popFirstFloat(infile.val);
 		}
 		else if (infile.key == "modifier_damage") {
 			// @ATTR power.modifier_damage|["multiply", "add", "absolute"], float, float : Mode, Min, Max|Changes this power's damage. The "Max" value is ignored, except in the case of "absolute" modifiers.
 			std::string mode = Parse::popFirstString(infile.val);
-			if(mode == "multiply") powers[input_id].mod_damage_mode = Power::STAT_MODIFIER_MODE_MULTIPLY;
-			else if(mode == "add") powers[input_id].mod_damage_mode = Power::STAT_MODIFIER_MODE_ADD;
-			else if(mode == "absolute") powers[input_id].mod_damage_mode = Power::STAT_MODIFIER_MODE_ABSOLUTE;
+			if(mode == "multiply") power.mod_damage_mode = Power::STAT_MODIFIER_MODE_MULTIPLY;
+			else if(mode == "add") power.mod_damage_mode = Power::STAT_MODIFIER_MODE_ADD;
+			else if(mode == "absolute") power.mod_damage_mode = Power::STAT_MODIFIER_MODE_ABSOLUTE;
 			else infile.error("PowerManager: Unknown stat_modifier_mode '%s'", mode.c_str());
 
-			powers[input_id].mod_damage_value_min = Parse::popFirstFloat(infile.val);
-			powers[input_id].mod_damage_value_max = Parse::popFirstFloat(infile.val);
+			power.mod_damage_value_min = Parse::popFirstFloat(infile.val);
+			power.mod_damage_value_max = Parse::popFirstFloat(infile.val);
 		}
 		else if (infile.key == "modifier_critical") {
 			// @ATTR power.modifier_critical|["multiply", "add", "absolute"], float : Mode, Value|Changes the chance that this power will land a critical hit.
 			std::string mode = Parse::popFirstString(infile.val);
-			if(mode == "multiply") powers[input_id].mod_crit_mode = Power::STAT_MODIFIER_MODE_MULTIPLY;
-			else if(mode == "add") powers[input_id].mod_crit_mode = Power::STAT_MODIFIER_MODE_ADD;
-			else if(mode == "absolute") powers[input_id].mod_crit_mode = Power::STAT_MODIFIER_MODE_ABSOLUTE;
+			if(mode == "multiply") power.mod_crit_mode = Power::STAT_MODIFIER_MODE_MULTIPLY;
+			else if(mode == "add") power.mod_crit_mode = Power::STAT_MODIFIER_MODE_ADD;
+			else if(mode == "absolute") power.mod_crit_mode = Power::STAT_MODIFIER_MODE_ABSOLUTE;
 			else infile.error("PowerManager: Unknown stat_modifier_mode '%s'", mode.c_str());
 
-			powers[input_id].mod_crit_value = Parse::popFirstFloat(infile.val);
+			power.mod_crit_value = Parse::popFirstFloat(infile.val);
 		}
 		else if (infile.key == "target_movement_normal") {
 			// @ATTR power.target_movement_normal|bool|Power can affect entities with normal movement (aka walking on ground)
-			powers[input_id].target_movement_normal = Parse::toBool(infile.val);
+			power.target_movement_normal = Parse::toBool(infile.val);
 		}
 		else if (infile.key == "target_movement_flying") {
 			// @ATTR power.target_movement_flying|bool|Power can affect flying entities
-			powers[input_id].target_movement_flying = Parse::toBool(infile.val);
+			power.target_movement_flying = Parse::toBool(infile.val);
 		}
 		else if (infile.key == "target_movement_intangible") {
 			// @ATTR power.target_movement_intangible|bool|Power can affect intangible entities
-			powers[input_id].target_movement_intangible = Parse::toBool(infile.val);
+			power.target_movement_intangible = Parse::toBool(infile.val);
 		}
 		else if (infile.key == "walls_block_aoe") {
 			// @ATTR power.walls_block_aoe|bool|When true, prevents hazard aoe from hitting targets that are behind walls/pits.
-			powers[input_id].walls_block_aoe = Parse::toBool(infile.val);
+			power.walls_block_aoe = Parse::toBool(infile.val);
 		}
 		else if (infile.key == "script") {
 			// @ATTR power.script|["on_cast", "on_hit", "on_wall"], filename : Trigger, Filename|Loads and executes a script file when the trigger is activated.
 			std::string trigger = Parse::popFirstString(infile.val);
-			if (trigger == "on_cast") powers[input_id].script_trigger = Power::SCRIPT_TRIGGER_CAST;
-			else if (trigger == "on_hit") powers[input_id].script_trigger = Power::SCRIPT_TRIGGER_HIT;
-			else if (trigger == "on_wall") powers[input_id].script_trigger = Power::SCRIPT_TRIGGER_WALL;
+			if (trigger == "on_cast") power.script_trigger = Power::SCRIPT_TRIGGER_CAST;
+			else if (trigger == "on_hit") power.script_trigger = Power::SCRIPT_TRIGGER_HIT;
+			else if (trigger == "on_wall") power.script_trigger = Power::SCRIPT_TRIGGER_WALL;
 			else infile.error("PowerManager: Unknown script trigger '%s'", trigger.c_str());
 
-			powers[input_id].script = Parse::popFirstString(infile.val);
+			power.script = Parse::popFirstString(infile.val);
 		}
 		else if (infile.key == "remove_effect") {
 			// @ATTR power.remove_effect|repeatable(predefined_string, int) : Effect ID, Number of Effect instances|Removes a number of instances of a specific Effect ID. Omitting the number of instances, or setting it to zero, will remove all instances/stacks.
 			std::string first = Parse::popFirstString(infile.val);
 			int second = Parse::popFirstInt(infile.val);
-			powers[input_id].remove_effects.push_back(std::pair<std::string, int>(first, second));
+			power.remove_effects.push_back(std::pair<SymbolID, int>(symbols->intern(first), second));
 		}
 		else if (infile.key == "replace_by_effect") {
 			// @ATTR power.replace_by_effect|repeatable(int, predefined_string, int) : Power ID, Effect ID, Number of Effect instances|If the caster has at least the number of instances of the Effect ID, the defined Power ID will be cast instead.
 			PowerReplaceByEffect prbe;
 			prbe.power_id = Parse::popFirstInt(infile.val);
-			prbe.effect_id = Parse::popFirstString(infile.val);
+			prbe.effect_id = symbols->intern(Parse::popFirstString(infile.val));
 			prbe.count = Parse::popFirstInt(infile.val);
-			powers[input_id].replace_by_effect.push_back(prbe);
+			power.replace_by_effect.push_back(prbe);
 		}
 		else if (infile.key == "requires_corpse") {
 			// @ATTR power.requires_corpse|["consume", bool]|If true, a corpse must be targeted for this power to be used. If "consume", then the corpse is also consumed on Power use.
 			if (infile.val == "consume") {
-				powers[input_id].requires_corpse = true;
-				powers[input_id].remove_corpse = true;
+				power.requires_corpse = true;
+				power.remove_corpse = true;
 			}
 			else {
-				powers[input_id].requires_corpse = Parse::toBool(infile.val);
-				powers[input_id].remove_corpse = false;
+				power.requires_corpse = Parse::toBool(infile.val);
+				power.remove_corpse = false;
 			}
 		}
 		else if (infile.key == "target_nearest") {
 			// @ATTR power.target_nearest|float|Will automatically target the nearest enemy within the specified range.
-			powers[input_id].target_nearest = Parse::toFloat(infile.val);
+			power.target_nearest = Parse::toFloat(infile.val);
 		}
 		else if (infile.key == "disable_equip_slots") {
 			// @ATTR power.disable_equip_slots|list(predefined_string)|Passive powers only. A comma separated list of equip slot types to disable when this power is active.
-			powers[input_id].disable_equip_slots.clear();
+			power.disable_equip_slots.clear();
 			std::string slot_type = Parse::popFirstString(infile.val);
 
 			while (slot_type != "") {
-				powers[input_id].disable_equip_slots.push_back(slot_type);
+				power.disable_equip_slots.push_back(slot_type);
 				slot_type = Parse::popFirstString(infile.val);
 			}
 		}
@@ -954,14 +970,22 @@ void PowerManager::loadPowers() {
 	}
 	infile.close();
 
-	std::map<PowerID, Power>::iterator power_it;
-	for (power_it = powers.begin(); power_it != powers.end(); ++power_it) {
-		Power& power = power_it->second;
+	for (PowerID id = 0; id < powers.getIDLimit(); ++id) {
+		if (!powers.contains(id))
+			continue;
+
+		Power& power = powers.edit(id);
 
 		// verify wall/post power ids
 		power.wall_power = verifyID(power.wall_power, NULL, ALLOW_ZERO_ID);
 		power.post_power = verifyID(power.post_power, NULL, ALLOW_ZERO_ID);
 
+		// passive_trigger MUST be "Power::TRIGGER_BLOCK", since that is how we will later remove effects added by blocking
+		if (power.type == Power::TYPE_BLOCK)
+			power.passive_trigger = Power::TRIGGER_BLOCK;
+
+		setRequirements(power);
+
 		// calculate effective combat range
 		{
 			// TODO apparently, missiles and repeaters don't need to have "use_hazard=true"?
@@ -987,6 +1011,41 @@ void PowerManager::loadPowers() {
 	}
 }
 
+/**
+ * Find which usage checks apply to a power, so that StatBlock::canUsePower() can skip the rest
+ */
+void PowerManager::setRequirements(Power& power) {
+	power.requirements = 0;
+
+	for (size_t i = 0; i < power.required_items.size(); ++i) {
+		if (power.required_items[i].id > 0) {
+			power.requirements |= Power::REQUIRES_ITEMS;
+			break;
+		}
+	}
+
+	if (!power.requires_flags.empty())
+		power.requirements |= Power::REQUIRES_EQUIP_FLAGS;
+
+	if (power.requires_max_hpmp.hp_state != Power::HPMPSTATE_IGNORE || power.requires_max_hpmp.mp_state != Power::HPMPSTATE_IGNORE)
+		power.requirements |= Power::REQUIRES_MAX_HPMP;
+
+	if (power.requires_corpse)
+		power.requirements |= Power::REQUIRES_CORPSE;
+
+	if (power.requires_spawns > 0)
+		power.requirements |= Power::REQUIRES_SPAWNS;
+
+	if (power.type == Power::TYPE_SPAWN)
+		power.requirements |= Power::REQUIRES_SUMMON_LIMIT;
+
+	if (power.spawn_type == "untransform")
+		power.requirements |= Power::REQUIRES_TRANSFORMED;
+
+	if (power.buff_party)
+		power.requirements |= Power::REQUIRES_PARTY;
+}
+
 bool PowerManager::isValidEffect(const std::string& type) {
 	if (type == "speed")
 		return true;
@@ -1116,9 +1175,8 @@ void PowerManager::initHazard(PowerID power_index, StatBlock *src_stats, const F
 	}
 
 	// animation properties
-	if (powers[power_index].animation_name != "") {
-		haz->loadAnimation(powers[power_index].animation_name);
-	}
+	// pooled hazards may still have an animation from a different power, so this is always called
+	haz->loadAnimation(powers[power_index].animation_name);
 
 	if (powers[power_index].directional) {
 		haz->animationKind = Utils::calcDirection(src_stats->pos.x, src_stats->pos.y, target.x, target.y);
@@ -1226,21 +1284,20 @@ bool PowerManager::effect(StatBlock *target_stats, StatBlock *caster_stats, Powe
 		if (!Math::percentChanceF(pe.chance))
 			continue;
 
+		// only used for effects that aren't defined in powers/effects.txt
 		EffectDef effect_data;
-		EffectDef* effect_ptr = getEffectDef(pe.id);
+		const EffectDef* effect_ptr = (pe.def_index != PostEffect::NO_DEF ? &effects[pe.def_index] : NULL);
 
 		float magnitude = pe.magnitude;
 		int duration = pe.duration;
 
 		StatBlock *dest_stats = pe.target_src ? caster_stats : target_stats;
-		if (dest_stats->hp <= 0 && !(effect_data.type == Effect::REVIVE || (effect_data.type == Effect::NONE && pe.id == "revive")))
+		if (dest_stats->hp <= 0 && !pe.is_revive)
 			continue;
 
 		if (effect_ptr != NULL) {
 			// effects loaded from powers/effects.txt
-			effect_data = (*effect_ptr);
-
-			if (effect_data.type == Effect::SHIELD) {
+			if (effect_ptr->type == Effect::SHIELD) {
 				if (pwr.base_damage == eset->damage_types.list.size())
 					continue;
 
@@ -1256,7 +1313,7 @@ bool PowerManager::effect(StatBlock *target_stats, StatBlock *caster_stats, Powe
 
 				comb->addString(msg->getv("+%s Shield", Utils::floatToString(magnitude, eset->number_format.combat_text).c_str()), dest_stats->pos, CombatText::MSG_BUFF);
 			}
-			else if (effect_data.type == Effect::HEAL) {
+			else if (effect_ptr->type == Effect::HEAL) {
 				if (pwr.base_damage == eset->damage_types.list.size())
 					continue;
 
@@ -1274,7 +1331,7 @@ bool PowerManager::effect(StatBlock *target_stats, StatBlock *caster_stats, Powe
 				dest_stats->hp += magnitude;
 				if (dest_stats->hp > dest_stats->get(Stats::HP_MAX)) dest_stats->hp = dest_stats->get(Stats::HP_MAX);
 			}
-			else if (effect_data.type == Effect::KNOCKBACK) {
+			else if (effect_ptr->type == Effect::KNOCKBACK) {
 				if (dest_stats->speed_default == 0) {
 					// enemies that can't move can't be knocked back
 					continue;
@@ -1286,7 +1343,9 @@ bool PowerManager::effect(StatBlock *target_stats, StatBlock *caster_stats, Powe
 		else {
 			// all other effects
 			effect_data.id = pe.id;
-			effect_data.type = Effect::getTypeFromString(pe.id);
+			effect_data.symbol = pe.symbol;
+			effect_data.type = pe.type;
+			effect_ptr = &effect_data;
 		}
 
 		EffectParams effect_params;
@@ -1296,7 +1355,7 @@ bool PowerManager::effect(StatBlock *target_stats, StatBlock *caster_stats, Powe
 		effect_params.power_id = power_index;
 		effect_params.is_multiplier = pe.is_multiplier;
 
-		dest_stats->effects.addEffect(dest_stats, effect_data, effect_params);
+		dest_stats->effects.addEffect(dest_stats, *effect_ptr, effect_params);
 	}
 
 	return true;
@@ -1315,7 +1374,7 @@ bool PowerManager::fixed(PowerID power_index, StatBlock *src_stats, const FPoint
 	if (powers[power_index].use_hazard) {
 		int delay_iterator = 0;
 		for (int i=0; i < powers[power_index].count; i++) {
-			Hazard *haz = new Hazard(collider);
+			Hazard *haz = hazard_pool.create(collider);
 			initHazard(power_index, src_stats, target, haz);
 
 			// add optional delay
@@ -1362,7 +1421,7 @@ bool PowerManager::missile(PowerID power_index, StatBlock *src_stats, const FPoi
 
 	//generate hazards
 	for (int i=0; i < powers[power_index].count; i++) {
-		Hazard *haz = new Hazard(collider);
+		Hazard *haz = hazard_pool.create(collider);
 		initHazard(power_index, src_stats, target, haz);
 
 		//calculate individual missile angle
@@ -1431,7 +1490,7 @@ bool PowerManager::repeater(PowerID power_index, StatBlock *src_stats, const FPo
 			break; // no more hazards
 		}
 
-		Hazard *haz = new Hazard(collider);
+		Hazard *haz = hazard_pool.create(collider);
 		initHazard(power_index, src_stats, target, haz);
 
 		haz->pos = location_iterator;
@@ -1578,8 +1637,6 @@ bool PowerManager::block(PowerID power_index, StatBlock *src_stats) {
 	src_stats->block_power = power_index;
 
 	// apply any attached effects
-	// passive_trigger MUST be "Power::TRIGGER_BLOCK", since that is how we will later remove effects added by blocking
-	powers[power_index].passive_trigger = Power::TRIGGER_BLOCK;
 	effect(src_stats, src_stats, power_index, Power::SOURCE_TYPE_HERO);
 
 	// If there's a sound effect, play it here
@@ -1815,11 +1872,10 @@ void PowerManager::activatePassivePostPowers(StatBlock *src_stats) {
 }
 
 EffectDef* PowerManager::getEffectDef(const std::string& id) {
-	for (unsigned i=0; i<effects.size(); ++i) {
-		if (effects[i].id == id) {
-			return &effects[i];
-		}
-	}
+	std::map<std::string, size_t>::iterator it = effect_ids.find(id);
+	if (it != effect_ids.end())
+		return &effects[it->second];
+
 	return NULL;
 }
 
@@ -1920,15 +1976,14 @@ bool PowerManager::checkCombatRange(PowerID power_index, StatBlock* src_stats, F
 }
 
 PowerManager::~PowerManager() {
-	std::map<PowerID, Power>::iterator power_it;
-	for (power_it = powers.begin(); power_it != powers.end(); ++power_it) {
-		if (power_it->second.animation_name.empty())
+	for (PowerID id = 0; id < powers.getIDLimit(); ++id) {
+		if (powers[id].animation_name.empty())
 			continue;
 
-		anim->decreaseCount(power_it->second.animation_name);
+		anim->decreaseCount(powers[id].animation_name);
 
-		if (power_animations[power_it->first])
-			delete power_animations[power_it->first];
+		if (power_animations[id])
+			delete power_animations[id];
 	}
 
 	for (size_t i = 0; i < effects.size(); ++i) {
@@ -1947,7 +2002,7 @@ PowerManager::~PowerManager() {
 	sfx.clear();
 
 	while (!hazards.empty()) {
-		delete hazards.front();
+		hazard_pool.destroy(hazards.front());
 		hazards.pop();
 	}
 }
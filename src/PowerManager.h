@@ -28,8 +28,11 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #ifndef POWER_MANAGER_H
 #define POWER_MANAGER_H
 
+#include "HazardPool.h"
+#include "IDTable.h"
 #include "Map.h"
 #include "MapCollision.h"
+#include "SymbolTable.h"
 #include "Utils.h"
 
 class Animation;
@@ -39,20 +42,30 @@ class Hazard;
 
 class PostEffect {
 public:
+	static const size_t NO_DEF = static_cast<size_t>(-1);
+
 	std::string id;
+	SymbolID symbol; // interned id
+	size_t def_index; // index into PowerManager::effects, or NO_DEF
+	int type; // the type of the effect definition, or the type named by 'id' if there is no definition
 	float magnitude;
 	int duration;
 	float chance;
 	bool target_src;
 	bool is_multiplier;
+	bool is_revive; // the id is "revive", so the effect can be applied to a dead target
 
 	PostEffect()
 		: id("")
+		, symbol(SymbolTable::NONE)
+		, def_index(NO_DEF)
+		, type(0)
 		, magnitude(0)
 		, duration(0)
 		, chance(100)
 		, target_src(false)
-		, is_multiplier(false) {
+		, is_multiplier(false)
+		, is_revive(false) {
 	}
 };
 
@@ -60,7 +73,7 @@ class PowerReplaceByEffect {
 public:
 	int power_id;
 	int count;
-	std::string effect_id;
+	SymbolID effect_id; // interned effect id
 };
 
 class PowerRequiredItem {
@@ -158,6 +171,18 @@ public:
 		SCRIPT_TRIGGER_WALL = 2
 	};
 
+	// bits of 'requirements'
+	enum {
+		REQUIRES_ITEMS = 1 << 0,
+		REQUIRES_EQUIP_FLAGS = 1 << 1,
+		REQUIRES_MAX_HPMP = 1 << 2,
+		REQUIRES_CORPSE = 1 << 3,
+		REQUIRES_SPAWNS = 1 << 4,
+		REQUIRES_SUMMON_LIMIT = 1 << 5,
+		REQUIRES_TRANSFORMED = 1 << 6,
+		REQUIRES_PARTY = 1 << 7
+	};
+
 	// base info
 	bool is_empty;
 	int type; // what kind of activate() this is
@@ -168,6 +193,7 @@ public:
 	int state_duration; // can be used to extend the length of a state animation by pausing on the last frame
 	bool prevent_interrupt; // prevents hits from interrupting the casting state
 	std::string attack_anim; // name of the animation to play when using this power, if it is not block
+	SymbolID attack_anim_id; // interned attack_anim
 	bool face; // does the user turn to face the mouse cursor when using this power?
 	int source_type; //hero, neutral, or enemy
 	bool beacon; //true if it's just an ememy calling its allies
@@ -191,6 +217,7 @@ public:
 	int requires_spawns;
 	int cooldown; // milliseconds before you can use the power again
 	HPMPState requires_max_hpmp;
+	unsigned requirements; // which of the usage checks apply to this power; set after loading
 
 	// animation info
 	std::string animation_name;
@@ -294,7 +321,7 @@ public:
 	int script_trigger;
 	std::string script;
 
-	std::vector< std::pair<std::string, int> > remove_effects;
+	std::vector< std::pair<SymbolID, int> > remove_effects;
 
 	std::vector<PowerReplaceByEffect> replace_by_effect;
 
@@ -318,6 +345,7 @@ private:
 	void loadEffects();
 	void loadPowers();
 
+	void setRequirements(Power& power);
 	bool isValidEffect(const std::string& type);
 	int loadSFX(const std::string& filename);
 
@@ -363,7 +391,9 @@ public:
 	EffectDef* getEffectDef(const std::string& id);
 
 	std::vector<EffectDef> effects;
-	std::map<PowerID, Power> powers;
+	std::map<std::string, size_t> effect_ids; // effect id -> index into 'effects'
+	IDTable<Power> powers;
+	HazardPool hazard_pool; // hazards are created here and given back by HazardManager
 	std::queue<Hazard *> hazards; // output; read by HazardManager
 	std::queue<Map_Enemy> map_enemies; // output; read by PowerManager
 
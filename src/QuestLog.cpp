@@ -38,7 +38,8 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "UtilsFileSystem.h"
 #include "UtilsParsing.h"
 
-QuestLog::QuestLog(MenuLog *_log) {
+QuestLog::QuestLog(MenuLog *_log)
+	: camp_version(0) {
 	log = _log;
 
 	newQuestNotification = false;
@@ -161,13 +162,17 @@ void QuestLog::load(const std::string& filename) {
 }
 
 void QuestLog::logic() {
-	createQuestList();
+	// quest requirements can only change along with the campaign version
+	if (camp_version != camp->getVersion())
+		createQuestList();
 }
 
 /**
  * All active quests are placed in the Quest tab of the Log Menu
  */
 void QuestLog::createQuestList() {
+	camp_version = camp->getVersion();
+
 	std::vector<size_t> temp_quest_ids;
 	std::vector<size_t> temp_complete_quest_ids;
 
@@ -48,6 +48,8 @@ private:
 	std::vector<size_t> complete_quest_ids;
 	std::vector<Quest> quests;
 
+	unsigned camp_version; // the campaign version that the quest list was created at
+
 public:
 	explicit QuestLog(MenuLog *_log);
 	~QuestLog();
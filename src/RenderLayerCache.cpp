@@ -0,0 +1,175 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class RenderLayerCache
+ *
+ * Holds pre-composited images of layered entities (e.g. the hero and their equipment),
+ * so that all of the layers can be drawn as a single Renderable.
+ * An image is made for each combination of equipped layers, animation, frame and direction.
+ * When the cache is full, the least recently used image is freed.
+ */
+
+#include "RenderLayerCache.h"
+#include "SharedResources.h"
+
+RenderLayerCache::Key::Key()
+	: layers_hash(0)
+	, animation(SymbolTable::NONE)
+	, frame(0)
+	, direction(0)
+{
+}
+
+bool RenderLayerCache::Key::operator<(const Key& other) const {
+	if (layers_hash != other.layers_hash)
+		return layers_hash < other.layers_hash;
+	if (animation != other.animation)
+		return animation < other.animation;
+	if (frame != other.frame)
+		return frame < other.frame;
+	return direction < other.direction;
+}
+
+RenderLayerCache::RenderLayerCache()
+	: entries()
+	, lookup()
+{
+}
+
+RenderLayerCache::~RenderLayerCache() {
+	clear();
+}
+
+void RenderLayerCache::clear() {
+	for (EntryList::iterator it = entries.begin(); it != entries.end(); ++it) {
+		it->image->unref();
+	}
+	entries.clear();
+	lookup.clear();
+}
+
+/**
+ * Layers can only be merged if they are drawn without any blending or color changes of their own
+ */
+bool RenderLayerCache::canComposite(const Renderable& layer) {
+	return layer.image != NULL &&
+	       layer.blend_mode == Renderable::BLEND_NORMAL &&
+	       layer.alpha_mod == 255 &&
+	       layer.color_mod.r == 255 && layer.color_mod.g == 255 && layer.color_mod.b == 255;
+}
+
+void RenderLayerCache::setRenderable(const Entry& entry, Renderable& ren) {
+	ren.image = entry.image;
+	ren.src.x = 0;
+	ren.src.y = 0;
+	ren.src.w = entry.image->getWidth();
+	ren.src.h = entry.image->getHeight();
+	ren.offset = entry.offset;
+}
+
+void RenderLayerCache::erase(EntryList::iterator it) {
+	it->image->unref();
+	lookup.erase(it->key);
+	entries.erase(it);
+}
+
+/**
+ * If there is a composited image for key, set up ren to draw it.
+ * Different layer lists can have the same hash, so the layers of the image are compared as well.
+ */
+bool RenderLayerCache::get(const Key& key, const std::vector<unsigned>& layers, Renderable& ren) {
+	EntryMap::iterator it = lookup.find(key);
+	if (it == lookup.end() || it->second->layers != layers)
+		return false;
+
+	// mark as the most recently used
+	entries.splice(entries.begin(), entries, it->second);
+
+	setRenderable(*(it->second), ren);
+	return true;
+}
+
+/**
+ * Composite the layer renderables (in drawing order) into a new image for key, and set up ren to draw it.
+ * An image with the same key but different layers is replaced.
+ * Returns false if the layers couldn't be composited.
+ */
+bool RenderLayerCache::store(const Key& key, const std::vector<unsigned>& layers, const std::vector<Renderable>& layer_renders, Renderable& ren) {
+	if (layer_renders.empty())
+		return false;
+
+	// the offsets of each layer are relative to the same point, so the bounds can be found from them
+	Point top_left(-layer_renders[0].offset.x, -layer_renders[0].offset.y);
+	Point bottom_right(top_left.x + layer_renders[0].src.w, top_left.y + layer_renders[0].src.h);
+
+	for (size_t i = 0; i < layer_renders.size(); ++i) {
+		if (!canComposite(layer_renders[i]))
+			return false;
+
+		top_left.x = std::min(top_left.x, -layer_renders[i].offset.x);
+		top_left.y = std::min(top_left.y, -layer_renders[i].offset.y);
+		bottom_right.x = std::max(bottom_right.x, layer_renders[i].src.w - layer_renders[i].offset.x);
+		bottom_right.y = std::max(bottom_right.y, layer_renders[i].src.h - layer_renders[i].offset.y);
+	}
+
+	int width = bottom_right.x - top_left.x;
+	int height = bottom_right.y - top_left.y;
+	if (width <= 0 || height <= 0)
+		return false;
+
+	Image *image = render_device->createImage(width, height);
+	if (!image)
+		return false;
+
+	if (image->getWidth() == 0) {
+		image->unref();
+		return false;
+	}
+
+	image->fillWithColor(Color(0,0,0,0));
+
+	for (size_t i = 0; i < layer_renders.size(); ++i) {
+		Rect src = layer_renders[i].src;
+		Rect dest;
+		dest.x = -layer_renders[i].offset.x - top_left.x;
+		dest.y = -layer_renders[i].offset.y - top_left.y;
+		dest.w = src.w;
+		dest.h = src.h;
+		render_device->renderToImage(layer_renders[i].image, src, image, dest);
+	}
+
+	EntryMap::iterator existing = lookup.find(key);
+	if (existing != lookup.end())
+		erase(existing->second);
+
+	if (entries.size() >= MAX_ENTRIES)
+		erase(--entries.end());
+
+	Entry entry;
+	entry.key = key;
+	entry.layers = layers;
+	entry.image = image;
+	entry.offset.x = -top_left.x;
+	entry.offset.y = -top_left.y;
+
+	entries.push_front(entry);
+	lookup[key] = entries.begin();
+
+	setRenderable(entry, ren);
+	return true;
+}
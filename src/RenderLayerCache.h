@@ -0,0 +1,79 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class RenderLayerCache
+ *
+ * Holds pre-composited images of layered entities (e.g. the hero and their equipment),
+ * so that all of the layers can be drawn as a single Renderable.
+ * An image is made for each combination of equipped layers, animation, frame and direction.
+ * When the cache is full, the least recently used image is freed.
+ */
+
+#ifndef RENDER_LAYER_CACHE_H
+#define RENDER_LAYER_CACHE_H
+
+#include "CommonIncludes.h"
+#include "RenderDevice.h"
+#include "SymbolTable.h"
+
+#include <list>
+
+class RenderLayerCache {
+public:
+	class Key {
+	public:
+		unsigned long layers_hash;
+		SymbolID animation;
+		unsigned short frame;
+		unsigned char direction;
+
+		Key();
+		bool operator<(const Key& other) const;
+	};
+
+	static const size_t MAX_ENTRIES = 256;
+
+	RenderLayerCache();
+	~RenderLayerCache();
+
+	void clear();
+	bool get(const Key& key, const std::vector<unsigned>& layers, Renderable& ren);
+	bool store(const Key& key, const std::vector<unsigned>& layers, const std::vector<Renderable>& layer_renders, Renderable& ren);
+
+	static bool canComposite(const Renderable& layer);
+
+private:
+	class Entry {
+	public:
+		Key key;
+		std::vector<unsigned> layers; // the full layer list that key.layers_hash was made from
+		Image *image;
+		Point offset;
+	};
+
+	typedef std::list<Entry> EntryList;
+	typedef std::map<Key, EntryList::iterator> EntryMap;
+
+	void setRenderable(const Entry& entry, Renderable& ren);
+	void erase(EntryList::iterator it);
+
+	EntryList entries; // most recently used first
+	EntryMap lookup;
+};
+
+#endif
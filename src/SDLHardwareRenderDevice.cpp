@@ -490,7 +490,14 @@ int SDLHardwareRenderDevice::renderToImage(Image* src_image, Rect& src, Image* d
     SDL_Rect _dest = dest;
 
 	SDL_SetTextureBlendMode(static_cast<SDLHardwareImage *>(dest_image)->surface, SDL_BLENDMODE_BLEND);
-	SDL_RenderCopy(renderer, static_cast<SDLHardwareImage *>(src_image)->surface, &_src, &_dest);
+
+	// don't carry over the blend mode or color from the last time src_image was rendered
+	SDL_Texture *surface = static_cast<SDLHardwareImage *>(src_image)->surface;
+	SDL_SetTextureBlendMode(surface, SDL_BLENDMODE_BLEND);
+	SDL_SetTextureColorMod(surface, 255, 255, 255);
+	SDL_SetTextureAlphaMod(surface, 255);
+
+	SDL_RenderCopy(renderer, surface, &_src, &_dest);
 	SDL_SetRenderTarget(renderer, NULL);
 	return 0;
 }
@@ -397,7 +397,13 @@ int SDLSoftwareRenderDevice::renderToImage(Image* src_image, Rect& src, Image* d
 	SDL_Rect _src = src;
 	SDL_Rect _dest = dest;
 
-	return SDL_BlitSurface(static_cast<SDLSoftwareImage *>(src_image)->surface, &_src,
+	// don't carry over the blend mode or color from the last time src_image was rendered
+	SDL_Surface *surface = static_cast<SDLSoftwareImage *>(src_image)->surface;
+	SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_BLEND);
+	SDL_SetSurfaceColorMod(surface, 255, 255, 255);
+	SDL_SetSurfaceAlphaMod(surface, 255);
+
+	return SDL_BlitSurface(surface, &_src,
 						   static_cast<SDLSoftwareImage *>(dest_image)->surface, &_dest);
 }
 
@@ -320,7 +320,7 @@ void SaveLoad::loadGame() {
 				pc->stats.gfx_portrait = Parse::popFirstString(infile.val);
 			}
 			else if (infile.key == "class") {
-				pc->stats.character_class = Parse::popFirstString(infile.val);
+				pc->stats.setCharacterClass(Parse::popFirstString(infile.val));
 				pc->stats.character_subclass = Parse::popFirstString(infile.val);
 			}
 			else if (infile.key == "xp") {
@@ -483,7 +483,7 @@ void SaveLoad::loadClass(int index) {
 		return;
 	}
 
-	pc->stats.character_class = eset->hero_classes.list[index].name;
+	pc->stats.setCharacterClass(eset->hero_classes.list[index].name);
 	for (size_t i = 0; i < eset->primary_stats.list.size(); ++i) {
 		// Avatar::init() sets primary stats to 1, so we add to that here
 		pc->stats.primary[i] += eset->hero_classes.list[index].primary[i];
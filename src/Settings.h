@@ -120,6 +120,8 @@ public:
 	// Misc
 	int prev_save_slot;
 	bool move_type_dimissed;
+	int worker_threads;
+	bool composite_layers;
 
 	/**
 	 * NOTE Everything below is not part of the user's settings.txt, but somehow ended up here
@@ -41,6 +41,7 @@ Created and destroyed by main.cpp
 #include "Settings.h"
 #include "SharedResources.h"
 #include "SoundManager.h"
+#include "SymbolTable.h"
 #include "TooltipManager.h"
 
 AnimationManager *anim = NULL;
@@ -56,4 +57,5 @@ RenderDevice *render_device = NULL;
 SaveLoad *save_load = NULL;
 Settings *settings = NULL;
 SoundManager *snd = NULL;
+SymbolTable *symbols = NULL;
 TooltipManager *tooltipm = NULL;
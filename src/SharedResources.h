@@ -45,6 +45,7 @@ class RenderDevice;
 class SaveLoad;
 class Settings;
 class SoundManager;
+class SymbolTable;
 class TooltipManager;
 
 extern AnimationManager *anim;
@@ -60,6 +61,7 @@ extern RenderDevice *render_device;
 extern SaveLoad *save_load;
 extern Settings *settings;
 extern SoundManager *snd;
+extern SymbolTable *symbols;
 extern TooltipManager *tooltipm;
 
 #endif
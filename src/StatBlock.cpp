@@ -63,8 +63,78 @@ size_t StatBlock::getFullStatCount() {
 	return Stats::COUNT + eset->damage_types.count + eset->elements.list.size();
 }
 
+StatTemplate::StatTemplate()
+	: categories()
+	, power_filter()
+	, loot_table()
+	, sfx_attack()
+	, sfx_step("")
+	, sfx_hit()
+	, sfx_die()
+	, sfx_critdie()
+	, sfx_block()
+	, sfx_levelup("")
+	, sfx_lowhp("")
+	, layer_reference_order()
+	, layer_def(8, std::vector<unsigned>())
+	, animation_slots()
+{
+}
+
+StatTemplateRef::StatTemplateRef()
+	: shared(new Shared())
+{
+	shared->ref_count = 1;
+}
+
+StatTemplateRef::StatTemplateRef(const StatTemplateRef& other)
+	: shared(other.shared)
+{
+	shared->ref_count++;
+}
+
+StatTemplateRef& StatTemplateRef::operator=(const StatTemplateRef& other) {
+	if (shared == other.shared)
+		return *this;
+
+	release();
+	shared = other.shared;
+	shared->ref_count++;
+
+	return *this;
+}
+
+StatTemplateRef::~StatTemplateRef() {
+	release();
+}
+
+void StatTemplateRef::release() {
+	shared->ref_count--;
+	if (shared->ref_count == 0)
+		delete shared;
+	shared = NULL;
+}
+
+StatTemplate& StatTemplateRef::edit() {
+	if (shared->ref_count > 1) {
+		Shared* copy = new Shared();
+		copy->data = shared->data;
+		copy->ref_count = 1;
+
+		release();
+		shared = copy;
+	}
+
+	return shared->data;
+}
+
 StatBlock::StatBlock()
 	: statsLoaded(false)
+	, base_dirty(true)
+	, base_level(0)
+	, base_primary()
+	, base_item_dmg()
+	, base_item_abs()
 	, alive(true)
 	, corpse(false)
 	, corpse_timer()
@@ -104,6 +174,7 @@ StatBlock::StatBlock()
 	, current(getFullStatCount(), 0)
 	, per_level(getFullStatCount(), 0)
 	, character_class("")
+	, character_class_id(SymbolTable::NONE)
 	, character_subclass("")
 	, hp(0)
 	, mp(0)
@@ -156,6 +227,7 @@ StatBlock::StatBlock()
 	, flee_timer(settings->max_frames_per_sec) // enemy only
 	, flee_cooldown_timer(settings->max_frames_per_sec) // enemy only
 	, perfect_accuracy(false)
+	, loot_dropped(false) // enemy only
 	, teleportation(false)
 	, teleport_destination()
 	, currency(0)
@@ -171,14 +243,6 @@ StatBlock::StatBlock()
 	, gfx_portrait("")
 	, transform_type("")
 	, animations("")
-	, sfx_attack()
-	, sfx_step("")
-	, sfx_hit()
-	, sfx_die()
-	, sfx_critdie()
-	, sfx_block()
-	, sfx_levelup("")
-	, sfx_lowhp("")
 	, sfx_lowhp_loop(false)
 	, max_spendable_stat_points(0)
 	, max_points_per_stat(0)
@@ -189,9 +253,6 @@ StatBlock::StatBlock()
 	, summons()
 	, summoner(NULL)
 	, abort_npc_interact(false)
-	, layer_reference_order()
-	, layer_def(8, std::vector<unsigned>())
-	, animation_slots()
 	, critdie_enabled(false)
 {
 	primary.resize(eset->primary_stats.list.size(), 0);
@@ -345,6 +406,7 @@ bool StatBlock::loadCoreStat(FileParser *infile) {
 	}
 	else if (infile->key == "power_filter") {
 		// @ATTR power_filter|list(power_id)|Only these powers are allowed to hit this entity.
+		std::vector<PowerID>& power_filter = editTemplate().power_filter;
 		std::string power_id = Parse::popFirstString(infile->val);
 		while (!power_id.empty()) {
 			power_filter.push_back(Parse::toPowerID(power_id));
@@ -354,6 +416,7 @@ bool StatBlock::loadCoreStat(FileParser *infile) {
 	}
 	else if (infile->key == "categories") {
 		// @ATTR categories|list(string)|Categories that this entity belongs to.
+		std::vector<std::string>& categories = editTemplate().categories;
 		categories.clear();
 		std::string cat;
 		while ((cat = Parse::popFirstString(infile->val)) != "") {
@@ -375,13 +438,14 @@ bool StatBlock::loadCoreStat(FileParser *infile) {
  */
 bool StatBlock::loadSfxStat(FileParser *infile) {
 	// @CLASS StatBlock: Sound effects|Description of sound effect properties in engine/stats.txt, enemies/..., and npcs/...
+	StatTemplate& t = editTemplate();
 
 	if (infile->new_section && (infile->section.empty() || infile->section == "stats")) {
-		sfx_attack.clear();
-		sfx_hit.clear();
-		sfx_die.clear();
-		sfx_critdie.clear();
-		sfx_block.clear();
+		t.sfx_attack.clear();
+		t.sfx_hit.clear();
+		t.sfx_die.clear();
+		t.sfx_critdie.clear();
+		t.sfx_block.clear();
 	}
 
 	if (infile->key == "sfx_attack") {
@@ -389,22 +453,22 @@ bool StatBlock::loadSfxStat(FileParser *infile) {
 		std::string anim_name = Parse::popFirstString(infile->val);
 		std::string filename = Parse::popFirstString(infile->val);
 
-		size_t found_index = sfx_attack.size();
-		for (size_t i = 0; i < sfx_attack.size(); ++i) {
-			if (anim_name == sfx_attack[i].first) {
+		size_t found_index = t.sfx_attack.size();
+		for (size_t i = 0; i < t.sfx_attack.size(); ++i) {
+			if (anim_name == t.sfx_attack[i].first) {
 				found_index = i;
 				break;
 			}
 		}
 
-		if (found_index == sfx_attack.size()) {
-			sfx_attack.push_back(std::pair<std::string, std::vector<std::string> >());
-			sfx_attack.back().first = anim_name;
-			sfx_attack.back().second.push_back(filename);
+		if (found_index == t.sfx_attack.size()) {
+			t.sfx_attack.push_back(std::pair<std::string, std::vector<std::string> >());
+			t.sfx_attack.back().first = anim_name;
+			t.sfx_attack.back().second.push_back(filename);
 		}
 		else {
-			if (std::find(sfx_attack[found_index].second.begin(), sfx_attack[found_index].second.end(), filename) == sfx_attack[found_index].second.end()) {
-				sfx_attack[found_index].second.push_back(filename);
+			if (std::find(t.sfx_attack[found_index].second.begin(), t.sfx_attack[found_index].second.end(), filename) == t.sfx_attack[found_index].second.end()) {
+				t.sfx_attack[found_index].second.push_back(filename);
 			}
 		}
 
@@ -412,45 +476,45 @@ bool StatBlock::loadSfxStat(FileParser *infile) {
 	}
 	else if (infile->key == "sfx_hit") {
 		// @ATTR sfx_hit|repeatable(filename)|Filename of sound effect for being hit.
-		if (std::find(sfx_hit.begin(), sfx_hit.end(), infile->val) == sfx_hit.end()) {
-			sfx_hit.push_back(infile->val);
+		if (std::find(t.sfx_hit.begin(), t.sfx_hit.end(), infile->val) == t.sfx_hit.end()) {
+			t.sfx_hit.push_back(infile->val);
 		}
 
 		return true;
 	}
 	else if (infile->key == "sfx_die") {
 		// @ATTR sfx_die|repeatable(filename)|Filename of sound effect for dying.
-		if (std::find(sfx_die.begin(), sfx_die.end(), infile->val) == sfx_die.end()) {
-			sfx_die.push_back(infile->val);
+		if (std::find(t.sfx_die.begin(), t.sfx_die.end(), infile->val) == t.sfx_die.end()) {
+			t.sfx_die.push_back(infile->val);
 		}
 
 		return true;
 	}
 	else if (infile->key == "sfx_critdie") {
 		// @ATTR sfx_critdie|repeatable(filename)|Filename of sound effect for dying to a critical hit.
-		if (std::find(sfx_critdie.begin(), sfx_critdie.end(), infile->val) == sfx_critdie.end()) {
-			sfx_critdie.push_back(infile->val);
+		if (std::find(t.sfx_critdie.begin(), t.sfx_critdie.end(), infile->val) == t.sfx_critdie.end()) {
+			t.sfx_critdie.push_back(infile->val);
 		}
 
 		return true;
 	}
 	else if (infile->key == "sfx_block") {
 		// @ATTR sfx_block|repeatable(filename)|Filename of sound effect for blocking an incoming hit.
-		if (std::find(sfx_block.begin(), sfx_block.end(), infile->val) == sfx_block.end()) {
-			sfx_block.push_back(infile->val);
+		if (std::find(t.sfx_block.begin(), t.sfx_block.end(), infile->val) == t.sfx_block.end()) {
+			t.sfx_block.push_back(infile->val);
 		}
 
 		return true;
 	}
 	else if (infile->key == "sfx_levelup") {
 		// @ATTR sfx_levelup|filename|Filename of sound effect for leveling up.
-		sfx_levelup = infile->val;
+		t.sfx_levelup = infile->val;
 
 		return true;
 	}
 	else if (infile->key == "sfx_lowhp") {
 		// @ATTR sfx_lowhp|filename, bool: Sound file, loop|Filename of sound effect for low health warning. Optionally, it can be looped.
-		sfx_lowhp = Parse::popFirstString(infile->val);
+		t.sfx_lowhp = Parse::popFirstString(infile->val);
 		if (infile->val != "") sfx_lowhp_loop = Parse::toBool(infile->val);
 
 		return true;
@@ -463,10 +527,12 @@ bool StatBlock::loadRenderLayerStat(FileParser *infile) {
 	// @CLASS StatBlock: Render layers|Description of 'render_layers' section in engine/stats.txt, enemies/..., and npcs/...
 
 	if (infile->section == "render_layers") {
+		StatTemplate& t = editTemplate();
+
 		if (infile->new_section) {
-			layer_def = std::vector<std::vector<unsigned> >(8, std::vector<unsigned>());
-			layer_reference_order = std::vector<std::string>();
-			animation_slots.clear();
+			t.layer_def = std::vector<std::vector<unsigned> >(8, std::vector<unsigned>());
+			t.layer_reference_order = std::vector<std::string>();
+			t.animation_slots.clear();
 		}
 
 		if (infile->key == "layer") {
@@ -483,14 +549,14 @@ bool StatBlock::loadRenderLayerStat(FileParser *infile) {
 			while (layer != "") {
 				// check if already in layer_reference:
 				unsigned ref_pos;
-				for (ref_pos = 0; ref_pos < layer_reference_order.size(); ++ref_pos)
-					if (layer == layer_reference_order[ref_pos])
+				for (ref_pos = 0; ref_pos < t.layer_reference_order.size(); ++ref_pos)
+					if (layer == t.layer_reference_order[ref_pos])
 						break;
-				if (ref_pos == layer_reference_order.size())
-					layer_reference_order.push_back(layer);
-				layer_def[dir].push_back(ref_pos);
+				if (ref_pos == t.layer_reference_order.size())
+					t.layer_reference_order.push_back(layer);
+				t.layer_def[dir].push_back(ref_pos);
 
-				animation_slots[layer] = "";
+				t.animation_slots[layer] = "";
 
 				layer = Parse::popFirstString(infile->val);
 			}
@@ -515,6 +581,7 @@ bool StatBlock::loadAnimationSlotStat(FileParser *infile) {
 			std::string slot_id = Parse::popFirstString(infile->val);
 			std::string slot_filename = Parse::popFirstString(infile->val);
 
+			std::map<std::string, std::string>& animation_slots = editTemplate().animation_slots;
 			std::map<std::string, std::string>::iterator it;
 			it = animation_slots.find(slot_id);
 			if (it != animation_slots.end())
@@ -604,6 +671,7 @@ void StatBlock::load(const std::string& filename) {
 			// optionally allow range:
 			// loot=[id],[percent_chance],[count_min],[count_max]
 
+			std::vector<EventComponent>& loot_table = editTemplate().loot_table;
 			if (clear_loot) {
 				loot_table.clear();
 				clear_loot = false;
@@ -893,6 +961,54 @@ void StatBlock::calcBase() {
  * Recalc derived stats from base stats + effect bonuses
  */
 void StatBlock::applyEffects() {
+	base_dirty = true;
+	updateStats();
+}
+
+/**
+ * Returns true if any of the values that calcBase() depends on have changed since it last ran.
+ * The starting and per level/primary tables only change when stats are loaded or replaced,
+ * which is followed by a call to applyEffects().
+ */
+bool StatBlock::checkBaseInputs() {
+	bool changed = false;
+
+	if (base_level != level) {
+		base_level = level;
+		changed = true;
+	}
+
+	if (base_primary.size() != primary.size())
+		base_primary.resize(primary.size(), 0);
+	for (size_t i = 0; i < primary.size(); ++i) {
+		if (base_primary[i] != get_primary(i)) {
+			base_primary[i] = get_primary(i);
+			changed = true;
+		}
+	}
+
+	if (base_item_dmg.size() != item_base_dmg.size())
+		base_item_dmg.resize(item_base_dmg.size());
+	for (size_t i = 0; i < item_base_dmg.size(); ++i) {
+		if (base_item_dmg[i].min != item_base_dmg[i].min || base_item_dmg[i].max != item_base_dmg[i].max) {
+			base_item_dmg[i] = item_base_dmg[i];
+			changed = true;
+		}
+	}
+
+	if (base_item_abs.min != item_base_abs.min || base_item_abs.max != item_base_abs.max) {
+		base_item_abs = item_base_abs;
+		changed = true;
+	}
+
+	return changed;
+}
+
+/**
+ * Like applyEffects(), but only recalculates the stats that can have changed:
+ * everything if the base stats changed, otherwise only the stats with changed effect bonuses
+ */
+void StatBlock::updateStats() {
 	// preserve hp/mp states
 	// max HP and MP can't drop below 1
 	prev_maxhp = std::max(get(Stats::HP_MAX), 1.0f);
@@ -909,11 +1025,25 @@ void StatBlock::applyEffects() {
 		primary_additional[i] = effects.bonus_primary[i];
 	}
 
-	calcBase();
+	if (checkBaseInputs())
+		base_dirty = true;
 
-	for (size_t i = 0; i < getFullStatCount(); ++i) {
-		current[i] = (base[i] + effects.bonus[i]) * effects.bonus_multiplier[i];
+	if (base_dirty) {
+		calcBase();
+
+		for (size_t i = 0; i < getFullStatCount(); ++i) {
+			current[i] = (base[i] + effects.bonus[i]) * effects.bonus_multiplier[i];
+		}
+
+		base_dirty = false;
+	}
+	else {
+		for (size_t j = 0; j < effects.bonus_changes.size(); ++j) {
+			size_t i = effects.bonus_changes[j];
+			current[i] = (base[i] + effects.bonus[i]) * effects.bonus_multiplier[i];
+		}
 	}
+	effects.clearBonusChanges();
 
 	// max HP and MP can't drop below 1
 	current[Stats::HP_MAX] = std::max(get(Stats::HP_MAX), 1.0f);
@@ -936,7 +1066,7 @@ void StatBlock::logic() {
 		while (!party_buffs.empty()) {
 			PowerID power_index = party_buffs.front();
 			party_buffs.pop();
-			Power *buff_power = &powers->powers[power_index];
+			const Power *buff_power = &powers->powers[power_index];
 
 			for (size_t i=0; i < entitym->entities.size(); ++i) {
 				Entity* party_member = entitym->entities[i];
@@ -954,7 +1084,7 @@ void StatBlock::logic() {
 	effects.logic();
 
 	// apply bonuses from items/effects to base stats
-	applyEffects();
+	updateStats();
 
 	if (hero && effects.refresh_stats) {
 		refresh_stats = true;
@@ -976,26 +1106,7 @@ void StatBlock::logic() {
 		powers_ai[i].cooldown.tick();
 	}
 
-	// HP regen
-	if (hp <= get(Stats::HP_MAX) && hp > 0) {
-		float hp_regen_per_frame;
-		if (!in_combat && !hero_ally && !hero && pc->stats.alive) {
-			// enemies heal rapidly (full heal in 5 seconds) while not in combat
-			hp_regen_per_frame = get(Stats::HP_MAX) / 5.f / settings->max_frames_per_sec;
-		}
-		else {
-			hp_regen_per_frame = get(Stats::HP_REGEN) / 60.f / settings->max_frames_per_sec;
-		}
-		hp += hp_regen_per_frame;
-		hp = std::max(0.0f, std::min(hp, get(Stats::HP_MAX)));
-	}
-
-	// MP regen
-	if (mp <= get(Stats::MP_MAX) && hp > 0) {
-		float mp_regen_per_frame = get(Stats::MP_REGEN) / 60.f / settings->max_frames_per_sec;
-		mp += mp_regen_per_frame;
-		mp = std::max(0.0f, std::min(mp, get(Stats::MP_MAX)));
-	}
+	regenerate(1);
 
 	// handle buff/debuff durations
 	if (transform_duration > 0)
@@ -1097,6 +1208,57 @@ void StatBlock::logic() {
 	}
 }
 
+/**
+ * Restore HP and MP over a number of frames
+ */
+void StatBlock::regenerate(unsigned frames) {
+	// HP regen
+	if (hp <= get(Stats::HP_MAX) && hp > 0) {
+		float hp_regen_per_frame;
+		if (!in_combat && !hero_ally && !hero && pc->stats.alive) {
+			// enemies heal rapidly (full heal in 5 seconds) while not in combat
+			hp_regen_per_frame = get(Stats::HP_MAX) / 5.f / settings->max_frames_per_sec;
+		}
+		else {
+			hp_regen_per_frame = get(Stats::HP_REGEN) / 60.f / settings->max_frames_per_sec;
+		}
+		hp += hp_regen_per_frame * static_cast<float>(frames);
+		hp = std::max(0.0f, std::min(hp, get(Stats::HP_MAX)));
+	}
+
+	// MP regen
+	if (mp <= get(Stats::MP_MAX) && hp > 0) {
+		float mp_regen_per_frame = get(Stats::MP_REGEN) / 60.f / settings->max_frames_per_sec;
+		mp += mp_regen_per_frame * static_cast<float>(frames);
+		mp = std::max(0.0f, std::min(mp, get(Stats::MP_MAX)));
+	}
+}
+
+/**
+ * Catch up on the frames that logic() was not called for an idle entity.
+ * The caller must make sure the entity had no active effects during those frames,
+ * since effect timers and per-second effects are not handled here.
+ */
+void StatBlock::advanceTimers(unsigned frames) {
+	if (frames == 0)
+		return;
+
+	cooldown.advance(frames);
+
+	for (size_t i=0; i<powers_ai.size(); ++i) {
+		powers_ai[i].cooldown.advance(frames);
+	}
+
+	regenerate(frames);
+
+	if (transform_duration > 0)
+		transform_duration = std::max(transform_duration - static_cast<int>(frames), 0);
+
+	cooldown_hit.advance(frames);
+	state_timer.advance(frames);
+	waypoint_timer.advance(frames);
+}
+
 bool StatBlock::canUsePower(PowerID powerid, bool allow_passive) const {
 	const Power& power = powers->powers[powerid];
 
@@ -1113,21 +1275,30 @@ bool StatBlock::canUsePower(PowerID powerid, bool allow_passive) const {
 		return mp >= power.requires_mp;
 	}
 	else {
+		if (mp < power.requires_mp
+			|| (power.passive && !allow_passive)
+			|| power.meta_power
+			|| (effects.stun && !(allow_passive && power.passive))
+			|| (!power.sacrifice && hp <= power.requires_hp)
+			|| !(menu_powers && menu_powers->meetsUsageStats(powerid))
+		) {
+			return false;
+		}
+
+		// the remaining checks are only done for powers that have the requirement
+		const unsigned req = power.requirements;
+		if (req == 0)
+			return true;
+
 		return (
-			mp >= power.requires_mp
-			&& (!power.passive || allow_passive)
-			&& !power.meta_power
-			&& (!effects.stun || (allow_passive && power.passive))
-			&& (power.sacrifice || hp > power.requires_hp)
-			&& powers->checkRequiredMaxHPMP(power, this)
-			&& (!power.requires_corpse || (target_corpse && !target_corpse->corpse_timer.isEnd()) || (target_nearest_corpse && powers->checkNearestTargeting(power, this, true) && !target_nearest_corpse->corpse_timer.isEnd()))
-			&& (checkRequiredSpawns(power.requires_spawns))
-			&& (menu_powers && menu_powers->meetsUsageStats(powerid))
-			&& (power.type == Power::TYPE_SPAWN ? !summonLimitReached(powerid) : true)
-			&& !(power.spawn_type == "untransform" && !transformed)
-			&& std::includes(equip_flags.begin(), equip_flags.end(), power.requires_flags.begin(), power.requires_flags.end())
-			&& (!power.buff_party || (power.buff_party && entitym && entitym->checkPartyMembers()))
-			&& powers->checkRequiredItems(power, this)
+			(!(req & Power::REQUIRES_MAX_HPMP) || powers->checkRequiredMaxHPMP(power, this))
+			&& (!(req & Power::REQUIRES_CORPSE) || (target_corpse && !target_corpse->corpse_timer.isEnd()) || (target_nearest_corpse && powers->checkNearestTargeting(power, this, true) && !target_nearest_corpse->corpse_timer.isEnd()))
+			&& (!(req & Power::REQUIRES_SPAWNS) || checkRequiredSpawns(power.requires_spawns))
+			&& (!(req & Power::REQUIRES_SUMMON_LIMIT) || !summonLimitReached(powerid))
+			&& !(req & Power::REQUIRES_TRANSFORMED)
+			&& (!(req & Power::REQUIRES_EQUIP_FLAGS) || std::includes(equip_flags.begin(), equip_flags.end(), power.requires_flags.begin(), power.requires_flags.end()))
+			&& (!(req & Power::REQUIRES_PARTY) || (entitym && entitym->checkPartyMembers()))
+			&& (!(req & Power::REQUIRES_ITEMS) || powers->checkRequiredItems(power, this))
 		);
 	}
 
@@ -1152,7 +1323,7 @@ void StatBlock::loadHeroStats() {
 			}
 			else if (infile.key == "sfx_step") {
 				// @ATTR sfx_step|string|An id for a set of step sound effects. See items/step_sounds.txt.
-				sfx_step = infile.val;
+				editTemplate().sfx_step = infile.val;
 			}
 			else if (infile.key == "stat_points_per_level") {
 				// @ATTR stat_points_per_level|int|The amount of stat points awarded each level.
@@ -1190,33 +1361,52 @@ void StatBlock::loadHeroSFX() {
  * Recursivly kill all summoned creatures
  */
 void StatBlock::removeSummons() {
-	for (std::vector<StatBlock*>::iterator it = summons.begin(); it != summons.end(); ++it) {
-		(*it)->takeDamage((*it)->get(Stats::HP_MAX), !StatBlock::TAKE_DMG_CRIT, Power::SOURCE_TYPE_NEUTRAL);
-		(*it)->removeSummons();
-		(*it)->summoner = NULL;
-	}
+	if (summons.empty())
+		return;
 
-	summons.clear();
-}
+	// take the list first, since killing a summon can change it
+	std::vector<EntityHandle> summon_list;
+	summon_list.swap(summons);
 
-void StatBlock::removeFromSummons() {
+	for (size_t i = 0; i < summon_list.size(); ++i) {
+		Entity* e = entitym ? entitym->pool.get(summon_list[i]) : NULL;
+		if (!e)
+			continue;
 
-	if(summoner != NULL && !summoner->summons.empty()) {
-		std::vector<StatBlock*>::iterator parent_ref = std::find(summoner->summons.begin(), summoner->summons.end(), this);
+		e->stats.takeDamage(e->stats.get(Stats::HP_MAX), !StatBlock::TAKE_DMG_CRIT, Power::SOURCE_TYPE_NEUTRAL);
+		e->stats.removeSummons();
+		e->stats.summoner = NULL;
+	}
+}
 
-		if(parent_ref != summoner->summons.end())
-			summoner->summons.erase(parent_ref);
+/**
+ * Our handle in the summoner's list stops resolving once we are destroyed, so the list doesn't need to be searched here
+ */
+void StatBlock::removeFromSummons() {
+	summoner = NULL;
+	removeSummons();
+}
 
-		summoner = NULL;
+/**
+ * Handles to summons that have been destroyed are dropped when a new summon is added
+ */
+void StatBlock::addSummon(const EntityHandle& handle) {
+	if (entitym) {
+		size_t live_count = 0;
+		for (size_t i = 0; i < summons.size(); ++i) {
+			if (entitym->pool.get(summons[i]))
+				summons[live_count++] = summons[i];
+		}
+		summons.resize(live_count);
 	}
 
-	removeSummons();
+	summons.push_back(handle);
 }
 
 bool StatBlock::summonLimitReached(PowerID power_id) const {
 
 	//find the limit
-	Power *spawn_power = &powers->powers[power_id];
+	const Power *spawn_power = &powers->powers[power_id];
 
 	int max_summons = 0;
 
@@ -1246,7 +1436,8 @@ bool StatBlock::summonLimitReached(PowerID power_id) const {
 	int qty_summons = 0;
 
 	for (unsigned int i=0; i < summons.size(); i++) {
-		if (summons[i]->summoned_power_index == power_id && summons[i]->cur_state != ENTITY_DEAD && summons[i]->cur_state != ENTITY_CRITDEAD) {
+		Entity* e = entitym ? entitym->pool.get(summons[i]) : NULL;
+		if (e && e->stats.summoned_power_index == power_id && e->stats.cur_state != ENTITY_DEAD && e->stats.cur_state != ENTITY_CRITDEAD) {
 			qty_summons++;
 		}
 	}
@@ -1260,6 +1451,11 @@ void StatBlock::setWanderArea(int r) {
 	wander_area.w = wander_area.h = (r*2) + 1;
 }
 
+void StatBlock::setCharacterClass(const std::string& _character_class) {
+	character_class = _character_class;
+	character_class_id = symbols->intern(character_class);
+}
+
 /**
  * Returns the short version of the class string
  * For the sake of consistency with previous versions,
@@ -1304,12 +1500,12 @@ StatBlock::AIPower* StatBlock::getAIPower(int ai_type) {
 		if (!powers_ai[i].cooldown.isEnd())
 			continue;
 
-		if (powers->powers[powers_ai[i].id].type == Power::TYPE_SPAWN) {
-			if (summonLimitReached(powers_ai[i].id))
-				continue;
-		}
+		const Power& power = powers->powers[powers_ai[i].id];
+
+		if ((power.requirements & Power::REQUIRES_SUMMON_LIMIT) && summonLimitReached(powers_ai[i].id))
+			continue;
 
-		if (!checkRequiredSpawns(powers->powers[powers_ai[i].id].requires_spawns))
+		if ((power.requirements & Power::REQUIRES_SPAWNS) && !checkRequiredSpawns(power.requires_spawns))
 			continue;
 
 		possible_ids.push_back(i);
@@ -1329,7 +1525,8 @@ bool StatBlock::checkRequiredSpawns(int req_amount) const {
 
 	int live_summon_count = 0;
 	for (size_t j=0; j<summons.size(); ++j) {
-		if (summons[j]->hp > 0) {
+		Entity* e = entitym ? entitym->pool.get(summons[j]) : NULL;
+		if (e && e->stats.hp > 0) {
 			++live_summon_count;
 		}
 	}
@@ -28,12 +28,69 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 
 #include "CommonIncludes.h"
 #include "EffectManager.h"
+#include "EntityPool.h"
 #include "EventManager.h"
 #include "Stats.h"
+#include "SymbolTable.h"
 #include "Utils.h"
 
 class FileParser;
 
+/**
+ * Stat file data that entities don't change while playing, such as sound effects
+ * and render layers. Enemies spawned from the same prototype share one copy.
+ */
+class StatTemplate {
+public:
+	StatTemplate();
+
+	std::vector<std::string> categories;
+	std::vector<PowerID> power_filter;
+
+	std::vector<EventComponent> loot_table;
+
+	// default sounds
+	std::vector<std::pair<std::string, std::vector<std::string> > > sfx_attack;
+	std::string sfx_step;
+	std::vector<std::string> sfx_hit;
+	std::vector<std::string> sfx_die;
+	std::vector<std::string> sfx_critdie;
+	std::vector<std::string> sfx_block;
+	std::string sfx_levelup;
+	std::string sfx_lowhp;
+
+	std::vector<std::string> layer_reference_order;
+	std::vector<std::vector<unsigned> > layer_def;
+
+	std::map<std::string, std::string> animation_slots;
+};
+
+/**
+ * A reference counted handle to a StatTemplate. Copying the handle shares the template;
+ * edit() makes a private copy first if the template is shared.
+ */
+class StatTemplateRef {
+public:
+	StatTemplateRef();
+	StatTemplateRef(const StatTemplateRef& other);
+	StatTemplateRef& operator=(const StatTemplateRef& other);
+	~StatTemplateRef();
+
+	const StatTemplate& get() const { return shared->data; }
+	StatTemplate& edit();
+
+private:
+	class Shared {
+	public:
+		StatTemplate data;
+		unsigned ref_count;
+	};
+
+	void release();
+
+	Shared* shared;
+};
+
 class StatBlock {
 private:
 	bool loadCoreStat(FileParser *infile);
@@ -41,8 +98,21 @@ private:
 	bool isNPCStat(FileParser *infile);
 	void loadHeroStats();
 	bool checkRequiredSpawns(int req_amount) const;
+	void regenerate(unsigned frames);
 	bool statsLoaded;
 
+	StatTemplateRef stat_template;
+
+	bool checkBaseInputs();
+	void updateStats();
+
+	// inputs of the last calcBase(), used to tell when it needs to run again
+	bool base_dirty;
+	int base_level;
+	std::vector<int> base_primary;
+	std::vector<FMinMax> base_item_dmg;
+	FMinMax base_item_abs;
+
 public:
 	enum {
 		AI_POWER_MELEE = 0,
@@ -106,11 +176,14 @@ public:
 	void applyEffects();
 	void calcBase();
 	void logic();
+	void advanceTimers(unsigned frames);
 	void removeSummons();
 	void removeFromSummons();
+	void addSummon(const EntityHandle& handle);
 	bool summonLimitReached(PowerID power_id) const;
 	void setWanderArea(int r);
 	void loadHeroSFX();
+	void setCharacterClass(const std::string& _character_class);
 	std::string getShortClass();
 	std::string getLongClass();
 	void addXP(int amount); // TODO this should be unsigned long?
@@ -121,6 +194,9 @@ public:
 	bool loadRenderLayerStat(FileParser *infile);
 	bool loadAnimationSlotStat(FileParser *infile);
 
+	const StatTemplate& getTemplate() const { return stat_template.get(); }
+	StatTemplate& editTemplate() { return stat_template.edit(); }
+
 	bool alive;
 	bool corpse; // creature is dead and done animating
 	Timer corpse_timer;
@@ -149,8 +225,6 @@ public:
 	bool intangible;
 	bool facing; // does this creature turn to face the hero
 
-	std::vector<std::string> categories;
-
 	std::string name;
 
 	int level;
@@ -196,6 +270,7 @@ public:
 
 	// Base class picked when starting a new game. Defaults to "Adventurer".
 	std::string character_class;
+	SymbolID character_class_id; // interned character_class, kept in sync by setCharacterClass()
 	// Class derived from certain properties defined in engine/titles.txt
 	std::string character_subclass;
 
@@ -276,8 +351,8 @@ public:
 	Timer flee_cooldown_timer;
 	bool perfect_accuracy; // prevents misses & overhits; used for Event powers
 
-	std::vector<EventComponent> loot_table;
 	Point loot_count;
+	bool loot_dropped; // the loot table is shared, so this keeps an enemy from dropping its loot more than once
 
 	// for the teleport spell
 	bool teleportation;
@@ -305,15 +380,6 @@ public:
 
 	std::string animations;
 
-	// default sounds
-	std::vector<std::pair<std::string, std::vector<std::string> > > sfx_attack;
-	std::string sfx_step;
-	std::vector<std::string> sfx_hit;
-	std::vector<std::string> sfx_die;
-	std::vector<std::string> sfx_critdie;
-	std::vector<std::string> sfx_block;
-	std::string sfx_levelup;
-	std::string sfx_lowhp;
 	bool sfx_lowhp_loop;
 
 	// formula numbers
@@ -327,21 +393,14 @@ public:
 	float prev_mp;
 
 	// links to summoned creatures and the entity which summoned this
-	std::vector<StatBlock*> summons;
+	std::vector<EntityHandle> summons; // may contain handles to entities that have since been destroyed
 	StatBlock* summoner;
 	std::queue<PowerID> party_buffs;
 
-	std::vector<PowerID> power_filter;
-
 	std::vector<EventComponent> invincible_requirements;
 
 	bool abort_npc_interact;
 
-	std::vector<std::string> layer_reference_order;
-	std::vector<std::vector<unsigned> > layer_def;
-
-	std::map<std::string, std::string> animation_slots;
-
 	bool critdie_enabled;
 };
 
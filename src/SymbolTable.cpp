@@ -0,0 +1,81 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class SymbolTable
+ *
+ * Interns strings such as animation names and filenames. Each distinct string gets a
+ * small integer ID, so that it can be compared and used as an array index instead
+ * of doing string lookups. IDs stay valid until the table is destroyed.
+ * Names that the engine uses directly are interned first and have fixed IDs.
+ * Not thread-safe; only intern strings on the main thread.
+ */
+
+#include "SymbolTable.h"
+
+SymbolTable::SymbolTable()
+	: ids()
+	, strings()
+{
+	intern("");
+	intern("stance");
+	intern("run");
+	intern("block");
+	intern("hit");
+	intern("die");
+	intern("critdie");
+	intern("spawn");
+}
+
+SymbolTable::~SymbolTable() {
+}
+
+/**
+ * Get the ID of a string, adding it to the table if needed
+ */
+SymbolID SymbolTable::intern(const std::string& s) {
+	std::map<std::string, SymbolID>::iterator it = ids.find(s);
+	if (it != ids.end())
+		return it->second;
+
+	SymbolID id = static_cast<SymbolID>(strings.size());
+	ids[s] = id;
+	strings.push_back(s);
+	return id;
+}
+
+/**
+ * Get the ID of a string without adding it. Returns NONE if the string was never interned.
+ */
+SymbolID SymbolTable::find(const std::string& s) const {
+	std::map<std::string, SymbolID>::const_iterator it = ids.find(s);
+	if (it != ids.end())
+		return it->second;
+
+	return NONE;
+}
+
+const std::string& SymbolTable::getString(SymbolID id) const {
+	if (id >= strings.size())
+		return strings[NONE];
+
+	return strings[id];
+}
+
+size_t SymbolTable::size() const {
+	return strings.size();
+}
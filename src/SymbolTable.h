@@ -0,0 +1,62 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class SymbolTable
+ *
+ * Interns strings such as animation names and filenames. Each distinct string gets a
+ * small integer ID, so that it can be compared and used as an array index instead
+ * of doing string lookups. IDs stay valid until the table is destroyed.
+ * Names that the engine uses directly are interned first and have fixed IDs.
+ * Not thread-safe; only intern strings on the main thread.
+ */
+
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include "CommonIncludes.h"
+
+typedef unsigned SymbolID;
+
+class SymbolTable {
+private:
+	std::map<std::string, SymbolID> ids;
+	std::vector<std::string> strings;
+
+public:
+	// must be in the same order as the names in the constructor
+	enum {
+		NONE = 0, // the empty string
+		ANIM_STANCE = 1,
+		ANIM_RUN = 2,
+		ANIM_BLOCK = 3,
+		ANIM_HIT = 4,
+		ANIM_DIE = 5,
+		ANIM_CRITDIE = 6,
+		ANIM_SPAWN = 7
+	};
+
+	SymbolTable();
+	~SymbolTable();
+
+	SymbolID intern(const std::string& s);
+	SymbolID find(const std::string& s) const;
+	const std::string& getString(SymbolID id) const;
+	size_t size() const;
+};
+
+#endif
@@ -0,0 +1,167 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class ThreadPool
+ *
+ * A fixed set of worker threads that run a task over a range of indices.
+ * run() blocks until every index is done; the calling thread works on the range too.
+ * Without worker threads, the whole range is run on the calling thread.
+ */
+
+#include "ThreadPool.h"
+#include "Utils.h"
+
+/**
+ * A negative thread_count picks a count based on the number of CPU cores
+ */
+ThreadPool::ThreadPool(int thread_count)
+	: threads()
+	, mutex(NULL)
+	, work_cond(NULL)
+	, done_cond(NULL)
+	, shutdown(false)
+	, task(NULL)
+	, task_data(NULL)
+	, task_count(0)
+	, task_next(0)
+	, task_chunk(1)
+	, task_running(0)
+{
+	if (thread_count < 0) {
+		// leave one core for the main thread
+		thread_count = std::min(SDL_GetCPUCount() - 1, static_cast<int>(MAX_THREADS));
+	}
+	else if (thread_count > MAX_THREADS) {
+		thread_count = MAX_THREADS;
+	}
+
+	if (thread_count <= 0)
+		return;
+
+	mutex = SDL_CreateMutex();
+	work_cond = SDL_CreateCond();
+	done_cond = SDL_CreateCond();
+	if (!mutex || !work_cond || !done_cond) {
+		Utils::logError("ThreadPool: Could not create thread synchronization objects. Tasks will run on the main thread.");
+		return;
+	}
+
+	for (int i = 0; i < thread_count; ++i) {
+		SDL_Thread* thread = SDL_CreateThread(workerThread, "ThreadPool", this);
+		if (!thread) {
+			Utils::logError("ThreadPool: Could not create worker thread: %s", SDL_GetError());
+			break;
+		}
+		threads.push_back(thread);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	if (mutex) {
+		SDL_LockMutex(mutex);
+		shutdown = true;
+		SDL_CondBroadcast(work_cond);
+		SDL_UnlockMutex(mutex);
+	}
+
+	for (size_t i = 0; i < threads.size(); ++i) {
+		SDL_WaitThread(threads[i], NULL);
+	}
+
+	if (done_cond)
+		SDL_DestroyCond(done_cond);
+	if (work_cond)
+		SDL_DestroyCond(work_cond);
+	if (mutex)
+		SDL_DestroyMutex(mutex);
+}
+
+int ThreadPool::workerThread(void* data) {
+	static_cast<ThreadPool*>(data)->workerLoop();
+	return 0;
+}
+
+void ThreadPool::workerLoop() {
+	SDL_LockMutex(mutex);
+	while (!shutdown) {
+		if (!runChunk())
+			SDL_CondWait(work_cond, mutex);
+	}
+	SDL_UnlockMutex(mutex);
+}
+
+/**
+ * Runs the next chunk of indices, if there are any left.
+ * The mutex must be locked when calling this. It is unlocked while the task runs.
+ */
+bool ThreadPool::runChunk() {
+	if (!task || task_next >= task_count)
+		return false;
+
+	size_t first = task_next;
+	size_t last = std::min(first + task_chunk, task_count);
+	task_next = last;
+	task_running++;
+
+	Task current_task = task;
+	void* current_data = task_data;
+
+	SDL_UnlockMutex(mutex);
+	for (size_t i = first; i < last; ++i) {
+		current_task(current_data, i);
+	}
+	SDL_LockMutex(mutex);
+
+	task_running--;
+	if (task_next >= task_count && task_running == 0)
+		SDL_CondBroadcast(done_cond);
+
+	return true;
+}
+
+void ThreadPool::run(Task _task, void* data, size_t count) {
+	if (threads.empty()) {
+		for (size_t i = 0; i < count; ++i) {
+			_task(data, i);
+		}
+		return;
+	}
+
+	SDL_LockMutex(mutex);
+	task = _task;
+	task_data = data;
+	task_count = count;
+	task_next = 0;
+
+	// hand out several indices at a time so the threads don't wait on the mutex for every one
+	task_chunk = std::max(count / ((threads.size() + 1) * 4), static_cast<size_t>(1));
+
+	SDL_CondBroadcast(work_cond);
+
+	while (runChunk()) {}
+
+	while (task_running > 0) {
+		SDL_CondWait(done_cond, mutex);
+	}
+
+	task = NULL;
+	task_data = NULL;
+	task_count = 0;
+	task_next = 0;
+	SDL_UnlockMutex(mutex);
+}
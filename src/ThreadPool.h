@@ -0,0 +1,61 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class ThreadPool
+ *
+ * A fixed set of worker threads that run a task over a range of indices.
+ * run() blocks until every index is done; the calling thread works on the range too.
+ * Without worker threads, the whole range is run on the calling thread.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "CommonIncludes.h"
+
+class ThreadPool {
+public:
+	typedef void (*Task)(void* data, size_t index);
+
+	static const int MAX_THREADS = 4;
+
+	explicit ThreadPool(int thread_count);
+	~ThreadPool();
+
+	void run(Task task, void* data, size_t count);
+
+private:
+	static int workerThread(void* data);
+	void workerLoop();
+	bool runChunk();
+
+	std::vector<SDL_Thread*> threads;
+	SDL_mutex* mutex;
+	SDL_cond* work_cond;
+	SDL_cond* done_cond;
+	bool shutdown;
+
+	Task task;
+	void* task_data;
+	size_t task_count;
+	size_t task_next;
+	size_t task_chunk;
+	unsigned task_running;
+};
+
+#endif
@@ -0,0 +1,117 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class TimerWheel
+ *
+ * Schedules deadlines in logic frames. Deadlines are kept in a hierarchy of slot
+ * rings, where each level covers SLOTS times the range of the level below it.
+ * Advancing one frame only looks at the deadlines that are due, plus an occasional
+ * cascade of a higher level slot into the levels below it.
+ *
+ * Timers can't be cancelled. Instead, the owner checks that the thing a timer
+ * refers to still exists when it expires.
+ */
+
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel()
+	: now(0)
+{
+}
+
+TimerWheel::~TimerWheel() {
+}
+
+/**
+ * Expire a timer after the given number of calls to advance(). Timers run for at least one frame.
+ */
+void TimerWheel::schedule(unsigned frames, int type, size_t id) {
+	Entry entry;
+	entry.deadline = now + std::max(frames, 1u);
+	entry.type = type;
+	entry.id = id;
+	insert(entry);
+}
+
+void TimerWheel::insert(const Entry& entry) {
+	unsigned long delta = entry.deadline - now;
+
+	for (unsigned level = 0; level < LEVELS; ++level) {
+		unsigned shift = level * SLOT_BITS;
+		if (level == LEVELS - 1 || delta < (1ul << (shift + SLOT_BITS))) {
+			// deadlines beyond the range of the top level wait in its furthest slot and are inserted again when it cascades
+			unsigned long deadline = (level == LEVELS - 1 && delta >= (1ul << (shift + SLOT_BITS))) ? now + (1ul << (shift + SLOT_BITS)) - 1 : entry.deadline;
+			slots[level][(deadline >> shift) & (SLOTS - 1)].push_back(entry);
+			return;
+		}
+	}
+}
+
+/**
+ * Move the timers in a slot down to the levels below it
+ */
+void TimerWheel::cascade(unsigned level, unsigned slot) {
+	std::vector<Entry> entries;
+	entries.swap(slots[level][slot]);
+
+	for (size_t i = 0; i < entries.size(); ++i) {
+		insert(entries[i]);
+	}
+}
+
+/**
+ * Advance by one frame. The timers that expire are appended to 'expired' in the order they were scheduled.
+ */
+void TimerWheel::advance(std::vector<Expired>& expired) {
+	now++;
+
+	// when a level wraps around, the next slot of the level above it is due
+	unsigned top_level = 0;
+	while (top_level + 1 < LEVELS && (now & ((1ul << ((top_level + 1) * SLOT_BITS)) - 1)) == 0) {
+		top_level++;
+	}
+
+	// higher levels go first, since their timers can land in the due slots of the levels below
+	for (unsigned level = top_level; level > 0; --level) {
+		unsigned shift = level * SLOT_BITS;
+		cascade(level, static_cast<unsigned>((now >> shift) & (SLOTS - 1)));
+	}
+
+	std::vector<Entry> entries;
+	entries.swap(slots[0][now & (SLOTS - 1)]);
+
+	for (size_t i = 0; i < entries.size(); ++i) {
+		if (entries[i].deadline > now) {
+			insert(entries[i]);
+			continue;
+		}
+
+		Expired e;
+		e.type = entries[i].type;
+		e.id = entries[i].id;
+		expired.push_back(e);
+	}
+}
+
+void TimerWheel::clear() {
+	for (unsigned level = 0; level < LEVELS; ++level) {
+		for (unsigned slot = 0; slot < SLOTS; ++slot) {
+			slots[level][slot].clear();
+		}
+	}
+}
@@ -0,0 +1,71 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class TimerWheel
+ *
+ * Schedules deadlines in logic frames. Deadlines are kept in a hierarchy of slot
+ * rings, where each level covers SLOTS times the range of the level below it.
+ * Advancing one frame only looks at the deadlines that are due, plus an occasional
+ * cascade of a higher level slot into the levels below it.
+ *
+ * Timers can't be cancelled. Instead, the owner checks that the thing a timer
+ * refers to still exists when it expires.
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "CommonIncludes.h"
+
+class TimerWheel {
+public:
+	class Expired {
+	public:
+		int type;
+		size_t id;
+	};
+
+	static const unsigned LEVELS = 4;
+	static const unsigned SLOT_BITS = 6;
+	static const unsigned SLOTS = 1 << SLOT_BITS;
+
+	TimerWheel();
+	~TimerWheel();
+
+	void schedule(unsigned frames, int type, size_t id);
+	void advance(std::vector<Expired>& expired);
+	void clear();
+
+	unsigned long getFrame() const { return now; }
+
+private:
+	class Entry {
+	public:
+		unsigned long deadline;
+		int type;
+		size_t id;
+	};
+
+	void insert(const Entry& entry);
+	void cascade(unsigned level, unsigned slot);
+
+	std::vector<Entry> slots[LEVELS][SLOTS];
+	unsigned long now;
+};
+
+#endif
@@ -161,7 +161,7 @@ bool Color::operator !=(const Color &other) {
 	return !((*this) == other);
 }
 
-uint32_t Color::encodeRGBA() {
+uint32_t Color::encodeRGBA() const {
 	uint32_t result = static_cast<uint32_t>(a);
 	result |= static_cast<uint32_t>(r) << 24;
 	result |= static_cast<uint32_t>(g) << 16;
@@ -210,6 +210,18 @@ bool Timer::tick() {
 	return false;
 }
 
+/**
+ * Same as calling tick() a number of times
+ */
+bool Timer::advance(unsigned frames) {
+	if (current > frames)
+		current -= frames;
+	else
+		current = 0;
+
+	return current == 0;
+}
+
 bool Timer::isEnd() {
 	return current == 0;
 }
@@ -328,6 +340,26 @@ bool Utils::isWithinRadius(const FPoint& center, float radius, const FPoint& tar
 	return (calcDist(center, target) < radius);
 }
 
+/**
+ * Returns the point on the line segment from start to end that is closest to target
+ */
+FPoint Utils::calcClosestPointOnSegment(const FPoint& start, const FPoint& end, const FPoint& target) {
+	float dx = end.x - start.x;
+	float dy = end.y - start.y;
+	float length_sq = dx * dx + dy * dy;
+
+	if (length_sq == 0)
+		return start;
+
+	float t = ((target.x - start.x) * dx + (target.y - start.y) * dy) / length_sq;
+	if (t <= 0)
+		return start;
+	if (t >= 1)
+		return end;
+
+	return FPoint(start.x + t * dx, start.y + t * dy);
+}
+
 /**
  * is target within the area defined by rectangle r?
  */
@@ -79,7 +79,7 @@ public:
 	operator SDL_Color() const;
 	bool operator ==(const Color &other);
 	bool operator !=(const Color &other);
-	uint32_t encodeRGBA();
+	uint32_t encodeRGBA() const;
 	void decodeRGBA(const uint32_t encoded);
 };
 
@@ -99,6 +99,7 @@ public:
 	void setCurrent(unsigned val);
 	void setDuration(unsigned val);
 	bool tick();
+	bool advance(unsigned frames);
 	bool isEnd();
 	bool isBegin();
 	void reset(int type);
@@ -148,6 +149,7 @@ namespace Utils {
 	float calcTheta(float x1, float y1, float x2, float y2);
 	unsigned char calcDirection(float x0, float y0, float x1, float y1);
 	bool isWithinRadius(const FPoint& center, float radius, const FPoint& target);
+	FPoint calcClosestPointOnSegment(const FPoint& start, const FPoint& end, const FPoint& target);
 	bool isWithinRect(const Rect& r, const Point& target);
 
 	std::string abbreviateKilo(int amount);
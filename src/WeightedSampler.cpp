@@ -0,0 +1,98 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class WeightedSampler
+ *
+ * Picks random indices with probabilities proportional to integer weights, using
+ * an alias table. Building the table is O(n); each pick is O(1) and exact.
+ */
+
+#include "WeightedSampler.h"
+
+WeightedSampler::WeightedSampler()
+	: threshold()
+	, alias()
+	, total(0)
+{
+}
+
+/**
+ * Each of the n columns holds 'total' units of probability. Weights are scaled by n,
+ * so that an index that is under-filled by its own weight can be topped up from an over-filled one.
+ */
+void WeightedSampler::build(const std::vector<unsigned>& weights) {
+	size_t count = weights.size();
+
+	threshold.assign(count, 0);
+	alias.assign(count, 0);
+	total = 0;
+
+	for (size_t i = 0; i < count; ++i) {
+		total += weights[i];
+	}
+
+	if (total == 0)
+		return;
+
+	std::vector<unsigned long> scaled(count);
+	std::vector<size_t> small;
+	std::vector<size_t> large;
+
+	for (size_t i = 0; i < count; ++i) {
+		scaled[i] = static_cast<unsigned long>(weights[i]) * count;
+		if (scaled[i] < total)
+			small.push_back(i);
+		else
+			large.push_back(i);
+	}
+
+	while (!small.empty() && !large.empty()) {
+		size_t s = small.back();
+		small.pop_back();
+		size_t l = large.back();
+		large.pop_back();
+
+		threshold[s] = scaled[s];
+		alias[s] = l;
+
+		scaled[l] -= total - scaled[s];
+		if (scaled[l] < total)
+			small.push_back(l);
+		else
+			large.push_back(l);
+	}
+
+	// whatever is left fills its column exactly
+	for (size_t i = 0; i < large.size(); ++i) {
+		threshold[large[i]] = total;
+		alias[large[i]] = large[i];
+	}
+	for (size_t i = 0; i < small.size(); ++i) {
+		threshold[small[i]] = total;
+		alias[small[i]] = small[i];
+	}
+}
+
+/**
+ * The sampler must not be empty
+ */
+size_t WeightedSampler::pick() const {
+	size_t column = static_cast<size_t>(rand()) % threshold.size();
+	unsigned long r = static_cast<unsigned long>(rand()) % total;
+	return (r < threshold[column]) ? column : alias[column];
+}
@@ -0,0 +1,45 @@
+/*
+Copyright © 2026 agent
+
+This file is part of FLARE.
+
+FLARE is free software: you can redistribute it and/or modify it under the terms
+of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+FLARE is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+FLARE.  If not, see http://www.gnu.org/licenses/
+*/
+
+/**
+ * class WeightedSampler
+ *
+ * Picks random indices with probabilities proportional to integer weights, using
+ * an alias table. Building the table is O(n); each pick is O(1) and exact.
+ */
+
+#ifndef WEIGHTED_SAMPLER_H
+#define WEIGHTED_SAMPLER_H
+
+#include "CommonIncludes.h"
+
+class WeightedSampler {
+public:
+	WeightedSampler();
+
+	void build(const std::vector<unsigned>& weights);
+	bool empty() const { return total == 0; }
+	size_t pick() const;
+
+private:
+	// a pick first chooses a column, then either the column's own index or its alias
+	std::vector<unsigned long> threshold;
+	std::vector<size_t> alias;
+	unsigned long total;
+};
+
+#endif
@@ -26,6 +26,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include <limits.h>
 
 #include "AnimationManager.h"
+#include "CombatSimulation.h"
 #include "CombatText.h"
 #include "DeviceList.h"
 #include "EngineSettings.h"
@@ -40,6 +41,7 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "SharedResources.h"
 #include "SoundManager.h"
 #include "Stats.h"
+#include "SymbolTable.h"
 #include "TooltipManager.h"
 #include "Utils.h"
 #include "UtilsFileSystem.h"
@@ -52,6 +54,7 @@ class CmdLineArgs {
 public:
 	std::string render_device_name;
 	std::vector<std::string> mod_list;
+	std::string combat_simulation;
 };
 
 #define PLATFORM_CPP_INCLUDE
@@ -94,6 +97,10 @@ static void init(const CmdLineArgs& cmd_line_args) {
 	Utils::logInfo("main: PATH_USER = '%s'", settings->path_user.c_str());
 	Utils::logInfo("main: PATH_DATA = '%s'", settings->path_data.c_str());
 
+	// combat simulations don't draw anything, so don't open a window for them
+	if (!cmd_line_args.combat_simulation.empty())
+		SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+
 	// SDL Inits
 	if ( SDL_Init (SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER) < 0 ) {
 		Utils::logError("main: Could not initialize SDL: %s", SDL_GetError());
@@ -103,6 +110,8 @@ static void init(const CmdLineArgs& cmd_line_args) {
 
 	// Shared Resources set-up
 
+	symbols = new SymbolTable();
+
 	mods = new ModManager(&(cmd_line_args.mod_list));
 
 	if (!mods->haveFallbackMod()) {
@@ -119,6 +128,13 @@ static void init(const CmdLineArgs& cmd_line_args) {
 	settings->loadSettings();
 	settings->logSettings();
 
+	if (!cmd_line_args.combat_simulation.empty()) {
+		// the dummy video driver only supports software rendering
+		settings->fullscreen = false;
+		settings->hwsurface = false;
+		settings->vsync = false;
+	}
+
 	save_load = new SaveLoad();
 	msg = new MessageEngine();
 	font = getFontEngine();
@@ -162,7 +178,8 @@ static void init(const CmdLineArgs& cmd_line_args) {
 
 	tooltipm = new TooltipManager();
 
-	gswitch = new GameSwitcher();
+	if (cmd_line_args.combat_simulation.empty())
+		gswitch = new GameSwitcher();
 }
 
 static float getSecondsElapsed(uint64_t prev_ticks, uint64_t now_ticks) {
@@ -282,6 +299,7 @@ static void cleanup() {
 	delete snd;
 	delete save_load;
 	delete eset;
+	delete symbols;
 
 	if (render_device)
 		render_device->destroyContext();
@@ -404,6 +422,10 @@ int main(int argc, char *argv[]) {
 		else if (arg == "safe-video") {
 			settings->safe_video = true;
 		}
+		else if (arg == "simulate-combat") {
+			cmd_line_args.combat_simulation = parseArgValue(arg_full);
+			settings->audio = false;
+		}
 		else if (arg == "help") {
 			Utils::logInfo("Command line options:\n\
 --help                   Prints this message.\n\
@@ -417,7 +439,9 @@ int main(int argc, char *argv[]) {
 --load-slot=<SLOT>       Loads a save slot by numerical index.\n\
 --load-script=<SCRIPT>   Execute's a script upon loading a saved game.\n\
                          The script path is mod-relative.\n\
---safe-video             Launches with the minimum video settings.");
+--safe-video             Launches with the minimum video settings.\n\
+--simulate-combat=<FILE> Runs the combat simulation in FILE without a window\n\
+                         and logs the results. The file path is mod-relative.");
 			done = true;
 		}
 		else {
@@ -437,7 +461,14 @@ soft_reset:
 		if (debug_event)
 			inpt->enableEventLog();
 
-		mainLoop();
+		if (!cmd_line_args.combat_simulation.empty()) {
+			CombatSimulation combat_simulation;
+			if (combat_simulation.load(cmd_line_args.combat_simulation))
+				combat_simulation.run();
+		}
+		else {
+			mainLoop();
+		}
 #endif
 
 		if (gswitch)